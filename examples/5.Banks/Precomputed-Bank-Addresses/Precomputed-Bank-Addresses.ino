@@ -0,0 +1,93 @@
+/**
+ * This is an example that demonstrates how to make bankable MIDI Output
+ * Elements look up their addresses in a table instead of computing them every
+ * time they send a message.
+ *
+ * @boards  AVR, AVR USB, Due, Nano 33 IoT, Nano 33 BLE, Pi Pico, Teensy 3.x, ESP32
+ *
+ * By default, a bankable element like @ref Bankable::NoteButton stores a
+ * single base address, and adds the offset of the active bank setting to it
+ * whenever it sends a MIDI message. The @ref Bankable::PrecomputedAddress
+ * class computes the addresses of all bank settings once, when the element is
+ * created, so getting the active address is a single table lookup. This costs
+ * one address (three bytes) of RAM per bank setting.
+ *
+ * The generic bankable elements take the type of their address as a template
+ * argument, so you can opt in by using them directly, with
+ * `Bankable::PrecomputedAddress<N>` as the first template argument, where `N`
+ * is the number of banks. The second template argument is the sender that
+ * determines the type of MIDI messages, e.g. @ref DigitalNoteSender or
+ * @ref DigitalCCSender.
+ *
+ * To understand this example, you need to understand the @ref Bank.ino example
+ * first.
+ *
+ * Connections
+ * -----------
+ *
+ * - 2: momentary push button (to ground) to select the next bank
+ * - 5: momentary push button (to ground) to send MIDI notes
+ * - 6: momentary push button (to ground) to send MIDI Control Change messages
+ *
+ * The internal pull-up resistors for the buttons will be enabled automatically.
+ *
+ * Behavior
+ * --------
+ *
+ * - When the button on pin 5 is pressed or released, a MIDI Note On or Note Off
+ *   message is sent for note C in the octave determined by the bank setting.
+ * - When the button on pin 6 is pressed or released, a MIDI Control Change
+ *   message is sent for the controller number determined by the bank setting,
+ *   starting from General Purpose Controller 1.
+ * - When the button on pin 2 is pressed, the bank setting is incremented.
+ *
+ * Mapping
+ * -------
+ *
+ * Select the Arduino as a custom MIDI controller in your DAW, and use the
+ * MIDI learn option to assign the buttons to a function.
+ *
+ * https://github.com/tttapa/Control-Surface
+ */
+
+#include <Control_Surface.h> // Include the Control Surface library
+
+// Instantiate a MIDI over USB interface.
+USBMIDI_Interface midi;
+
+// Instantiate four Banks, with twelve tracks per bank (12 semitones = 1 octave).
+Bank<4> bank(12);
+// Instantiate a Bank selector to control which one of the four Banks is active.
+IncrementSelector<4> selector {
+  bank, // Bank to manage
+  2,    // push button pin
+};
+
+// The equivalent of a Bankable::NoteButton, with precomputed addresses.
+Bankable::MIDIButton<Bankable::PrecomputedAddress<4>, DigitalNoteSender> note {
+  {
+    {bank, BankType::CHANGE_ADDRESS}, // bank changes the note number (address)
+    {MIDI_Notes::C(2), CHANNEL_1},    // base address: Note C2 on MIDI channel 1
+  },
+  5,      // push button pin
+  {0x7F}, // velocity
+};
+
+// The equivalent of a Bankable::CCButton, with precomputed addresses.
+Bankable::MIDIButton<Bankable::PrecomputedAddress<4>, DigitalCCSender> cc {
+  {
+    {bank, BankType::CHANGE_ADDRESS},                   // bank changes the
+                                                        // controller number
+    {MIDI_CC::General_Purpose_Controller_1, CHANNEL_1}, // base address
+  },
+  6,  // push button pin
+  {}, // default values for the CC sender
+};
+
+void setup() {
+  Control_Surface.begin(); // Initialize Control Surface
+}
+
+void loop() {
+  Control_Surface.loop(); // Update the Control Surface
+}
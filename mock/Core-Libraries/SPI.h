@@ -1,8 +1,8 @@
-#include <AH/Hardware/Arduino-Hardware-Types.hpp>
+#pragma once
 
-// TODO
-class SPIClass {
-} extern SPI;
+#include <Arduino.h>
+#include <cstddef>
+#include <cstdint>
 
 enum SPIMode {
     SPI_MODE0 = 0,
@@ -13,5 +13,26 @@ enum SPIMode {
 
 class SPISettings {
   public:
-    SPISettings(uint32_t, BitOrder_t, SPIMode) {}
-};
\ No newline at end of file
+    SPISettings() = default;
+    SPISettings(uint32_t clock, uint8_t bitOrder, SPIMode dataMode)
+        : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+
+    uint32_t clock = 4000000;
+    uint8_t bitOrder = MSBFIRST;
+    SPIMode dataMode = SPI_MODE0;
+};
+
+/// Host version of the SPI library, it doesn't send any data. Use a mock
+/// class with the same interface as the SPI driver template argument to
+/// check what's being sent.
+class SPIClass {
+  public:
+    void begin() {}
+    void end() {}
+    void beginTransaction(SPISettings) {}
+    void endTransaction() {}
+    uint8_t transfer(uint8_t) { return 0; }
+    void transfer(void *, size_t) {}
+};
+
+extern SPIClass SPI;
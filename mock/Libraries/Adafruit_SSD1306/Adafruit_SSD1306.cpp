@@ -0,0 +1,69 @@
+// Minimal host implementation of the Adafruit SSD1306 library: it draws to a
+// frame buffer in RAM, and records the commands and display transfers.
+
+#include "Adafruit_SSD1306.h"
+
+Adafruit_SSD1306::Adafruit_SSD1306(int8_t SID, int8_t SCLK, int8_t DC,
+                                   int8_t RST, int8_t CS)
+    : Adafruit_GFX(SSD1306_LCDWIDTH, SSD1306_LCDHEIGHT), _i2caddr(0),
+      _vccstate(0), sid(SID), sclk(SCLK), dc(DC), rst(RST), cs(CS),
+      hwSPI(false) {}
+Adafruit_SSD1306::Adafruit_SSD1306(int8_t DC, int8_t RST, int8_t CS)
+    : Adafruit_SSD1306(-1, -1, DC, RST, CS) {}
+Adafruit_SSD1306::Adafruit_SSD1306(int8_t RST)
+    : Adafruit_SSD1306(-1, -1, -1, RST, -1) {}
+
+void Adafruit_SSD1306::begin(uint8_t switchvcc, uint8_t i2caddr, bool) {
+    _vccstate = switchvcc;
+    _i2caddr = i2caddr;
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c) { commands.push_back(c); }
+
+void Adafruit_SSD1306::clearDisplay() { memset(buffer, 0, sizeof(buffer)); }
+
+void Adafruit_SSD1306::display() { ++displayCount; }
+
+uint8_t *Adafruit_SSD1306::getBuffer() { return buffer; }
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || x >= width() || y < 0 || y >= height())
+        return;
+    switch (getRotation()) {
+        case 1: {
+            int16_t t = x;
+            x = WIDTH - y - 1;
+            y = t;
+        } break;
+        case 2:
+            x = WIDTH - x - 1;
+            y = HEIGHT - y - 1;
+            break;
+        case 3: {
+            int16_t t = x;
+            x = y;
+            y = HEIGHT - t - 1;
+        } break;
+        default: break;
+    }
+    uint8_t &byte = buffer[x + (y / 8) * WIDTH];
+    uint8_t bit = 1 << (y & 7);
+    switch (color) {
+        case WHITE: byte |= bit; break;
+        case BLACK: byte &= ~bit; break;
+        case INVERSE: byte ^= bit; break;
+        default: break;
+    }
+}
+
+void Adafruit_SSD1306::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                     uint16_t color) {
+    for (int16_t i = 0; i < h; ++i)
+        drawPixel(x, y + i, color);
+}
+
+void Adafruit_SSD1306::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                     uint16_t color) {
+    for (int16_t i = 0; i < w; ++i)
+        drawPixel(x + i, y, color);
+}
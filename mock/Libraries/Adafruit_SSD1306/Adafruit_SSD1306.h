@@ -19,6 +19,7 @@ All text above, and the splash screen must be included in any redistribution
 #define _Adafruit_SSD1306_H_
 
 #include "Arduino.h"
+#include <vector>
 #define WIRE_WRITE Wire.write
 
 #if defined(__SAM3X8E__)
@@ -154,6 +155,7 @@ class Adafruit_SSD1306 : public Adafruit_GFX {
     void clearDisplay(void);
     // void invertDisplay(uint8_t i);
     void display();
+    uint8_t *getBuffer(void);
 
     // void startscrollright(uint8_t start, uint8_t stop);
     // void startscrollleft(uint8_t start, uint8_t stop);
@@ -171,7 +173,13 @@ class Adafruit_SSD1306 : public Adafruit_GFX {
     void drawFastHLine(int16_t x, int16_t y, int16_t w,
                        uint16_t color) override;
 
+    // Host mock only: commands sent using ssd1306_command, and the number of
+    // full frame buffer transfers using display.
+    std::vector<uint8_t> commands;
+    unsigned displayCount = 0;
+
   private:
+    uint8_t buffer[SSD1306_LCDWIDTH * SSD1306_LCDHEIGHT / 8] = {};
     int8_t _i2caddr, _vccstate, sid, sclk, dc, rst, cs;
     void fastSPIwrite(uint8_t c);
 
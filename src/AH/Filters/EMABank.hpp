@@ -0,0 +1,110 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include <AH/Filters/EMA.hpp>
+#include <stddef.h>
+
+/**
+ * @brief   A bank of exponential moving average filters with the same shift
+ *          factor.
+ *
+ * Behaves exactly like @p N independent @ref EMA filters, but the states of
+ * all filters are stored contiguously, and all channels are updated in a
+ * single loop without any branches, so the compiler can vectorize it.
+ *
+ * @tparam  N
+ *          The number of channels.
+ * @tparam  K
+ *          The amount of bits to shift by.
+ * @tparam  input_t
+ *          The integer type to use for the input and output of the filters.
+ * @tparam  state_t
+ *          The unsigned integer type to use for the internal states of the
+ *          filters.
+ *
+ * @see     EMA
+ *
+ * @ingroup    AH_Filters
+ */
+template <size_t N, uint8_t K,
+          class input_t = uint_fast16_t,
+          class state_t = typename std::make_unsigned<input_t>::type>
+class EMABank {
+  public:
+    /// Constructor: initialize all filters to zero or optional given value.
+    EMABank(input_t initial = input_t(0)) { reset(initial); }
+
+    /**
+     * @brief   Reset all filters to the given value.
+     *
+     * @param   value
+     *          The value to reset the filter states to.
+     */
+    void reset(input_t value = input_t(0)) {
+        for (size_t i = 0; i < N; ++i)
+            reset(i, value);
+    }
+
+    /**
+     * @brief   Reset a single filter to the given value.
+     *
+     * @param   index
+     *          The index of the channel to reset.
+     * @param   value
+     *          The value to reset the filter state to.
+     */
+    void reset(size_t index, input_t value) {
+        state[index] = EMA_t::zero + (state_t(value) << K) - value;
+    }
+
+    /**
+     * @brief   Filter the inputs of all channels in place.
+     *
+     * @param[in,out] values
+     *          An array of @p N raw input values, that is overwritten by the
+     *          new filtered output values.
+     */
+    void filter(input_t *values) {
+        for (size_t i = 0; i < N; ++i) {
+            state_t s      = state[i] + state_t(values[i]);
+            state_t output = (s + EMA_t::half) >> K;
+            output        -= EMA_t::zero >> K;
+            state[i]       = s - output;
+            values[i]      = input_t(output);
+        }
+    }
+
+    /**
+     * @brief   Filter the input of a single channel.
+     *
+     * @param   index
+     *          The index of the channel to filter.
+     * @param   input
+     *          The new raw input value.
+     * @return  The new filtered output value.
+     */
+    input_t filter(size_t index, input_t input) {
+        state_t s      = state[index] + state_t(input);
+        state_t output = (s + EMA_t::half) >> K;
+        output        -= EMA_t::zero >> K;
+        state[index]   = s - output;
+        return input_t(output);
+    }
+
+    /// @copydoc    EMA::supports_range
+    template <class T>
+    constexpr static bool supports_range(T min, T max) {
+        return EMA_t::supports_range(min, max);
+    }
+
+    /// The number of channels.
+    constexpr static size_t length = N;
+
+  private:
+    using EMA_t = EMA<K, input_t, state_t>;
+    state_t state[N];
+};
+
+AH_DIAGNOSTIC_POP()
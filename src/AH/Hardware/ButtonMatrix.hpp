@@ -5,13 +5,40 @@
 #include <AH/Settings/Warnings.hpp>
 AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
 
+#include <AH/Hardware/ButtonMatrixRowReader.hpp>
 #include <AH/Hardware/Hardware-Types.hpp>
 
 BEGIN_AH_NAMESPACE
 
+/// How a @ref ButtonMatrix debounces its buttons.
+enum class ButtonMatrixDebounceMode : uint8_t {
+    /// One timer for the whole matrix: after any button changes state, the
+    /// matrix isn't scanned again until the debounce time has passed. Uses no
+    /// extra memory, but a bouncing button delays all other buttons.
+    Global,
+    /// Every button is debounced separately. A change is reported on the
+    /// first edge, after which the button is locked for the debounce time.
+    /// Lowest latency, but sensitive to noise on the lines.
+    Eager,
+    /// Every button is debounced separately. A change is only reported once
+    /// the new state has been stable for the debounce time.
+    Deferred,
+};
+
 /**
  * @brief   A class that reads the states of a button matrix.
  *
+ * By default, the matrix uses a single debounce timer for all buttons (see
+ * @ref ButtonMatrixDebounceMode::Global). For fast playing on large matrices,
+ * @ref setDebounceMode can select per-key debouncing, where a bounce on one
+ * key never delays the others. The state of each key is then kept in a 2-bit
+ * counter that counts the number of debounce ticks (a third of the debounce
+ * time) since its last edge, so the scan itself remains non-blocking.
+ *
+ * The matrix is scanned using `pinMode` and `digitalRead` for every button.
+ * Large matrices can be scanned faster by reading all columns of a row at
+ * once, using a @ref ButtonMatrixRowReader (see @ref setRowReader).
+ *
  * @tparam  NumRows
  *          The number of rows in the button matrix.
  * @tparam  NumCols
@@ -43,6 +70,19 @@ class ButtonMatrix {
      */
     void begin();
 
+    /**
+     * @brief   Read the columns of every row using the given reader instead
+     *          of calling `digitalRead` for each button.
+     *
+     * Must be called before @ref begin. Pass `nullptr` to use the default
+     * scanning method again.
+     *
+     * @param   reader
+     *          The row reader to use. Its lifetime should exceed the lifetime
+     *          of the matrix.
+     */
+    void setRowReader(ButtonMatrixRowReader *reader) { rowReader = reader; }
+
     /**
      * @brief   Scan the matrix, read all button states, and call the
      *          onButtonChanged callback.
@@ -56,14 +96,21 @@ class ButtonMatrix {
      */
     bool getPrevState(uint8_t col, uint8_t row);
 
-    /// Configure the debounce time interval. Only one button can change in each
-    /// debounce interval. Time in milliseconds.
+    /// Configure the debounce time interval. In the global debounce mode,
+    /// only one button can change in each debounce interval. Time in
+    /// milliseconds.
     void setDebounceTime(unsigned long debounceTime) {
         this->debounceTime = debounceTime;
     }
     /// Get the debounce time.
     unsigned long getDebounceTime() const { return debounceTime; }
 
+    /// Select global or per-key debouncing. Resets the per-key debounce
+    /// state, all buttons keep their current state.
+    void setDebounceMode(ButtonMatrixDebounceMode mode);
+    /// Get the debounce mode.
+    ButtonMatrixDebounceMode getDebounceMode() const { return debounceMode; }
+
   protected:
     /**
      * @brief   The callback function that is called whenever a button changes
@@ -83,13 +130,30 @@ class ButtonMatrix {
     static inline uint8_t bitsToIndex(uint8_t bits);
     static inline uint8_t bitsToBitmask(uint8_t bits);
     void setPrevState(uint8_t col, uint8_t row, bool state);
+    uint8_t getDebounceCount(uint8_t col, uint8_t row) const;
+    void setDebounceCount(uint8_t col, uint8_t row, uint8_t count);
+    /// Handle the new state of a single button.
+    void updateKey(uint8_t row, uint8_t col, bool state, unsigned long now,
+                   uint8_t ticks);
+    /// Handle the new state of a single button when debouncing per key.
+    void debounceKey(uint8_t row, uint8_t col, bool state, uint8_t ticks);
+    /// Get the number of debounce ticks since the previous scan (at most 3).
+    uint8_t advanceDebounceTicks(unsigned long now);
+
+    /// Number of debounce ticks before a key is considered stable.
+    constexpr static uint8_t DebounceTicks = 3;
 
     unsigned long debounceTime = BUTTON_DEBOUNCE_TIME;
     unsigned long prevRefresh = 0;
     uint8_t prevStates[(NumCols * NumRows + 7) / 8];
+    /// Per-key number of debounce ticks since the last edge, 2 bits per key.
+    /// Zero means the key is stable.
+    uint8_t debounceCounts[(NumCols * NumRows + 3) / 4] = {};
+    ButtonMatrixDebounceMode debounceMode = ButtonMatrixDebounceMode::Global;
 
     const PinList<NumRows> rowPins;
     const PinList<NumCols> colPins;
+    ButtonMatrixRowReader *rowReader = nullptr;
 };
 
 END_AH_NAMESPACE
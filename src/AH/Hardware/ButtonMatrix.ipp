@@ -15,10 +15,27 @@ ButtonMatrix<Derived, NumRows, NumCols>::ButtonMatrix(
 template <class Derived, uint8_t NumRows, uint8_t NumCols>
 void ButtonMatrix<Derived, NumRows, NumCols>::update() {
     unsigned long now = millis();
-    // only update 25 ms after previous change (crude software debounce).
-    // Edit this in Settings/Settings.hpp
-    if (now - prevRefresh < debounceTime)
+    bool perKey = debounceMode != ButtonMatrixDebounceMode::Global;
+    uint8_t ticks = 0;
+    if (perKey) {
+        ticks = advanceDebounceTicks(now);
+    } else {
+        // only update 25 ms after previous change (crude software debounce).
+        // Edit this in Settings/Settings.hpp
+        if (now - prevRefresh < debounceTime)
+            return;
+    }
+
+    if (rowReader != nullptr) {
+        uint8_t colStates[(NumCols + 7) / 8] = {};
+        for (size_t row = 0; row < NumRows; row++) { // scan through all rows
+            rowReader->readRow(row, colStates);      // read all columns
+            for (size_t col = 0; col < NumCols; col++)
+                updateKey(row, col, colStates[col / 8] & (1 << (col % 8)), now,
+                          ticks);
+        }
         return;
+    }
 
     for (size_t row = 0; row < NumRows; row++) { // scan through all rows
         pinMode(rowPins[row], OUTPUT);           // make the current row Lo-Z 0V
@@ -27,20 +44,88 @@ void ButtonMatrix<Derived, NumRows, NumCols>::update() {
 #endif
         for (size_t col = 0; col < NumCols; col++) { // scan through all columns
             bool state = digitalRead(colPins[col]);  // read the state
-            if (state != getPrevState(col, row)) {
-                // if the state changed since last time
-                // execute the handler
-                CRTP(Derived).onButtonChanged(row, col, state);
-                setPrevState(col, row, state); // remember the state
-                prevRefresh = now;
-            }
+            updateKey(row, col, state, now, ticks);
         }
         pinMode(rowPins[row], INPUT); // make the current row Hi-Z again
     }
 }
 
+template <class Derived, uint8_t NumRows, uint8_t NumCols>
+void ButtonMatrix<Derived, NumRows, NumCols>::updateKey(uint8_t row,
+                                                        uint8_t col, bool state,
+                                                        unsigned long now,
+                                                        uint8_t ticks) {
+    if (debounceMode != ButtonMatrixDebounceMode::Global) {
+        debounceKey(row, col, state, ticks);
+    } else if (state != getPrevState(col, row)) {
+        // if the state changed since last time
+        // execute the handler
+        CRTP(Derived).onButtonChanged(row, col, state);
+        setPrevState(col, row, state); // remember the state
+        prevRefresh = now;
+    }
+}
+
+template <class Derived, uint8_t NumRows, uint8_t NumCols>
+uint8_t
+ButtonMatrix<Derived, NumRows, NumCols>::advanceDebounceTicks(unsigned long now) {
+    unsigned long tickTime = debounceTime / DebounceTicks;
+    if (tickTime == 0)
+        tickTime = 1;
+    unsigned long ticks = (now - prevRefresh) / tickTime;
+    prevRefresh += ticks * tickTime;
+    return ticks < DebounceTicks ? ticks : DebounceTicks;
+}
+
+template <class Derived, uint8_t NumRows, uint8_t NumCols>
+void ButtonMatrix<Derived, NumRows, NumCols>::debounceKey(uint8_t row,
+                                                          uint8_t col,
+                                                          bool state,
+                                                          uint8_t ticks) {
+    bool prevState = getPrevState(col, row);
+    uint8_t count = getDebounceCount(col, row);
+    // The debounce interval of this key ends after DebounceTicks ticks
+    bool expired = false;
+    if (count != 0 && ticks != 0) {
+        expired = count + ticks > DebounceTicks;
+        count = expired ? 0 : count + ticks;
+    }
+    bool changed = false;
+    if (debounceMode == ButtonMatrixDebounceMode::Eager) {
+        // Report the first edge, then ignore the key until the interval ends
+        if (count == 0 && state != prevState) {
+            changed = true;
+            count = 1;
+        }
+    } else {
+        // Report the new state if it remained stable for the whole interval
+        if (state == prevState)
+            count = 0;
+        else if (expired)
+            changed = true;
+        else if (count == 0)
+            count = 1;
+    }
+    setDebounceCount(col, row, count);
+    if (changed) {
+        CRTP(Derived).onButtonChanged(row, col, state);
+        setPrevState(col, row, state);
+    }
+}
+
+template <class Derived, uint8_t NumRows, uint8_t NumCols>
+void ButtonMatrix<Derived, NumRows, NumCols>::setDebounceMode(
+    ButtonMatrixDebounceMode mode) {
+    memset(debounceCounts, 0, sizeof(debounceCounts));
+    debounceMode = mode;
+}
+
 template <class Derived, uint8_t NumRows, uint8_t NumCols>
 void ButtonMatrix<Derived, NumRows, NumCols>::begin() {
+    if (rowReader != nullptr) {
+        rowReader->begin(rowPins.data, colPins.data);
+        return;
+    }
     // make all columns input pins and enable
     // the internal pull-up resistors
     for (const pin_t &colPin : colPins)
@@ -88,4 +173,21 @@ void ButtonMatrix<Derived, NumRows, NumCols>::setPrevState(uint8_t col,
         prevStates[bitsToIndex(bits)] &= ~bitsToBitmask(bits);
 }
 
+template <class Derived, uint8_t NumRows, uint8_t NumCols>
+uint8_t ButtonMatrix<Derived, NumRows, NumCols>::getDebounceCount(
+    uint8_t col, uint8_t row) const {
+    uint8_t bits = positionToBits(col, row);
+    return (debounceCounts[bits >> 2] >> (2 * (bits & 3))) & 0b11;
+}
+
+template <class Derived, uint8_t NumRows, uint8_t NumCols>
+void ButtonMatrix<Derived, NumRows, NumCols>::setDebounceCount(uint8_t col,
+                                                               uint8_t row,
+                                                               uint8_t count) {
+    uint8_t bits = positionToBits(col, row);
+    uint8_t shift = 2 * (bits & 3);
+    uint8_t &counts = debounceCounts[bits >> 2];
+    counts = (counts & ~(0b11 << shift)) | (count << shift);
+}
+
 END_AH_NAMESPACE
\ No newline at end of file
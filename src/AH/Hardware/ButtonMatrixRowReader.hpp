@@ -0,0 +1,191 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include <AH/Error/Error.hpp>
+#include <AH/Hardware/ExtendedInputOutput/ExtendedIOElement.hpp>
+#include <AH/Hardware/Hardware-Types.hpp>
+#include <AH/STL/type_traits>
+
+BEGIN_AH_NAMESPACE
+
+/**
+ * @brief   Scan backend for @ref ButtonMatrix that samples all columns of a
+ *          row at once.
+ *
+ * By default, a button matrix reads every button with a separate call to
+ * `digitalRead`. A row reader can read the columns more efficiently, e.g.
+ * by reading a complete GPIO port register, or by reading all inputs of an
+ * IO expander in a single transfer. Implement this interface to supply a
+ * custom reader, or use one of the readers below.
+ *
+ * @see     ButtonMatrix::setRowReader
+ *
+ * @ingroup AH_HardwareUtils
+ */
+class ButtonMatrixRowReader {
+  public:
+    /**
+     * @brief   Initialize the pins: make all rows Hi-Z, and enable the
+     *          pull-up resistors of the columns.
+     *
+     * @param   rowPins
+     *          The row pins of the matrix, should remain valid until the
+     *          reader is no longer used.
+     * @param   colPins
+     *          The column pins of the matrix, should remain valid until the
+     *          reader is no longer used.
+     */
+    virtual void begin(const pin_t *rowPins, const pin_t *colPins) = 0;
+
+    /**
+     * @brief   Drive the given row low, read the states of all columns, and
+     *          make the row Hi-Z again.
+     *
+     * @param   row
+     *          The index of the row to read.
+     * @param[out] colStates
+     *          The states of the columns, one bit per column, least
+     *          significant bit of the first byte first.
+     */
+    virtual void readRow(uint8_t row, uint8_t *colStates) = 0;
+
+  protected:
+    ~ButtonMatrixRowReader() = default;
+
+    static void setColState(uint8_t *colStates, uint8_t col, bool state) {
+        if (state)
+            colStates[col / 8] |= 1 << (col % 8);
+        else
+            colStates[col / 8] &= ~(1 << (col % 8));
+    }
+};
+
+/**
+ * @brief   Row reader for button matrices on @ref ExtendedIOElement%s, such
+ *          as the MCP23017.
+ *
+ * The inputs of every IO element that has column pins are read once per row
+ * (e.g. a single I²C transfer), and the column states are then taken from
+ * its buffer. Native Arduino pins are supported as well, they are read using
+ * `digitalRead`.
+ *
+ * @ingroup AH_ExtIO
+ */
+template <uint8_t NumRows, uint8_t NumCols>
+class ExtIOButtonMatrixRowReader : public ButtonMatrixRowReader {
+  public:
+    void begin(const pin_t *rowPins, const pin_t *colPins) override {
+        for (uint8_t row = 0; row < NumRows; ++row) {
+            rows[row] = ExtIO::CachedExtIOPin(rowPins[row]);
+            ExtIO::pinMode(rows[row], INPUT);
+        }
+        for (uint8_t col = 0; col < NumCols; ++col) {
+            cols[col] = ExtIO::CachedExtIOPin(colPins[col]);
+            ExtIO::pinMode(cols[col], INPUT_PULLUP);
+            // Only the first column of every element has to refresh the
+            // input buffer of that element
+            refresh[col] = cols[col].element != nullptr;
+            for (uint8_t prev = 0; prev < col; ++prev)
+                if (cols[prev].element == cols[col].element)
+                    refresh[col] = false;
+        }
+    }
+
+    void readRow(uint8_t row, uint8_t *colStates) override {
+        ExtIO::pinMode(rows[row], OUTPUT);
+#if !defined(__AVR__) && defined(ARDUINO)
+        delayMicroseconds(SELECT_LINE_DELAY);
+#endif
+        for (uint8_t col = 0; col < NumCols; ++col)
+            if (refresh[col])
+                cols[col].element->updateBufferedInputs();
+        for (uint8_t col = 0; col < NumCols; ++col)
+            setColState(colStates, col,
+                        cols[col].element
+                            ? ExtIO::digitalReadBuffered(cols[col])
+                            : ExtIO::digitalRead(cols[col]));
+        ExtIO::pinMode(rows[row], INPUT);
+    }
+
+  private:
+    ExtIO::CachedExtIOPin rows[NumRows];
+    ExtIO::CachedExtIOPin cols[NumCols];
+    bool refresh[NumCols] = {};
+};
+
+#if defined(portInputRegister) && defined(digitalPinToPort) &&                 \
+    defined(digitalPinToBitMask)
+
+/**
+ * @brief   Row reader for button matrices on native Arduino pins that reads
+ *          the GPIO port registers directly.
+ *
+ * Every port that has column pins is read once per row, instead of calling
+ * `digitalRead` for every column. All column pins must be native Arduino
+ * pins, the row pins can be any pins.
+ *
+ * Only available on boards that provide the `portInputRegister` macro (e.g.
+ * AVR and Teensy).
+ *
+ * @ingroup AH_HardwareUtils
+ */
+template <uint8_t NumRows, uint8_t NumCols>
+class PortButtonMatrixRowReader : public ButtonMatrixRowReader {
+  public:
+    void begin(const pin_t *rowPins, const pin_t *colPins) override {
+        for (uint8_t row = 0; row < NumRows; ++row) {
+            rows[row] = ExtIO::CachedExtIOPin(rowPins[row]);
+            ExtIO::pinMode(rows[row], INPUT);
+        }
+        numPorts = 0;
+        for (uint8_t col = 0; col < NumCols; ++col) {
+            if (!ExtIO::isNativePin(colPins[col]))
+                ERROR(F("Error: column pin ")
+                          << colPins[col] << F(" is not a native pin"),
+                      0x7273);
+            ArduinoPin_t pin = arduino_pin_cast(colPins[col]);
+            ::pinMode(pin, INPUT_PULLUP);
+            Register reg = portInputRegister(digitalPinToPort(pin));
+            uint8_t port = 0;
+            while (port < numPorts && ports[port] != reg)
+                ++port;
+            if (port == numPorts)
+                ports[numPorts++] = reg;
+            colPorts[col] = port;
+            colMasks[col] = digitalPinToBitMask(pin);
+        }
+    }
+
+    void readRow(uint8_t row, uint8_t *colStates) override {
+        ExtIO::pinMode(rows[row], OUTPUT);
+#if !defined(__AVR__) && defined(ARDUINO)
+        delayMicroseconds(SELECT_LINE_DELAY);
+#endif
+        Value values[NumCols];
+        for (uint8_t port = 0; port < numPorts; ++port)
+            values[port] = *ports[port];
+        for (uint8_t col = 0; col < NumCols; ++col)
+            setColState(colStates, col, values[colPorts[col]] & colMasks[col]);
+        ExtIO::pinMode(rows[row], INPUT);
+    }
+
+  private:
+    using Register = decltype(portInputRegister(digitalPinToPort(0)));
+    using Value = typename std::remove_cv<
+        typename std::remove_pointer<Register>::type>::type;
+    using Mask = decltype(digitalPinToBitMask(0));
+
+    ExtIO::CachedExtIOPin rows[NumRows];
+    Register ports[NumCols] = {};
+    uint8_t colPorts[NumCols] = {};
+    Mask colMasks[NumCols] = {};
+    uint8_t numPorts = 0;
+};
+
+#endif
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
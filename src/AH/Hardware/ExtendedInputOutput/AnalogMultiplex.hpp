@@ -195,6 +195,96 @@ using CD74HC4067 = AnalogMultiplex<4>;
  */
 using CD74HC4051 = AnalogMultiplex<3>;
 
+/**
+ * @brief   A class for reading multiplexed analog inputs that scans all
+ *          inputs at once, and caches their values.
+ *
+ * Every call to @ref updateBufferedInputs (e.g. by `Control_Surface.loop()`)
+ * reads all inputs of the multiplexer in a single pass. The multiplexer is
+ * enabled only once per pass, and only the address lines that change are
+ * written. By default, the inputs are scanned in Gray code order, so only a
+ * single address line toggles between two inputs.
+ *
+ * Analog reads of this multiplexer (both @ref analogRead and
+ * @ref analogReadBuffered) return the cached values of the most recent scan.
+ * Digital reads are not cached, they read the input directly.
+ *
+ * Uses one `analog_t` of RAM per input for the cache.
+ *
+ * @tparam  N
+ *          The number of address lines.
+ *
+ * @ingroup AH_ExtIO
+ */
+template <uint8_t N>
+class BufferedAnalogMultiplex : public AnalogMultiplex<N> {
+  public:
+    /// @copydoc AnalogMultiplex::AnalogMultiplex
+    BufferedAnalogMultiplex(pin_t analogPin,
+                            const Array<pin_t, N> &addressPins,
+                            pin_t enablePin = NO_PIN)
+        : AnalogMultiplex<N>(analogPin, addressPins, enablePin) {}
+
+    /**
+     * @brief   Get the analog value of the given input from the most recent
+     *          scan.
+     *
+     * @param   pin
+     *          The multiplexer's pin number to read from.
+     */
+    analog_t analogRead(pin_t pin) override { return values[pin]; }
+
+    /**
+     * @copydoc analogRead
+     */
+    analog_t analogReadBuffered(pin_t pin) override { return values[pin]; }
+
+    /**
+     * @brief   Initialize the multiplexer, and read all inputs.
+     */
+    void begin() override;
+
+    /**
+     * @brief   Read all inputs of the multiplexer and cache their values.
+     */
+    void updateBufferedInputs() override;
+
+    /**
+     * @brief   Specify whether to scan the inputs in Gray code order (enabled
+     *          by default), or in the order of their pin numbers.
+     */
+    void grayCodeScan(bool grayCodeScan_) {
+        this->grayCodeScan_ = grayCodeScan_;
+    }
+
+  protected:
+    /**
+     * @brief   Write only the address lines that differ between the two
+     *          addresses.
+     */
+    void changeMuxAddress(uint8_t from, uint8_t to);
+
+  private:
+    analog_t values[1 << N] = {};
+    bool grayCodeScan_ = true;
+};
+
+/**
+ * @brief   An alias for BufferedAnalogMultiplex<4> to use with CD74HC4067
+ *          analog multiplexers.
+ * 
+ * @ingroup AH_ExtIO
+ */
+using BufferedCD74HC4067 = BufferedAnalogMultiplex<4>;
+
+/**
+ * @brief   An alias for BufferedAnalogMultiplex<3> to use with CD74HC4051
+ *          analog multiplexers.
+ * 
+ * @ingroup AH_ExtIO
+ */
+using BufferedCD74HC4051 = BufferedAnalogMultiplex<3>;
+
 // -------------------------------------------------------------------------- //
 
 template <uint8_t N>
@@ -270,6 +360,44 @@ void AnalogMultiplex<N>::afterReading() {
         ExtIO::digitalWrite(enablePin, MUX_DISABLED);
 }
 
+// -------------------------------------------------------------------------- //
+
+template <uint8_t N>
+void BufferedAnalogMultiplex<N>::begin() {
+    AnalogMultiplex<N>::begin();
+    updateBufferedInputs();
+}
+
+template <uint8_t N>
+void BufferedAnalogMultiplex<N>::updateBufferedInputs() {
+    uint8_t prevAddress = 0;
+    for (uint8_t i = 0; i < (1 << N); ++i) {
+        uint8_t address = grayCodeScan_ ? i ^ (i >> 1) : i;
+        if (i == 0)
+            this->prepareReading(address);
+        else
+            changeMuxAddress(prevAddress, address);
+        if (this->discardFirstReading_)
+            (void)ExtIO::analogRead(this->analogPin); // Discard first reading
+        values[address] = ExtIO::analogRead(this->analogPin);
+        prevAddress = address;
+    }
+    this->afterReading();
+}
+
+template <uint8_t N>
+void BufferedAnalogMultiplex<N>::changeMuxAddress(uint8_t from, uint8_t to) {
+    uint8_t mask = 1;
+    for (const pin_t &addressPin : this->addressPins) {
+        if ((from ^ to) & mask)
+            ExtIO::digitalWrite(addressPin, (to & mask) != 0 ? HIGH : LOW);
+        mask <<= 1;
+    }
+#if !defined(__AVR__) && defined(ARDUINO)
+    delayMicroseconds(SELECT_LINE_DELAY);
+#endif
+}
+
 END_AH_NAMESPACE
 
 AH_DIAGNOSTIC_POP()
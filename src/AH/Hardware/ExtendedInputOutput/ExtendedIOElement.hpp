@@ -275,6 +275,7 @@ class ExtendedIOElement : public UpdatableCRTP<ExtendedIOElement> {
 namespace ExtIO {
 
 struct CachedExtIOPin {
+    CachedExtIOPin() : element(nullptr), elementPin(NO_PIN) {}
     explicit CachedExtIOPin(pin_t pin)
         : element(pin == NO_PIN || isNativePin(pin) ? nullptr
                                                     : getIOElementOfPin(pin)),
@@ -12,6 +12,9 @@ AH_DIAGNOSTIC_EXTERNAL_HEADER()
 #include <SPI.h>
 AH_DIAGNOSTIC_POP()
 
+#include <AH/STL/type_traits>
+#include <AH/STL/utility> // std::declval
+
 BEGIN_AH_NAMESPACE
 
 /**
@@ -25,6 +28,20 @@ BEGIN_AH_NAMESPACE
  * @tparam  SPIDriver
  *          The SPI class to use. Usually, the default is fine.
  * 
+ * The complete buffer is sent using a single call to the bulk
+ * `transfer(buffer, length)` function of the SPI driver.
+ * 
+ * If the SPI driver has a member function
+ * ~~~cpp
+ * void transferAsync(const uint8_t *buffer, size_t length,
+ *                    void (*callback)(void *), void *arg);
+ * ~~~
+ * that starts a (DMA) transfer and calls `callback(arg)` when it's done, the
+ * transfer is asynchronous: @ref updateBufferedOutputs returns immediately,
+ * and the latch pin is toggled from the completion callback. Changes made
+ * while a transfer is in progress are sent by the next call to
+ * @ref updateBufferedOutputs after the transfer completes.
+ * 
  * @ingroup AH_ExtIO
  */
 template <uint16_t N, class SPIDriver = decltype(SPI) &>
@@ -71,8 +88,35 @@ class SPIShiftRegisterOut : public ShiftRegisterOutBase<N> {
      */
     void updateBufferedOutputs() override;
 
+    /// Check whether an asynchronous transfer is still in progress.
+    bool isBusy() const { return busy; }
+
+  private:
+    using Driver = typename std::remove_reference<SPIDriver>::type;
+
+    template <class S>
+    static auto hasTransferAsync(int) -> decltype(
+        std::declval<S &>().transferAsync(
+            std::declval<const uint8_t *>(), size_t(),
+            std::declval<void (*)(void *)>(), std::declval<void *>()),
+        std::true_type());
+    template <class S>
+    static std::false_type hasTransferAsync(long);
+
+    /// Copy the state buffer to the transmit buffer, in the right order.
+    void fillTransmitBuffer();
+    /// Send the transmit buffer and wait for the transfer to complete.
+    void transfer(std::false_type);
+    /// Start sending the transmit buffer, the transfer is completed by
+    /// @ref onTransferComplete.
+    void transfer(std::true_type);
+    /// Latch the outputs after an asynchronous transfer.
+    static void onTransferComplete(void *arg);
+
   private:
     SPIDriver spi;
+    uint8_t txBuffer[(N + 7) / 8];
+    volatile bool busy = false;
 
   public:
     SPISettings settings{SPI_MAX_SPEED, this->bitOrder, SPI_MODE0};
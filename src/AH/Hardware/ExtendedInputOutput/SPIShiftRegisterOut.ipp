@@ -1,5 +1,3 @@
-#ifdef ARDUINO // TODO: I'm too lazy to mock the SPI library
-
 #include "ExtendedInputOutput.hpp"
 #include "SPIShiftRegisterOut.hpp"
 
@@ -25,22 +23,47 @@ void SPIShiftRegisterOut<N, SPIDriver>::begin() {
 
 template <uint16_t N, class SPIDriver>
 void SPIShiftRegisterOut<N, SPIDriver>::updateBufferedOutputs() {
-    if (!this->dirty)
+    if (!this->dirty || busy)
         return;
-    spi.beginTransaction(settings);
-    ExtIO::digitalWrite(this->latchPin, LOW);
+    fillTransmitBuffer();
+    this->dirty = false;
+    transfer(decltype(hasTransferAsync<Driver>(0))());
+}
+
+template <uint16_t N, class SPIDriver>
+void SPIShiftRegisterOut<N, SPIDriver>::fillTransmitBuffer() {
     const uint16_t bufferLength = this->buffer.getBufferLength();
     if (this->bitOrder == LSBFIRST)
         for (uint16_t i = 0; i < bufferLength; i++)
-            spi.transfer(this->buffer.getByte(i));
+            txBuffer[i] = this->buffer.getByte(i);
     else
-        for (uint16_t i = bufferLength; i-->0;)
-            spi.transfer(this->buffer.getByte(i));
+        for (uint16_t i = 0; i < bufferLength; i++)
+            txBuffer[i] = this->buffer.getByte(bufferLength - 1 - i);
+}
+
+template <uint16_t N, class SPIDriver>
+void SPIShiftRegisterOut<N, SPIDriver>::transfer(std::false_type) {
+    spi.beginTransaction(settings);
+    ExtIO::digitalWrite(this->latchPin, LOW);
+    spi.transfer(txBuffer, sizeof(txBuffer));
     ExtIO::digitalWrite(this->latchPin, HIGH);
     spi.endTransaction();
-    this->dirty = false;
 }
 
-END_AH_NAMESPACE
+template <uint16_t N, class SPIDriver>
+void SPIShiftRegisterOut<N, SPIDriver>::transfer(std::true_type) {
+    busy = true;
+    spi.beginTransaction(settings);
+    ExtIO::digitalWrite(this->latchPin, LOW);
+    spi.transferAsync(txBuffer, sizeof(txBuffer), &onTransferComplete, this);
+}
 
-#endif
\ No newline at end of file
+template <uint16_t N, class SPIDriver>
+void SPIShiftRegisterOut<N, SPIDriver>::onTransferComplete(void *arg) {
+    auto self = static_cast<SPIShiftRegisterOut *>(arg);
+    ExtIO::digitalWrite(self->latchPin, HIGH);
+    self->spi.endTransaction();
+    self->busy = false;
+}
+
+END_AH_NAMESPACE
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include <AH/Filters/EMABank.hpp>
+#include <AH/Hardware/FilteredAnalog.hpp>
+
+BEGIN_AH_NAMESPACE
+
+/**
+ * @brief   A class that reads and filters many analog inputs at once.
+ *
+ * Every channel behaves exactly like a @ref FilteredAnalog object with the
+ * same template parameters: the raw value is filtered by an EMA filter, an
+ * optional mapping function is applied, and finally hysteresis is applied.
+ *
+ * The difference is that the filter states and hysteresis levels of all
+ * channels are stored in contiguous arrays, and all channels are updated in
+ * a single call to @ref update. The filtering and hysteresis steps are
+ * simple loops over these arrays, which can be vectorized by the compiler.
+ * This is more efficient than many separate FilteredAnalog objects if you
+ * have a large number of analog inputs (e.g. many potentiometers connected
+ * through multiplexers).
+ *
+ * @tparam  N
+ *          The number of analog inputs.
+ * @tparam  Precision
+ *          The number of bits of precision the output should have.
+ * @tparam  FilterShiftFactor
+ *          The number of bits used for the EMA filter.
+ * @tparam  FilterType
+ *          The type to use for the intermediate types of the filter.
+ * @tparam  AnalogType
+ *          The type to use for the analog values.
+ * @tparam  IncRes
+ *          The number of bits to increase the resolution of the analog reading
+ *          by.
+ *
+ * @see     FilteredAnalog
+ *
+ * @ingroup AH_HardwareUtils
+ */
+template <size_t N, uint8_t Precision = 10,
+          uint8_t FilterShiftFactor = ANALOG_FILTER_SHIFT_FACTOR,
+          class FilterType = ANALOG_FILTER_TYPE, class AnalogType = analog_t,
+          uint8_t IncRes = MaximumFilteredAnalogIncRes<
+              FilterShiftFactor, FilterType, AnalogType>::value>
+class FilteredAnalogBank {
+  public:
+    /// A function pointer to a mapping function to map analog values.
+    /// @see    map()
+    using MappingFunction = AnalogType (*)(AnalogType);
+
+    /**
+     * @brief   Construct a new FilteredAnalogBank object.
+     *
+     * @param   analogPins
+     *          The analog pins to read from.
+     * @param   initial
+     *          The initial value of the filters.
+     */
+    FilteredAnalogBank(const PinList<N> &analogPins, AnalogType initial = 0)
+        : analogPins(analogPins), filters(widen(initial)) {}
+
+    /**
+     * @brief   Reset the filters of all channels to the given value.
+     *
+     * @param   value
+     *          The value to reset the filter states to.
+     */
+    void reset(AnalogType value = 0) {
+        for (size_t i = 0; i < N; ++i)
+            reset(i, value);
+    }
+
+    /**
+     * @brief   Reset the filter of the given channel to the given value.
+     *
+     * @param   index
+     *          The index of the channel to reset.
+     * @param   value
+     *          The value to reset the filter state to.
+     */
+    void reset(size_t index, AnalogType value) {
+        AnalogType widevalue = widen(value);
+        filters.reset(index, widevalue);
+        levels[index] = widevalue >> HysteresisBits;
+    }
+
+    /**
+     * @brief   Reset the filtered values of all channels to the values that
+     *          are currently being measured at the analog inputs.
+     *
+     * This is useful to avoid transient effects upon initialization.
+     */
+    void resetToCurrentValue() {
+        for (size_t i = 0; i < N; ++i) {
+            AnalogType widevalue = getRawValue(i);
+            filters.reset(i, widevalue);
+            levels[i] = widevalue >> HysteresisBits;
+        }
+    }
+
+    /**
+     * @brief   Specify a mapping function that is applied to the analog
+     *          values of all channels after filtering and before applying
+     *          hysteresis.
+     *
+     * @param   fn
+     *          A function pointer that takes the filtered value (of
+     *          ADC_BITS + IncRes bits wide) as a parameter, and returns a
+     *          value of ADC_BITS + IncRes bits wide, or `nullptr` to disable
+     *          the mapping.
+     *
+     * @see     FilteredAnalog::map
+     */
+    void map(MappingFunction fn) { mapFn = fn; }
+
+    /**
+     * @brief   Get the mapping function.
+     */
+    MappingFunction getMappingFunction() const { return mapFn; }
+
+    /**
+     * @brief   Invert the analog values of all channels.
+     *
+     * @note    This overrides the mapping function set by the `map` method.
+     *
+     * @see     FilteredAnalog::invert
+     */
+    void invert() {
+        constexpr AnalogType maxval = getMaxRawValue();
+        map([](AnalogType val) -> AnalogType { return maxval - val; });
+    }
+
+    /**
+     * @brief   Read all analog inputs, apply the mapping function, and update
+     *          the averages.
+     *
+     * @retval  true
+     *          The value of at least one of the channels changed since last
+     *          time it was updated. Use @ref hasChanged to find out which.
+     * @retval  false
+     *          All values are still the same.
+     */
+    bool update() {
+        AnalogType values[N];
+        for (size_t i = 0; i < N; ++i)
+            values[i] = getRawValue(i);
+        filters.filter(values);
+        if (mapFn)
+            for (size_t i = 0; i < N; ++i)
+                values[i] = mapFn(values[i]);
+        return updateHysteresis(values);
+    }
+
+    /**
+     * @brief   Check whether the value of the given channel changed during the
+     *          last call to @ref update.
+     *
+     * @param   index
+     *          The index of the channel.
+     */
+    bool hasChanged(size_t index) const { return changed[index]; }
+
+    /**
+     * @brief   Get the filtered value of the given analog input (with the
+     *          mapping function applied).
+     *
+     * @note    This function just returns the value from the last call to
+     *          @ref update, it doesn't read the analog input again.
+     *
+     * @param   index
+     *          The index of the channel.
+     * @return  The filtered value of the analog input, as a number
+     *          of `Precision` bits wide.
+     */
+    AnalogType getValue(size_t index) const { return levels[index]; }
+
+    /**
+     * @brief   Get the filtered value of the given analog input with the
+     *          mapping function applied as a floating point number from 0.0
+     *          to 1.0.
+     *
+     * @param   index
+     *          The index of the channel.
+     */
+    float getFloatValue(size_t index) const {
+        return getValue(index) * (1.0f / (ldexpf(1.0f, Precision) - 1.0f));
+    }
+
+    /**
+     * @brief   Read the raw value of the given analog input without any
+     *          filtering or mapping applied, but with its bit depth increased
+     *          by @c IncRes.
+     *
+     * @param   index
+     *          The index of the channel.
+     */
+    AnalogType getRawValue(size_t index) const {
+        AnalogType value = ExtIO::analogRead(analogPins[index]);
+#ifdef ESP8266
+        if (value > 1023)
+            value = 1023;
+#endif
+        return increaseBitDepth<ADC_BITS + IncRes, ADC_BITS, AnalogType>(value);
+    }
+
+    /**
+     * @brief   Get the maximum value that can be returned from @ref getRawValue.
+     */
+    constexpr static AnalogType getMaxRawValue() {
+        return (1ul << (ADC_BITS + IncRes)) - 1ul;
+    }
+
+    /// @copydoc    GenericFilteredAnalog::setupADC
+    static void setupADC() {
+#if HAS_ANALOG_READ_RESOLUTION
+        analogReadResolution(ADC_BITS);
+#endif
+    }
+
+    /// Get the analog pin of the given channel.
+    pin_t getPin(size_t index) const { return analogPins[index]; }
+
+    /// The number of channels.
+    constexpr static size_t length = N;
+
+  private:
+    static AnalogType widen(AnalogType value) {
+        return increaseBitDepth<ADC_BITS + IncRes, Precision, AnalogType,
+                                AnalogType>(value);
+    }
+
+    /// Apply hysteresis to all channels, with the same thresholds as
+    /// @ref Hysteresis, but without branches.
+    bool updateHysteresis(const AnalogType *values) {
+        bool anyChanged = false;
+        for (size_t i = 0; i < N; ++i) {
+            AnalogType in = values[i];
+            AnalogType prev = levels[i];
+            AnalogType prevFull = AnalogType(prev << HysteresisBits) | offset;
+            AnalogType lowerbound =
+                prev > 0 ? AnalogType(prevFull - margin) : AnalogType(0);
+            AnalogType upperbound =
+                prev < max_out ? AnalogType(prevFull + margin) : max_in;
+            bool ch = in < lowerbound || in > upperbound;
+            levels[i] = ch ? AnalogType(in >> HysteresisBits) : prev;
+            changed[i] = ch;
+            anyChanged |= ch;
+        }
+        return anyChanged;
+    }
+
+  private:
+    constexpr static uint8_t HysteresisBits = ADC_BITS + IncRes - Precision;
+    constexpr static AnalogType margin = (1ul << HysteresisBits) - 1ul;
+    constexpr static AnalogType offset =
+        HysteresisBits >= 1 ? 1ul << (HysteresisBits - 1) : 0;
+    constexpr static AnalogType max_in = static_cast<AnalogType>(-1);
+    constexpr static AnalogType max_out =
+        static_cast<AnalogType>(max_in >> HysteresisBits);
+
+    using EMABank_t = EMABank<N, FilterShiftFactor, AnalogType, FilterType>;
+
+    static_assert(
+        ADC_BITS + IncRes + FilterShiftFactor <= sizeof(FilterType) * CHAR_BIT,
+        "Error: FilterType is not wide enough to hold the maximum value");
+    static_assert(
+        ADC_BITS + IncRes <= sizeof(AnalogType) * CHAR_BIT,
+        "Error: AnalogType is not wide enough to hold the maximum value");
+    static_assert(
+        Precision <= ADC_BITS + IncRes,
+        "Error: Precision is larger than the increased ADC precision");
+    static_assert(EMABank_t::supports_range(AnalogType(0), getMaxRawValue()),
+                  "Error: EMA filter type doesn't support full ADC range");
+    static_assert(max_in > 0, "Error: only unsigned types are supported");
+
+    PinList<N> analogPins;
+    MappingFunction mapFn = nullptr;
+    EMABank_t filters;
+    AnalogType levels[N] = {};
+    bool changed[N] = {};
+};
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
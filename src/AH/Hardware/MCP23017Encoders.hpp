@@ -48,6 +48,8 @@ class MCP23017Encoders {
         RegisterEncoders<uint16_t, 8, EncoderPositionType, InterruptSafe>;
 
     RegisterEncoderType encs;
+    bool burst = false;
+    bool resync = false;
 
   protected:
     /// Write any data to the MCP23017.
@@ -74,20 +76,35 @@ class MCP23017Encoders {
 
     /// Read the state of all GPIO pins.
     uint16_t readGPIO() {
-        // No need to specify the register address, since this was done in the
-        // begin method, and the MCP23017 mode was set to Byte mode with
-        // IOCON.BANK = 0 (see §3.2.1 in the datasheet).
-        //
-        // TODO:
-        // For some reason, it sometimes seems to mess up though, and it'll read
-        // the wrong register, so we'll select the register again (for now).
+        uint16_t state = 0;
+        readGPIO(state);
+        return state;
+    }
 
-        writeI2C(0x12); // GPIOA
+    /// Read the state of all GPIO pins.
+    /// @return False if the MCP23017 didn't send both GPIO registers.
+    bool readGPIO(uint16_t &state) {
+        // In burst mode, there's no need to specify the register address,
+        // since this was done in the begin method, and the MCP23017 mode was
+        // set to Byte mode with IOCON.BANK = 0 (see §3.2.1 in the datasheet),
+        // so the address pointer toggles between GPIOA and GPIOB.
+        //
+        // Otherwise, the register is selected again before every read, as it
+        // seems to get out of sync sometimes. In burst mode, the register is
+        // only selected again after a failed read.
+        if (!burst || resync)
+            writeI2C(0x12); // GPIOA
+        resync = false;
 
-        this->wire->requestFrom(address, size_t(2));
+        if (this->wire->requestFrom(address, size_t(2)) != 2) {
+            // The address pointer may no longer point to GPIOA
+            resync = true;
+            return false;
+        }
         uint8_t a = this->wire->read();
         uint16_t b = this->wire->read();
-        return a | (b << 8);
+        state = a | (b << 8);
+        return true;
     }
 
   public:
@@ -169,13 +186,39 @@ class MCP23017Encoders {
         writeI2C(0x12); // GPIOA
 
         /// Initialize the state
+        resync = false;
         encs.reset(readGPIO());
     }
 
+    /**
+     * @brief   Enable or disable burst reads.
+     *
+     * By default, the address of the GPIOA register is written to the
+     * MCP23017 before every read of the GPIO registers, so each update
+     * takes two I²C transactions. In burst mode, the MCP23017's address
+     * pointer is left pointing at the GPIOA/GPIOB register pair, so each
+     * update only needs a single two-byte read.
+     *
+     * If a read fails, the register address is written again before the next
+     * read. Call @ref resyncAddressPointer if other code accesses the
+     * registers of the same MCP23017.
+     */
+    void setBurstRead(bool enable) { burst = enable; }
+    /// Check whether burst reads are enabled.
+    /// @see    setBurstRead
+    bool getBurstRead() const { return burst; }
+
+    /// Write the address of the GPIOA register again before the next read.
+    void resyncAddressPointer() { resync = true; }
+
     /**
      * @brief   If the state of the MCP23017's GPIO changed, read the new state
      *          and update the encoder positions.
      * 
+     * If an interrupt pin was specified, the GPIO registers are only read if
+     * the MCP23017 signals a pin change, otherwise they are read on every
+     * call. Reading the registers clears the interrupt.
+     * 
      * Can be called from within an ISR on boards that support I²C inside of 
      * ISRs, on the condition that @p InterruptSafe is set to `true`.
      * 
@@ -188,8 +231,9 @@ class MCP23017Encoders {
             ExtIO::digitalRead(interrupt_pin) == HIGH)
             return;
         // Read both GPIO A and B
-        uint16_t newstate = readGPIO();
-        encs.update(newstate);
+        uint16_t newstate;
+        if (readGPIO(newstate))
+            encs.update(newstate);
     }
 
     /**
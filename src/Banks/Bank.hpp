@@ -2,10 +2,12 @@
 
 #pragma once
 
+#include <AH/Arduino-Wrapper.h> // micros
 #include <AH/Containers/LinkedList.hpp>
 #include <AH/Debug/Debug.hpp>
 #include <AH/Error/Error.hpp>
 #include <Selectors/Selectable.hpp>
+#include <Settings/SettingsWrapper.hpp>
 
 BEGIN_CS_NAMESPACE
 
@@ -81,6 +83,16 @@ class BankSettingChangeCallback
     virtual void onBankSettingChange() {}
 };
 
+/// Statistics about the most recent bank change.
+/// @see    Bank::getLastSelectStats
+struct BankSelectStats {
+    /// The number of bankable elements that were notified.
+    uint16_t callbacks = 0;
+    /// The time it took to notify them, in microseconds. Only measured if
+    /// @ref BANK_SELECT_TIMING is enabled.
+    unsigned long duration = 0;
+};
+
 /// A class that groups @ref BankableMIDIOutputElements and
 /// @ref BankableMIDIInputElements, and allows the user to change the addresses
 /// of these elements.
@@ -109,12 +121,17 @@ class Bank : public Selectable<NumBanks>, public OutputBank {
     /// Select the given bank setting.
     ///
     /// All Bankable MIDI Input elements that were added to this bank will be
-    /// updated.
+    /// updated, in a single pass over the list, even if the setting didn't
+    /// change. The callbacks are not deferred or batched: when this function
+    /// returns, all elements reflect the new setting.
     ///
     /// @param  bankSetting
     ///         The new setting to select.
     void select(setting_t bankSetting) override;
 
+    /// Get the statistics of the most recent bank change.
+    BankSelectStats getLastSelectStats() const { return lastSelectStats; }
+
     /// Get the number of banks.
     constexpr static uint8_t getNumberOfBanks() { return NumBanks; }
 
@@ -137,6 +154,7 @@ class Bank : public Selectable<NumBanks>, public OutputBank {
     /// The list is updated automatically when Bankable MIDI Input Elements are
     /// created or destroyed.
     DoublyLinkedList<BankSettingChangeCallback> inputBankables;
+    BankSelectStats lastSelectStats;
 };
 
 END_CS_NAMESPACE
@@ -159,8 +177,14 @@ template <setting_t NumBanks>
 void Bank<NumBanks>::select(setting_t bankSetting) {
     bankSetting = this->validateSetting(bankSetting);
     OutputBank::select(bankSetting);
-    for (BankSettingChangeCallback &e : inputBankables)
+    unsigned long start = BANK_SELECT_TIMING ? micros() : 0;
+    uint16_t callbacks = 0;
+    for (BankSettingChangeCallback &e : inputBankables) {
         e.onBankSettingChange();
+        ++callbacks;
+    }
+    lastSelectStats.callbacks = callbacks;
+    lastSelectStats.duration = BANK_SELECT_TIMING ? micros() - start : 0;
 }
 
 END_CS_NAMESPACE
\ No newline at end of file
@@ -21,6 +21,41 @@ class SingleAddress : public OutputBankableMIDIAddress {
     MIDIAddress address;
 };
 
+/**
+ * @brief   A bankable MIDI address, like @ref SingleAddress, with the active
+ *          addresses of all bank settings computed upon construction.
+ * 
+ * Getting the active address is a single table lookup, at the cost of one 
+ * MIDIAddress of RAM per bank setting.
+ * 
+ * The bankable MIDI output elements use @ref SingleAddress by default. To opt
+ * in, use this class as the `BankAddress` template argument of one of the
+ * generic elements, e.g.
+ * `Bankable::MIDIButton<Bankable::PrecomputedAddress<4>, DigitalNoteSender>`.
+ * See @ref Precomputed-Bank-Addresses.ino for an example.
+ * 
+ * @tparam  NumBanks
+ *          The number of bank settings of the bank.
+ */
+template <setting_t NumBanks>
+class PrecomputedAddress : public OutputBankableMIDIAddress_Base {
+  public:
+    PrecomputedAddress(BankConfig<NumBanks> config, MIDIAddress address)
+        : OutputBankableMIDIAddress_Base(config.bank), address(address) {
+        OutputBankableMIDIAddress offsets = {config.bank, config.type};
+        for (setting_t s = 0; s < NumBanks; ++s)
+            addresses[s] = address + offsets.getAddressOffset(s);
+    }
+
+    MIDIAddress getBaseAddress() const { return address; }
+
+    MIDIAddress getActiveAddress() const { return addresses[getSelection()]; }
+
+  private:
+    MIDIAddress address;
+    Array<MIDIAddress, NumBanks> addresses;
+};
+
 template <uint8_t N>
 class SingleAddressMultipleBanks {
   public:
@@ -39,6 +39,7 @@ void Control_Surface_::begin() {
     MIDIInputElementCP::beginAll();
     MIDIInputElementPB::beginAll();
     MIDIInputElementSysEx::beginAll();
+    MIDIInputElementParameterNumber::beginAll();
     Updatable<>::beginAll();
     Updatable<Display>::beginAll();
     displayTimer.begin();
@@ -70,10 +71,20 @@ void Control_Surface_::loop() {
     if (displayTimer)
         updateDisplays();
     ExtendedIOElement::updateAllBufferedOutputs();
+    MIDI_Interface::flushAllAtLoopEnd();
 }
 
 void Control_Surface_::updateMidiInput() {
     Updatable<MIDI_Interface>::updateAll();
+    if (parameterNumberAssembly)
+        pollParameterNumbers(false);
+}
+
+void Control_Surface_::pollParameterNumbers(bool flush) {
+    unsigned long now = millis();
+    while (flush ? parameterNumbers.flush() : parameterNumbers.poll(now))
+        MIDIInputElementParameterNumber::updateAllWith(
+            parameterNumbers.getMessage());
 }
 
 void Control_Surface_::sendChannelMessageImpl(ChannelMessage msg) {
@@ -111,6 +122,8 @@ void Control_Surface_::sinkMIDIfromPipe(ChannelMessage midimsg) {
         DEBUG(F("Reset All Controllers"));
         MIDIInputElementCC::resetAll();
         MIDIInputElementCP::resetAll();
+        MIDIInputElementParameterNumber::resetAll();
+        parameterNumbers.reset(midimsg.getChannelCable());
     } else if (midimsg.getMessageType() == MIDIMessageType::CONTROL_CHANGE &&
                midimsg.getData1() == MIDI_CC::All_Notes_Off) {
         // All Notes Off
@@ -130,6 +143,18 @@ void Control_Surface_::sinkMIDIfromPipe(ChannelMessage midimsg) {
                 MIDIInputElementKP::updateAllWith(midimsg);
                 break;
             case MIDIMessageType::CONTROL_CHANGE:
+                if (parameterNumberAssembly) {
+                    using Result = ParameterNumberAssembler::Result;
+                    Result result = parameterNumbers.update(midimsg, millis());
+                    if (result == Result::Complete) {
+                        DEBUGFN(F("Updating (N)RPN elements with new "
+                                  "parameter value."));
+                        MIDIInputElementParameterNumber::updateAllWith(
+                            parameterNumbers.getMessage());
+                    }
+                    if (result != Result::Ignored)
+                        break;
+                }
                 DEBUGFN(F("Updating CC elements with new MIDI "
                           "message."));
                 MIDIInputElementCC::updateAllWith(midimsg);
@@ -224,6 +249,7 @@ void Control_Surface_::updateInputs() {
     MIDIInputElementCP::updateAll();
     MIDIInputElementPB::updateAll();
     MIDIInputElementSysEx::updateAll();
+    MIDIInputElementParameterNumber::updateAll();
 }
 
 void Control_Surface_::beginDisplays() {
@@ -256,28 +282,43 @@ void Control_Surface_::updateDisplays() {
     auto prevIt = it;
     auto previousDisplay = &prevIt->getDisplay();
     bool dirty = false;
+    DisplayRect area = DisplayRect::empty();
     // Loop over all display elements
     while (true) {
-        dirty |= it->getDirty();
+        if (it->getDirty()) {
+            dirty = true;
+            area = area.unite(it->getBounds());
+        }
         ++it;
         // If this is the first element on another display
         if (it == end || &it->getDisplay() != previousDisplay) {
             // If there was at least one element on the previous display that
             // has to be redrawn
             if (dirty) {
-                // Clear the display
-                previousDisplay->clearAndDrawBackground();
-                // Update all elements on that display
-                for (auto drawIt = prevIt; drawIt != it; ++drawIt)
-                    drawIt->draw();
-                // Write the buffer to the display
-                previousDisplay->display();
+                DisplayFrameStats stats;
+                stats.area = area;
+                stats.elementsDrawn = 0;
+                unsigned long start = micros();
+                // Clear the area that changed
+                previousDisplay->clearAndDrawBackground(area);
+                // Update all elements in that area
+                for (auto drawIt = prevIt; drawIt != it; ++drawIt) {
+                    if (area.intersects(drawIt->getBounds())) {
+                        drawIt->draw();
+                        ++stats.elementsDrawn;
+                    }
+                }
+                // Write the changed part of the buffer to the display
+                stats.bytesTransmitted = previousDisplay->displayArea(area);
+                stats.frameTime = micros() - start;
+                previousDisplay->setLastFrameStats(stats);
             }
             if (it == end)
                 break;
             prevIt = it;
             previousDisplay = &it->getDisplay();
             dirty = false;
+            area = DisplayRect::empty();
         }
     }
 }
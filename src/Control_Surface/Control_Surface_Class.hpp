@@ -8,6 +8,7 @@
 #include <Display/DisplayElement.hpp>
 #include <Display/DisplayInterface.hpp>
 #include <MIDI_Interfaces/MIDI_Interface.hpp>
+#include <MIDI_Parsers/ParameterNumberAssembler.hpp>
 #include <Settings/SettingsWrapper.hpp>
 
 BEGIN_CS_NAMESPACE
@@ -27,6 +28,7 @@ class Control_Surface_ : public MIDI_Sender<Control_Surface_>,
                          public TrueMIDI_SinkSource {
 
     friend class MIDI_Sender<Control_Surface_>;
+    friend struct StaticMIDI_RouterDetail::SinkAccess;
 
     /// @name Singleton boilerplate
     /// @{
@@ -66,8 +68,10 @@ class Control_Surface_ : public MIDI_Sender<Control_Surface_>,
     void updateInputs();
     /// Initialize all displays that have at least one display element.
     void beginDisplays();
-    /// Clear, draw and display all displays that contain display elements that
-    /// have changed.
+    /// Clear, draw and display the areas of all displays that contain display
+    /// elements that have changed.
+    /// @see    DisplayElement::getBounds
+    /// @see    DisplayInterface::getLastFrameStats
     void updateDisplays();
 
   private:
@@ -89,10 +93,40 @@ class Control_Surface_ : public MIDI_Sender<Control_Surface_>,
     void sinkMIDIfromPipe(SysCommonMessage msg) override;
     void sinkMIDIfromPipe(RealTimeMessage msg) override;
 
+    /// Dispatch the (N)RPN values whose Data Entry LSB timed out, or all
+    /// values that are still waiting for an LSB if `flush` is true.
+    void pollParameterNumbers(bool flush);
+
   private:
     /// A timer to know when to refresh the displays.
     Timer<micros> displayTimer = {1000000UL / MAX_FPS};
 
+  public:
+    /// @name (Non-)Registered Parameter Numbers
+    /// @{
+
+    /// Enable or disable the assembly of (N)RPN Control Change sequences.
+    /// When enabled, the Control Change messages that select and set a
+    /// parameter are no longer passed to the @ref MIDIInputElementCC%s, and
+    /// each complete value is passed to the
+    /// @ref MIDIInputElementParameterNumber%s instead.
+    /// @see    ParameterNumberAssembler
+    void setParameterNumberAssembly(bool enabled) {
+        if (!enabled) {
+            pollParameterNumbers(true);
+            parameterNumbers.resetAll();
+        }
+        parameterNumberAssembly = enabled;
+    }
+    /// Check whether (N)RPN assembly is enabled.
+    bool getParameterNumberAssembly() const { return parameterNumberAssembly; }
+
+    /// @}
+
+  private:
+    ParameterNumberAssembler parameterNumbers;
+    bool parameterNumberAssembly = false;
+
   public:
     /// @name MIDI Input Callbacks
     /// @{
@@ -91,6 +91,16 @@ class DisplayElement : public DoublyLinkable<DisplayElement> {
     /// Check if this DisplayElement has to be re-drawn.
     virtual bool getDirty() const = 0;
 
+    /**
+     * @brief   Get the area of the display that this element draws to.
+     * 
+     * When an element is dirty, only this area of the display is cleared and
+     * redrawn, together with the other elements that overlap with it.
+     * The default implementation returns @ref DisplayRect::everything, so the
+     * entire display is redrawn when this element changes.
+     */
+    virtual DisplayRect getBounds() const { return DisplayRect::everything(); }
+
     /// Get a reference to the display that this element draws to.
     DisplayInterface &getDisplay() { return display; }
     /// Get a const reference to the display that this element draws to.
@@ -1,13 +1,51 @@
 #include "DisplayInterface.hpp"
+#include <AH/Math/MinMaxFix.hpp>
 
 BEGIN_CS_NAMESPACE
 
+using AH::max;
+using AH::min;
+
 void DisplayInterface::begin() {
     clear();
     drawBackground();
     display();
 }
 
+DisplayRect DisplayRect::unite(const DisplayRect &other) const {
+    if (other.isEmpty())
+        return *this;
+    if (this->isEmpty())
+        return other;
+    int32_t x0 = min(int32_t(x), int32_t(other.x));
+    int32_t y0 = min(int32_t(y), int32_t(other.y));
+    int32_t x1 = max(int32_t(x) + w, int32_t(other.x) + other.w);
+    int32_t y1 = max(int32_t(y) + h, int32_t(other.y) + other.h);
+    return {
+        int16_t(x0),
+        int16_t(y0),
+        int16_t(min(x1 - x0, int32_t(INT16_MAX))),
+        int16_t(min(y1 - y0, int32_t(INT16_MAX))),
+    };
+}
+
+DisplayRect DisplayRect::clip(int16_t width, int16_t height) const {
+    int32_t x0 = max(int32_t(x), int32_t(0));
+    int32_t y0 = max(int32_t(y), int32_t(0));
+    int32_t x1 = min(int32_t(x) + w, int32_t(width));
+    int32_t y1 = min(int32_t(y) + h, int32_t(height));
+    if (x1 <= x0 || y1 <= y0)
+        return empty();
+    return {int16_t(x0), int16_t(y0), int16_t(x1 - x0), int16_t(y1 - y0)};
+}
+
+void DisplayInterface::clearArea(const DisplayRect &area) {
+    if (area.isEverything())
+        clear();
+    else if (!area.isEmpty())
+        fillRect(area.x, area.y, area.w, area.h, 0);
+}
+
 void DisplayInterface::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                 uint16_t color) {
     for (int16_t r = y; r < y + h; r++)
@@ -6,6 +6,61 @@
 
 BEGIN_CS_NAMESPACE
 
+/// A rectangular area of a display, in pixels.
+struct DisplayRect {
+    int16_t x; ///< The x coordinate of the top-left corner.
+    int16_t y; ///< The y coordinate of the top-left corner.
+    int16_t w; ///< The width of the area.
+    int16_t h; ///< The height of the area.
+
+    /// An area that doesn't contain any pixels.
+    static DisplayRect empty() { return {0, 0, 0, 0}; }
+    /// An area that covers the entire display, regardless of its size.
+    static DisplayRect everything() {
+        return {-everythingOffset, -everythingOffset, INT16_MAX, INT16_MAX};
+    }
+
+    /// Check whether this area doesn't contain any pixels.
+    bool isEmpty() const { return w <= 0 || h <= 0; }
+    /// Check whether this area covers the entire display.
+    bool isEverything() const {
+        return x <= -everythingOffset && y <= -everythingOffset &&
+               w == INT16_MAX && h == INT16_MAX;
+    }
+
+    /// Check whether this area has any pixels in common with the given area.
+    bool intersects(const DisplayRect &other) const {
+        return !isEmpty() && !other.isEmpty() &&                        //
+               int32_t(x) < int32_t(other.x) + other.w &&               //
+               int32_t(other.x) < int32_t(x) + w &&                     //
+               int32_t(y) < int32_t(other.y) + other.h &&               //
+               int32_t(other.y) < int32_t(y) + h;
+    }
+
+    /// Get the smallest area that contains both this area and the given area.
+    DisplayRect unite(const DisplayRect &other) const;
+
+    /// Get the part of this area that lies within a display of the given size.
+    DisplayRect clip(int16_t width, int16_t height) const;
+
+  private:
+    constexpr static int16_t everythingOffset = INT16_MAX / 2;
+};
+
+/// Statistics about the last frame that was drawn to a display.
+/// @see    DisplayInterface::getLastFrameStats
+struct DisplayFrameStats {
+    /// The area of the display that was redrawn.
+    DisplayRect area;
+    /// The time it took to draw and transmit the frame, in microseconds.
+    unsigned long frameTime;
+    /// The number of bytes of pixel data sent to the display, or zero if the
+    /// display doesn't report it.
+    size_t bytesTransmitted;
+    /// The number of display elements that were drawn.
+    uint16_t elementsDrawn;
+};
+
 /**
  * @brief   An interface for displays. 
  * 
@@ -30,6 +85,49 @@ class DisplayInterface : public Print {
     /// this function empty.
     virtual void display() = 0;
 
+    /// @name Partial redraws
+    /// @{
+
+    /// Clear the given area of the frame buffer. By default, the area is
+    /// filled with color 0.
+    virtual void clearArea(const DisplayRect &area);
+    /// Draw the part of the custom background that lies within the given
+    /// area. By default, the entire background is drawn, which is fine as long
+    /// as the display elements never draw over the background using color 0.
+    virtual void drawBackgroundArea(const DisplayRect &area) {
+        (void)area;
+        drawBackground();
+    }
+    /**
+     * @brief   Write the given area of the frame buffer to the display.
+     * 
+     * By default, the entire frame buffer is written using @ref display.
+     * Displays that support partial updates can override this function to
+     * only transmit the pages/columns that overlap with the given area.
+     * 
+     * @param   area
+     *          The area of the display that changed.
+     * @return  The number of bytes of pixel data that were sent to the display,
+     *          or zero if unknown.
+     */
+    virtual size_t displayArea(const DisplayRect &area) {
+        (void)area;
+        display();
+        return 0;
+    }
+
+    /// Get statistics about the last frame that was drawn to this display.
+    const DisplayFrameStats &getLastFrameStats() const {
+        return lastFrameStats;
+    }
+    /// Store the statistics about the frame that was just drawn. Called by
+    /// @ref Control_Surface_::updateDisplays.
+    void setLastFrameStats(const DisplayFrameStats &stats) {
+        lastFrameStats = stats;
+    }
+
+    /// @}
+
     /// Paint a single pixel with the given color.
     virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
 
@@ -82,6 +180,20 @@ class DisplayInterface : public Print {
         clear();
         drawBackground();
     }
+
+    /**
+     * @brief   Clear the given area of the frame buffer, and draw the custom 
+     *          background in it.
+     * @see    clearArea
+     * @see    drawBackgroundArea
+     */
+    void clearAndDrawBackground(const DisplayRect &area) {
+        clearArea(area);
+        drawBackgroundArea(area);
+    }
+
+  private:
+    DisplayFrameStats lastFrameStats = {DisplayRect::empty(), 0, 0, 0};
 };
 
 END_CS_NAMESPACE
\ No newline at end of file
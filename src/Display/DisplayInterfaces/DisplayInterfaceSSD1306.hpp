@@ -1,7 +1,9 @@
 #pragma once
 
+#include <AH/Error/Error.hpp>
 #include <Adafruit_SSD1306.h>
 #include <Display/DisplayInterface.hpp>
+#include <string.h> // memcpy
 
 BEGIN_CS_NAMESPACE
 
@@ -24,6 +26,22 @@ class SSD1306_DisplayInterface : public DisplayInterface {
     /// this function empty.
     void display() override { disp.display(); }
 
+    /// Clear the given area of the frame buffer.
+    void clearArea(const DisplayRect &area) override {
+        DisplayRect clipped = area.clip(disp.width(), disp.height());
+        if (clipped.w == disp.width() && clipped.h == disp.height())
+            disp.clearDisplay();
+        else if (!clipped.isEmpty())
+            disp.fillRect(clipped.x, clipped.y, clipped.w, clipped.h, BLACK);
+    }
+    /// Write the frame buffer to the display, and return the number of bytes
+    /// of pixel data that were sent.
+    size_t displayArea(const DisplayRect &area) override {
+        (void)area;
+        disp.display();
+        return size_t(disp.width()) * ((disp.height() + 7) / 8);
+    }
+
     /// Paint a single pixel with the given color.
     void drawPixel(int16_t x, int16_t y, uint16_t color) override {
         disp.drawPixel(x, y, color);
@@ -71,4 +89,210 @@ class SSD1306_DisplayInterface : public DisplayInterface {
     Adafruit_SSD1306 &disp;
 };
 
+/// Statistics about the last frame buffer transfer of a
+/// @ref SSD1306_PageDiffDisplayInterface.
+struct SSD1306_TransferStats {
+    /// The number of 8-pixel pages that contained changes.
+    uint8_t dirtyPages;
+    /// The number of column spans that were sent.
+    uint8_t spans;
+    /// The number of bytes of pixel data that were sent.
+    uint16_t bytes;
+    /// Whether the entire frame buffer was sent.
+    bool fullFrame;
+};
+
+/**
+ * @brief   SSD1306 display interface that only transmits the parts of the
+ *          frame buffer that changed since the previous frame.
+ * 
+ * A shadow copy of the data that was last sent to the display is kept in RAM.
+ * When displaying a new frame, each 8-pixel page of the frame buffer is
+ * compared to the shadow copy, and only the spans of columns that changed are
+ * sent, using the SSD1306 page and column address commands. Changed columns
+ * that are separated by fewer than @ref MergeGap unchanged columns are sent as
+ * a single span, because addressing a new span costs about as much as sending
+ * that many columns.
+ * 
+ * The Adafruit library doesn't provide a way to send part of the frame buffer,
+ * so you have to implement @ref sendSpan yourself, for example using the
+ * @ref sendSpanI2C helper. If @ref sendSpan is not implemented, the entire
+ * frame buffer is sent whenever anything changed.
+ * 
+ * @tparam  Width
+ *          The width of the display in pixels (without rotation).
+ * @tparam  Height
+ *          The height of the display in pixels (without rotation).
+ */
+template <uint8_t Width = 128, uint8_t Height = 64>
+class SSD1306_PageDiffDisplayInterface : public SSD1306_DisplayInterface {
+  protected:
+    SSD1306_PageDiffDisplayInterface(Adafruit_SSD1306 &display)
+        : SSD1306_DisplayInterface(display) {}
+
+  public:
+    /// Initialize the display, and send the entire frame buffer.
+    void begin() override {
+        if (int32_t(disp.width()) * disp.height() != int32_t(Width) * Height)
+            ERROR(F("Error: SSD1306 size doesn't match the template arguments"),
+                  0x9214);
+        SSD1306_DisplayInterface::begin();
+    }
+
+    /// Write the entire frame buffer to the display.
+    void display() override { displayAll(); }
+
+    /// Write the parts of the frame buffer that changed to the display.
+    /// @see    displayChanges
+    size_t displayArea(const DisplayRect &area) override {
+        (void)area;
+        return displayChanges();
+    }
+
+    /**
+     * @brief   Compare the frame buffer to the data that was sent previously,
+     *          and send only the column spans that changed.
+     * 
+     * @return  The number of bytes of pixel data that were sent.
+     */
+    size_t displayChanges() {
+        if (!shadowValid)
+            return displayAll();
+        const uint8_t *buffer = disp.getBuffer();
+        stats.dirtyPages = 0;
+        stats.spans = 0;
+        stats.bytes = 0;
+        stats.fullFrame = false;
+        for (uint8_t page = 0; page < Pages; ++page) {
+            const uint8_t *row = buffer + page * Width;
+            uint8_t *shadowRow = shadow + page * Width;
+            bool dirty = false;
+            uint16_t col = 0;
+            while (col < Width) {
+                if (row[col] == shadowRow[col]) {
+                    ++col;
+                    continue;
+                }
+                // Extend the span as long as the gaps are small
+                uint16_t last = col;
+                for (uint16_t c = col + 1; c < Width && c - last <= MergeGap;
+                     ++c)
+                    if (row[c] != shadowRow[c])
+                        last = c;
+                uint8_t numColumns = last - col + 1;
+                if (!sendSpan(page, col, numColumns, row + col))
+                    return displayAll();
+                memcpy(shadowRow + col, row + col, numColumns);
+                stats.spans++;
+                stats.bytes += numColumns;
+                dirty = true;
+                col = last + 1;
+            }
+            stats.dirtyPages += dirty;
+        }
+        return stats.bytes;
+    }
+
+    /// Force the next frame to send the entire frame buffer, e.g. after the
+    /// display was reset or written to directly.
+    void invalidate() { shadowValid = false; }
+
+    /// Get the statistics about the last transfer.
+    const SSD1306_TransferStats &getTransferStats() const { return stats; }
+
+    /// The number of 8-pixel pages of the display.
+    constexpr static uint8_t Pages = (Height + 7) / 8;
+    /// The maximum number of unchanged columns between two changed columns
+    /// for them to be merged into a single span.
+    constexpr static uint8_t MergeGap = 6;
+
+  protected:
+    /**
+     * @brief   Send a span of columns within a single page to the display.
+     * 
+     * @param   page
+     *          The index of the 8-pixel page.
+     * @param   firstColumn
+     *          The index of the first column to send.
+     * @param   numColumns
+     *          The number of columns to send.
+     * @param   data
+     *          The frame buffer data of these columns.
+     * @retval  true
+     *          The data was sent.
+     * @retval  false
+     *          Partial transfers are not supported, the entire frame buffer
+     *          will be sent instead.
+     */
+    virtual bool sendSpan(uint8_t page, uint8_t firstColumn,
+                          uint8_t numColumns, const uint8_t *data) {
+        (void)page, (void)firstColumn, (void)numColumns, (void)data;
+        return false;
+    }
+
+    /**
+     * @brief   Implementation of @ref sendSpan for displays connected over
+     *          I²C.
+     * 
+     * Sets the page and column address window, and sends the data in chunks
+     * that fit in the I²C buffer.
+     * 
+     * @param   wire
+     *          The I²C interface the display is connected to (e.g. `Wire`).
+     * @param   address
+     *          The I²C address of the display.
+     * @param   page
+     *          The index of the 8-pixel page.
+     * @param   firstColumn
+     *          The index of the first column to send.
+     * @param   numColumns
+     *          The number of columns to send.
+     * @param   data
+     *          The frame buffer data of these columns.
+     */
+    template <class WireType>
+    bool sendSpanI2C(WireType &wire, uint8_t address, uint8_t page,
+                     uint8_t firstColumn, uint8_t numColumns,
+                     const uint8_t *data) {
+        disp.ssd1306_command(SSD1306_PAGEADDR);
+        disp.ssd1306_command(page);
+        disp.ssd1306_command(page);
+        disp.ssd1306_command(SSD1306_COLUMNADDR);
+        disp.ssd1306_command(firstColumn);
+        disp.ssd1306_command(firstColumn + numColumns - 1);
+        while (numColumns > 0) {
+            uint8_t chunk = numColumns < I2CChunkSize ? numColumns //
+                                                      : I2CChunkSize;
+            const uint8_t control = 0x40; // Co = 0, D/C# = 1
+            wire.beginTransmission(address);
+            wire.write(&control, 1);
+            wire.write(data, chunk);
+            wire.endTransmission();
+            data += chunk;
+            numColumns -= chunk;
+        }
+        return true;
+    }
+
+    /// The maximum number of data bytes per I²C transmission (the Arduino
+    /// Wire buffer is 32 bytes, including the control byte).
+    constexpr static uint8_t I2CChunkSize = 31;
+
+  private:
+    size_t displayAll() {
+        SSD1306_DisplayInterface::display();
+        memcpy(shadow, disp.getBuffer(), sizeof(shadow));
+        shadowValid = true;
+        stats.dirtyPages = Pages;
+        stats.spans = 0;
+        stats.bytes = sizeof(shadow);
+        stats.fullFrame = true;
+        return sizeof(shadow);
+    }
+
+    uint8_t shadow[Width * Pages];
+    bool shadowValid = false;
+    SSD1306_TransferStats stats = {0, 0, 0, false};
+};
+
 END_CS_NAMESPACE
\ No newline at end of file
@@ -35,6 +35,11 @@ class VPotDisplay : public DisplayElement {
 
     bool getDirty() const override { return vpot.getDirty(); }
 
+    DisplayRect getBounds() const override {
+        return {int16_t(x - radius), int16_t(y - radius),
+                int16_t(2 * radius + 1), int16_t(2 * radius + 1)};
+    }
+
     void setAngleSpacing(float spacing) { this->angleSpacing = spacing; }
     float getAngleSpacing() const { return this->angleSpacing; }
 
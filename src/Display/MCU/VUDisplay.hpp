@@ -3,14 +3,23 @@
 #include <AH/STL/utility> // std::forward
 #include <Display/DisplayElement.hpp>
 #include <MIDI_Inputs/InterfaceMIDIInputElements.hpp>
+#include <MIDI_Inputs/MCU/VUDecayScheduler.hpp>
 #include <Settings/SettingsWrapper.hpp>
 
 BEGIN_CS_NAMESPACE
 
 namespace MCU {
 
+/**
+ * @brief   Displays a Mackie Control Universal VU meter as a bar graph with a
+ *          peak indicator.
+ *
+ * The peak bar holds for @ref VU_PEAK_HOLD_TIME and then decays, driven by the
+ * shared @ref VUDecayScheduler, so the display is only marked dirty when the
+ * peak bar actually moves.
+ */
 template <class VU_t = Interfaces::MCU::IVU &>
-class VUDisplay : public DisplayElement {
+class VUDisplay : public DisplayElement, public VUDecayTimer {
   public:
     VUDisplay(DisplayInterface &display, VU_t &&vu, PixelLocation loc,
               uint16_t width, uint8_t blockheight, uint8_t spacing,
@@ -30,10 +39,19 @@ class VUDisplay : public DisplayElement {
             drawBlocks(value);
         }
         vu.clearDirty();
+        peakDirty = false;
     }
 
-    bool getDirty() const override {
-        return vu.getDirty() || shouldStartDecaying() || shouldUpdateDecay();
+    bool getDirty() const override { return vu.getDirty() || peakDirty; }
+
+    DisplayRect getBounds() const override {
+        int16_t maxPeak = int16_t(vu.getMax()) * (blockheight + spacing);
+        return {
+            x,
+            int16_t(y + blockheight - spacing - maxPeak),
+            int16_t(width),
+            int16_t(spacing + maxPeak),
+        };
     }
 
   protected:
@@ -53,32 +71,33 @@ class VUDisplay : public DisplayElement {
                              color);
     }
 
+    /// Lower the peak bar by one step, until it reaches the current value.
+    void onDecayTimer(unsigned long deadline) override {
+        int16_t newPeak = (int16_t)vu.getValue() * (blockheight + spacing);
+        peak -= VU_PEAK_SMOOTH_DECAY ? 1 : (blockheight + spacing);
+        if (peak > newPeak)
+            scheduleDecay(deadline, decayTime);
+        else
+            peak = newPeak;
+        peakDirty = true;
+    }
+
   private:
     void updatePeak(uint8_t value) {
         int16_t newPeak = (int16_t)value * (blockheight + spacing);
         if (newPeak >= peak) {
             peak = newPeak;
-            previousDecay = millis();
-            decaying = false;
-        } else if (shouldStartDecaying()) {
-            decaying = true;
-            previousDecay += VU_PEAK_HOLD_TIME - decayTime;
-        } else if (shouldUpdateDecay()) {
-            peak -= VU_PEAK_SMOOTH_DECAY ? 1 : (blockheight + spacing);
-            previousDecay += decayTime;
+            // Hold the new peak
+            if (peak > 0)
+                scheduleDecay(millis(), VU_PEAK_HOLD_TIME);
+            else
+                cancelDecay();
+        } else if (!isDecayScheduled()) {
+            // The peak was resting on top of the bar, and the value dropped
+            scheduleDecay(millis(), decayTime);
         }
     }
 
-    bool shouldStartDecaying() const {
-        return !decaying && peak > 0 &&
-               (millis() - previousDecay > VU_PEAK_HOLD_TIME);
-    }
-
-    bool shouldUpdateDecay() const {
-        return decaying && peak > 0 && //
-               (millis() - previousDecay > decayTime);
-    }
-
     VU_t vu;
 
     int16_t x;
@@ -89,8 +108,7 @@ class VUDisplay : public DisplayElement {
     uint16_t color;
 
     int16_t peak = 0;
-    unsigned long previousDecay = 0;
-    bool decaying = false;
+    bool peakDirty = false;
 
     unsigned long decayTime;
 };
@@ -132,6 +150,12 @@ class AnalogVUDisplay : public DisplayElement {
 
     bool getDirty() const override { return vu.getDirty(); }
 
+    DisplayRect getBounds() const override {
+        int16_t r = int16_t(sqrtf(r_sq)) + 1;
+        return {int16_t(x - r), int16_t(y - r), int16_t(2 * r + 1),
+                int16_t(2 * r + 1)};
+    }
+
   private:
     VU_t &vu;
 
@@ -226,6 +226,46 @@ uint8_t getRangeIndex(MIDIAddress tgt, MIDIAddress base,
                : tgt.getAddress() - base.getAddress();
 }
 
+/**
+ * @brief   Call the given function for each MIDI address in a range of the
+ *          given length, for each bank setting.
+ * 
+ * The result is a superset of all addresses that are matched by
+ * @ref matchBankableInRange, it is used to build a dispatch index.
+ * 
+ * @param   base
+ *          The base address (beginning of the range for bank setting 0).
+ * @param   config
+ *          The bank configuration.
+ * @param   length
+ *          The length of the range.
+ * @param   callback
+ *          The function to call with each address.
+ */
+template <uint8_t BankSize, class Callback>
+void forEachBankableAddress(MIDIAddress base, BaseBankConfig<BankSize> config,
+                            uint8_t length, Callback &callback) {
+    const int B = config.bank.getTracksPerBank();
+    const int F = config.bank.getSelectionOffset();
+    for (setting_t s = 0; s < BankSize; ++s) {
+        int offset = (s + F) * B;
+        for (uint8_t r = 0; r < length; ++r) {
+            switch (config.type) {
+                case BankType::CHANGE_ADDRESS:
+                    callback(base + RelativeMIDIAddress {offset + r});
+                    break;
+                case BankType::CHANGE_CHANNEL:
+                    callback(base + RelativeMIDIAddress {r, offset});
+                    break;
+                case BankType::CHANGE_CABLENB:
+                    callback(base + RelativeMIDIAddress {r, 0, offset});
+                    break;
+                default: break; // LCOV_EXCL_LINE
+            }
+        }
+    }
+}
+
 } // namespace BankableMIDIMatcherHelpers
 
 END_CS_NAMESPACE
\ No newline at end of file
@@ -105,8 +105,9 @@ class VULEDs : public VU, public VULEDsDriver<NumLEDs> {
         updateDisplay();
     }
 
-    void update() override {
-        bool newdirty = Parent::decay();
+  protected:
+    void onDecayTimer(unsigned long deadline) override {
+        bool newdirty = Parent::decay(deadline);
         if (newdirty)
             updateDisplay();
         this->dirty |= newdirty;
@@ -201,14 +202,14 @@ class VULEDs : public VU<BankSize>, public VULEDsDriver<NumLEDs> {
         updateDisplay();
     }
 
-    void update() override {
-        bool newdirty = Parent::decay();
+  protected:
+    void onDecayTimer(unsigned long deadline) override {
+        bool newdirty = Parent::decay(deadline);
         if (newdirty)
             updateDisplay();
         this->dirty |= newdirty;
     }
 
-  protected:
     void onBankSettingChange() override {
         Parent::onBankSettingChange();
         updateDisplay();
@@ -45,6 +45,11 @@ class LCDCounter {
  * 
  * The manufacturer ID and model number are ignored by this class.
  * 
+ * Messages that arrive in multiple chunks (because they're longer than
+ * @ref SYSEX_BUFFER_SIZE) are handled incrementally: the header is parsed from
+ * the first chunk, and the text of each chunk is written to the buffer as soon
+ * as it arrives.
+ * 
  * @ingroup MIDIInputElements
  */
 template <uint8_t BufferSize = 112>
@@ -74,59 +79,85 @@ class LCD : public MIDIInputElementSysEx, private LCDCounter {
         if (midimsg.getCable() != this->cable)
             return false;
 
-        // We can't handle chunked SysEx data (yet), and it wouldn't make a ton
-        // of sense, since the default SysEx buffer size is the same size as the 
-        // SysEx message we expect, so it shouldn't arrive in chunks.
-        if (!midimsg.isCompleteMessage()) 
+        // Long messages may arrive in multiple chunks. The first chunk starts
+        // a new message, following chunks continue where the previous one
+        // left off. Chunks of a message whose start we missed, or of a
+        // message that turned out not to be an LCD message, are ignored.
+        if (midimsg.isFirstChunk())
+            position = 0;
+        else if (position == NotReceiving)
             return false;
 
+        const uint8_t *data = midimsg.data;
+        const uint8_t *end = midimsg.data + midimsg.length;
+        if (midimsg.isLastChunk())
+            --end; // Don't treat the SysEx End byte as text
+
         // Format:
         // F0 mm mm mm nn 12 oo yy... F7
         // mm = manufacturer ID (00 00 66 for Mackie)
         // nn = model number (10 for Logic Control, 11 for Logic Control XT)
         // oo = offset [0x00, 0x6F]
         // yy... = ASCII data
-        if (midimsg.data[5] != 0x12)
-            return false;
+        // The header may be split over multiple chunks as well.
+        while (position < HeaderSize && data < end) {
+            if (position == 5 && *data != 0x12) {
+                position = NotReceiving;
+                return false;
+            }
+            if (position == 6)
+                midiOffset = *data;
+            ++position;
+            ++data;
+        }
 
-        const uint8_t midiOffset = midimsg.data[6];
-        const uint8_t midiLength = midimsg.length - 8;
-        const uint8_t *text = midimsg.data + 7;
-        const uint8_t midiBufferEnd = midiOffset + midiLength;
+        // Copy the text in this chunk to our buffer:
+        uint16_t textLength = end - data;
+        if (position >= HeaderSize && textLength > 0) {
+            copyText(midiOffset + (position - HeaderSize), data, textLength);
+            position += textLength;
+        }
+        // We only know that this is an LCD message once we have seen byte 5:
+        bool match = position > 5;
+        if (midimsg.isLastChunk())
+            position = NotReceiving;
+
+        // If this is the only instance, the others don't have to be updated
+        // anymore, so we return true to break the loop:
+        return match && getInstances() == 1;
+    }
 
-        const uint8_t bufferEnd = this->offset + BufferSize;
+  private:
+    /// Copy the `length` characters of text starting at position `midiStart`
+    /// of the MIDI text to the part of the buffer that overlaps with it.
+    void copyText(uint16_t midiStart, const uint8_t *text, uint16_t length) {
+        const uint16_t midiEnd = midiStart + length;
+        const uint16_t bufferEnd = this->offset + BufferSize;
 
         // If there's no overlap between incoming range and the range that we're
         // listening for, return:
-        if (midiOffset >= bufferEnd || this->offset >= midiBufferEnd)
-            // If there are other instances, maybe it'll match one of those,
-            // otherwise, stop handling this message:
-            return getInstances() == 1;
+        if (midiStart >= bufferEnd || this->offset >= midiEnd)
+            return;
 
         // Find the ranges that overlap between the text data in the message
         // (src) and the range of characters we're listening for (dst):
-        uint8_t srcStart = max(0, this->offset - midiOffset);
-        uint8_t dstStart = max(0, midiOffset - this->offset);
-        uint8_t length = midiBufferEnd - midiOffset -
-                         max(0, this->offset - midiOffset) -
-                         max(0, midiBufferEnd - bufferEnd);
+        uint16_t start = max(midiStart, uint16_t(this->offset));
+        uint16_t srcStart = start - midiStart;
+        uint16_t dstStart = start - this->offset;
+        uint16_t copyLength = min(midiEnd, bufferEnd) - start;
 
         // Copy the interesting part to our buffer:
 #ifdef ARDUINO
-        memcpy(&buffer[dstStart], &text[srcStart], length);
+        memcpy(&buffer[dstStart], &text[srcStart], copyLength);
 #else // Tests
-        for (uint8_t i = 0; i < length; ++i) {
+        for (uint16_t i = 0; i < copyLength; ++i) {
             buffer[dstStart + i] = text[srcStart + i];
             assert(dstStart + i < BufferSize);
-            assert(srcStart + i < midiLength);
+            assert(srcStart + i < length);
         }
 #endif
 
         dirty = true;
-
-        // If this is the only instance, the others don't have to be updated
-        // anymore, so we return true to break the loop:
-        return getInstances() == 1;
     }
 
   public:
@@ -150,10 +181,19 @@ class LCD : public MIDIInputElementSysEx, private LCDCounter {
     /// @}
 
   private:
+    /// The length of the header, up to and including the offset byte.
+    constexpr static uint16_t HeaderSize = 7;
+    /// Value of @ref position when we're not receiving an LCD message.
+    constexpr static uint16_t NotReceiving = 0xFFFF;
+
     Array<char, BufferSize + 1> buffer;
     uint8_t offset;
     Cable cable;
     bool dirty = true;
+    /// Index of the next byte in the (possibly chunked) incoming message.
+    uint16_t position = NotReceiving;
+    /// Offset of the incoming text, from the header of the message.
+    uint8_t midiOffset = 0;
 };
 
 } // namespace MCU
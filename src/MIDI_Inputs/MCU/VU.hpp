@@ -1,7 +1,7 @@
 #pragma once
 
-#include <AH/Timing/MillisMicrosTimer.hpp>
 #include <MIDI_Inputs/InterfaceMIDIInputElements.hpp>
+#include <MIDI_Inputs/MCU/VUDecayScheduler.hpp>
 #include <MIDI_Inputs/MIDIInputElementMatchers.hpp>
 
 BEGIN_CS_NAMESPACE
@@ -183,11 +183,15 @@ constexpr unsigned int Default = 150;
  * @brief   A MIDI input element that represents a Mackie Control Universal VU
  *          meter.
  * 
+ * The decay is driven by the shared @ref VUDecayScheduler, a meter that is at
+ * zero doesn't use any processing time.
+ * 
  * @ingroup MIDIInputElements
  */
 class VU : public MatchingMIDIInputElement<MIDIMessageType::CHANNEL_PRESSURE,
                                            VUMatcher>,
-           public Interfaces::MCU::IVU {
+           public Interfaces::MCU::IVU,
+           public VUDecayTimer {
   public:
     using Matcher = VUMatcher;
     using Parent = MatchingMIDIInputElement<MIDIMessageType::CHANNEL_PRESSURE,
@@ -213,7 +217,7 @@ class VU : public MatchingMIDIInputElement<MIDIMessageType::CHANNEL_PRESSURE,
     VU(uint8_t track, MIDIChannelCable channelCN,
        unsigned int decayTime = VUDecay::Default)
         : Parent({{track - 1, channelCN}}),
-          IVU(12), decayTimer(decayTime) {}
+          IVU(12), decayTime(decayTime) {}
 
     /**
      * @brief   Constructor.
@@ -236,9 +240,13 @@ class VU : public MatchingMIDIInputElement<MIDIMessageType::CHANNEL_PRESSURE,
   protected:
     bool handleUpdateImpl(typename Matcher::Result match) {
         auto changed = state.update(match.data);
-        if (changed == VUState::ValueChanged)
+        if (changed == VUState::ValueChanged) {
             // reset the timer and fire after one interval
-            decayTimer.beginNextPeriod();
+            if (decayTime != VUDecay::Hold && state.value > 0)
+                scheduleDecay(millis(), decayTime);
+            else
+                cancelDecay();
+        }
         return changed;
     }
 
@@ -246,19 +254,24 @@ class VU : public MatchingMIDIInputElement<MIDIMessageType::CHANNEL_PRESSURE,
         dirty |= handleUpdateImpl(match);
     }
 
-    bool decay() {
-        return decayTimer.getInterval() != VUDecay::Hold && 
-               decayTimer &&
-               state.decay();
+    /// Decay the VU meter by one step, and schedule the next step if the
+    /// meter isn't at zero yet.
+    bool decay(unsigned long deadline) {
+        bool newdirty = state.decay();
+        if (state.value > 0)
+            scheduleDecay(deadline, decayTime);
+        return newdirty;
+    }
+
+    void onDecayTimer(unsigned long deadline) override {
+        dirty |= decay(deadline);
     }
 
   public:
     /// Reset all values to zero.
-    void reset() override { state = {}; }
-
-    /// Decay the VU meter.
-    void update() override {
-        dirty |= decay();
+    void reset() override {
+        state = {};
+        cancelDecay();
     }
 
   public:
@@ -274,7 +287,7 @@ class VU : public MatchingMIDIInputElement<MIDIMessageType::CHANNEL_PRESSURE,
 
   private:
     VUState state = {};
-    AH::Timer<millis> decayTimer;
+    unsigned int decayTime;
 };
 
 // -------------------------------------------------------------------------- //
@@ -294,7 +307,8 @@ template <uint8_t BankSize>
 class VU
     : public BankableMatchingMIDIInputElement<MIDIMessageType::CHANNEL_PRESSURE,
                                               BankableVUMatcher<BankSize>>,
-      public Interfaces::MCU::IVU {
+      public Interfaces::MCU::IVU,
+      public VUDecayTimer {
   public:
     using Matcher = BankableVUMatcher<BankSize>;
     using Parent
@@ -324,7 +338,7 @@ class VU
     VU(BankConfig<BankSize> config, uint8_t track, MIDIChannelCable channelCN,
        unsigned int decayTime = VUDecay::Default)
         : Parent({config, {track - 1, channelCN}}),
-          IVU(12), decayTimer(decayTime) {}
+          IVU(12), decayTime(decayTime) {}
 
     /**
      * @brief   Constructor.
@@ -350,13 +364,20 @@ class VU
   protected:
     bool handleUpdateImpl(typename Matcher::Result match) {
         auto changed = states[match.bankIndex].update(match.data);
-        if (changed == VUState::ValueChanged &&
-            match.bankIndex == this->getActiveBank())
-            // Only care about active bank's decay.
-            // Other banks will decay as well, but not as precisely.
-            // They aren't visible anyway, so it's a good compromise.
-            decayTimer.beginNextPeriod();
-        return changed && match.bankIndex == this->getActiveBank();
+        bool active = match.bankIndex == this->getActiveBank();
+        if (changed == VUState::ValueChanged && decayTime != VUDecay::Hold) {
+            if (active)
+                // Only care about active bank's decay.
+                // Other banks will decay as well, but not as precisely.
+                // They aren't visible anyway, so it's a good compromise.
+                scheduleDecay(millis(), decayTime);
+            else if (!isDecayScheduled() && match.data > 0)
+                // Don't read the time for banks that aren't visible, unless
+                // the wheel is idle and its time is out of date.
+                scheduleDecay(VUDecayScheduler::getInstance().getRecentTime(),
+                              decayTime);
+        }
+        return changed && active;
         // Only mark dirty if the value of the active bank changed
     }
 
@@ -364,27 +385,33 @@ class VU
         dirty |= handleUpdateImpl(match);
     }
 
-    bool decay() {
+    /// Decay all banks by one step, and schedule the next step if any of them
+    /// isn't at zero yet.
+    bool decay(unsigned long deadline) {
         bool newdirty = false;
-        if (decayTimer.getInterval() != VUDecay::Hold && decayTimer)
-            for (uint8_t i = 0; i < BankSize; ++i)
-                newdirty |= states[i].decay() && i == this->getActiveBank();
+        bool nonzero = false;
+        for (uint8_t i = 0; i < BankSize; ++i) {
+            newdirty |= states[i].decay() && i == this->getActiveBank();
+            nonzero |= states[i].value > 0;
+        }
+        if (nonzero)
+            scheduleDecay(deadline, decayTime);
         // Only mark dirty if the value of the active bank decayed
         return newdirty;
     }
 
+    void onDecayTimer(unsigned long deadline) override {
+        dirty |= decay(deadline);
+    }
+
   public:
     /// Reset all values to zero.
     void reset() override {
         states = {{}};
+        cancelDecay();
         dirty = true;
     }
 
-    /// Decay the VU meter.
-    void update() override {
-        dirty |= decay();
-    }
-
   protected:
     void onBankSettingChange() override { dirty = true; }
 
@@ -412,7 +439,7 @@ class VU
 
   private:
     AH::Array<VUState, BankSize> states = {{}};
-    AH::Timer<millis> decayTimer;
+    unsigned int decayTime;
 };
 
 } // namespace Bankable
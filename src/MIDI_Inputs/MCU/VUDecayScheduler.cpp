@@ -0,0 +1,77 @@
+#include "VUDecayScheduler.hpp"
+
+BEGIN_CS_NAMESPACE
+
+namespace MCU {
+
+VUDecayTimer::~VUDecayTimer() { cancelDecay(); }
+
+VUDecayScheduler &VUDecayScheduler::getInstance() {
+    static VUDecayScheduler instance;
+    return instance;
+}
+
+void VUDecayScheduler::schedule(VUDecayTimer &timer, unsigned long start,
+                                unsigned long delay) {
+    if (timer.scheduled)
+        cancel(timer);
+    // When the wheel is idle, its position is arbitrary, so start the current
+    // slot at the given time.
+    if (pending == 0)
+        wheelTime = time = start;
+    timer.deadline = start + delay;
+    long offset = static_cast<long>(timer.deadline - wheelTime);
+    unsigned long ticks = offset > 0 ? offset / Resolution : 0;
+    timer.slot = (currentSlot + ticks) % Slots;
+    timer.scheduled = true;
+    slots[timer.slot].append(timer);
+    ++pending;
+}
+
+void VUDecayScheduler::cancel(VUDecayTimer &timer) {
+    if (!timer.scheduled)
+        return;
+    slots[timer.slot].remove(timer);
+    timer.scheduled = false;
+    --pending;
+}
+
+void VUDecayScheduler::collectExpired(DoublyLinkedList<VUDecayTimer> &slot,
+                                      unsigned long now,
+                                      DoublyLinkedList<VUDecayTimer> &expired) {
+    VUDecayTimer *timer = slot.getFirst();
+    while (timer != nullptr) {
+        VUDecayTimer *next = timer->next;
+        if (static_cast<long>(now - timer->deadline) >= 0) {
+            slot.remove(timer);
+            timer->scheduled = false;
+            --pending;
+            expired.append(timer);
+        }
+        timer = next;
+    }
+}
+
+void VUDecayScheduler::advance(unsigned long now) {
+    time = now;
+    long elapsed = static_cast<long>(now - wheelTime);
+    unsigned long ticks = elapsed > 0 ? elapsed / Resolution : 0;
+    // Visit all slots between the current one and the one that contains the
+    // current time, but visit each slot at most once.
+    uint8_t visit = ticks < Slots ? uint8_t(ticks + 1) : Slots;
+    DoublyLinkedList<VUDecayTimer> expired;
+    for (uint8_t i = 0; i < visit; ++i)
+        collectExpired(slots[(currentSlot + i) % Slots], now, expired);
+    currentSlot = (currentSlot + ticks) % Slots;
+    wheelTime += ticks * Resolution;
+    // Only fire the timers once the wheel is in a consistent state, because
+    // their callbacks may reschedule them.
+    while (VUDecayTimer *timer = expired.getFirst()) {
+        expired.remove(timer);
+        timer->onDecayTimer(timer->deadline);
+    }
+}
+
+} // namespace MCU
+
+END_CS_NAMESPACE
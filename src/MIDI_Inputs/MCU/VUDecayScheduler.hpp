@@ -0,0 +1,175 @@
+#pragma once
+
+#include <AH/Arduino-Wrapper.h> // millis
+#include <AH/Containers/LinkedList.hpp>
+#include <AH/Containers/Updatable.hpp>
+#include <AH/Math/MinMaxFix.hpp>
+#include <Settings/SettingsWrapper.hpp>
+
+BEGIN_CS_NAMESPACE
+
+namespace MCU {
+
+class VUDecayScheduler;
+
+/**
+ * @brief   A timer that can be scheduled on the @ref VUDecayScheduler.
+ *
+ * Elements that decay over time (e.g. VU meters and their peak bars) inherit
+ * from this class and implement @ref onDecayTimer. While the timer is not
+ * scheduled, it costs nothing: it isn't checked in the main loop at all.
+ */
+class VUDecayTimer : public DoublyLinkable<VUDecayTimer> {
+  protected:
+    VUDecayTimer() = default;
+    /// Copying a timer results in a new timer that is not scheduled.
+    VUDecayTimer(const VUDecayTimer &) : DoublyLinkable<VUDecayTimer>() {}
+    VUDecayTimer &operator=(const VUDecayTimer &) { return *this; }
+
+  public:
+    /// Destructor: cancels the timer if it is still scheduled.
+    ~VUDecayTimer() override;
+
+    /**
+     * @brief   Schedule the timer to fire at time `start + delay`.
+     *
+     * If the timer was already scheduled, it is rescheduled.
+     *
+     * @param   start
+     *          The time (in milliseconds) to start counting from.
+     * @param   delay
+     *          The time (in milliseconds) after @p start that the timer should
+     *          fire.
+     */
+    void scheduleDecay(unsigned long start, unsigned long delay);
+    /// Cancel the timer if it is scheduled.
+    void cancelDecay();
+    /// Check whether the timer is currently scheduled.
+    bool isDecayScheduled() const { return scheduled; }
+
+  protected:
+    /**
+     * @brief   Called by the scheduler when the timer expires.
+     *
+     * The timer is no longer scheduled when this function is called. It may
+     * reschedule itself, but it shouldn't schedule or cancel any other timers.
+     *
+     * @param   deadline
+     *          The time (in milliseconds) that the timer was scheduled to fire.
+     *          Rescheduling relative to the deadline rather than the current
+     *          time prevents drift.
+     */
+    virtual void onDecayTimer(unsigned long deadline) = 0;
+
+  private:
+    unsigned long deadline = 0;
+    uint8_t slot = 0;
+    bool scheduled = false;
+
+    friend class VUDecayScheduler;
+};
+
+/**
+ * @brief   Timer wheel that drives the decay of all VU meters.
+ *
+ * Instead of every VU meter checking its own timer in every iteration of the
+ * main loop, all decay timers are registered in a single hashed timer wheel.
+ * The wheel has one slot per @ref VU_DECAY_WHEEL_RESOLUTION milliseconds, and
+ * spans the longest of the VU decay and peak hold times. When the wheel is
+ * advanced, only the slots that passed since the previous update are
+ * inspected, and only the timers that expired fire. Timers further away than
+ * the span of the wheel simply stay in their slot for another revolution.
+ *
+ * When no timers are scheduled (e.g. when all meters are at zero), updating
+ * the scheduler doesn't even read the time.
+ *
+ * The scheduler is an @ref AH::Updatable, so it is updated automatically by
+ * `Control_Surface.loop()`.
+ */
+class VUDecayScheduler : public AH::Updatable<> {
+  private:
+    VUDecayScheduler() = default;
+
+  public:
+    VUDecayScheduler(const VUDecayScheduler &) = delete;
+    VUDecayScheduler &operator=(const VUDecayScheduler &) = delete;
+
+    /// Get the single instance of the scheduler.
+    static VUDecayScheduler &getInstance();
+
+    /// Schedule the given timer to fire at time `start + delay`.
+    /// @see    VUDecayTimer::scheduleDecay
+    void schedule(VUDecayTimer &timer, unsigned long start,
+                  unsigned long delay);
+    /// Cancel the given timer.
+    /// @see    VUDecayTimer::cancelDecay
+    void cancel(VUDecayTimer &timer);
+
+    /// Doesn't do anything.
+    void begin() override {}
+    /// Fire all timers that expired since the last update.
+    void update() override {
+        if (pending > 0)
+            advance(millis());
+    }
+    /**
+     * @brief   Advance the wheel to the given time and fire all timers that
+     *          expired.
+     *
+     * Timers that reschedule themselves from their callback will fire at the
+     * earliest during the next call, so a meter that is far behind decays at
+     * most one step per call.
+     */
+    void advance(unsigned long now);
+
+    /// Get the number of timers that are currently scheduled.
+    uint16_t getNumberOfPendingTimers() const { return pending; }
+    /// Get the time the scheduler was last advanced to. This is only
+    /// up-to-date while there are pending timers.
+    unsigned long getTime() const { return time; }
+    /// Get a recent time to schedule timers from: the time the scheduler was
+    /// last advanced to while there are pending timers (so the time doesn't
+    /// have to be read), or the current time if the wheel is idle.
+    unsigned long getRecentTime() const {
+        return pending > 0 ? time : millis();
+    }
+
+    /// The time span of a single slot of the wheel, in milliseconds.
+    constexpr static unsigned long Resolution = VU_DECAY_WHEEL_RESOLUTION;
+    /// The number of slots in the wheel.
+    constexpr static uint8_t Slots =
+        AH::max(VU_PEAK_HOLD_TIME, VU_PEAK_DECAY_TIME) / Resolution + 1;
+
+    static_assert(Resolution > 0, "VU_DECAY_WHEEL_RESOLUTION cannot be zero");
+    static_assert(AH::max(VU_PEAK_HOLD_TIME, VU_PEAK_DECAY_TIME) / Resolution <
+                      255,
+                  "VU_DECAY_WHEEL_RESOLUTION is too small");
+
+  private:
+    /// Move all timers in the given slot that expired to the given list.
+    void collectExpired(DoublyLinkedList<VUDecayTimer> &slot,
+                        unsigned long now,
+                        DoublyLinkedList<VUDecayTimer> &expired);
+
+    DoublyLinkedList<VUDecayTimer> slots[Slots];
+    /// The start time of the current slot.
+    unsigned long wheelTime = 0;
+    /// The most recent time the wheel was advanced to.
+    unsigned long time = 0;
+    uint16_t pending = 0;
+    uint8_t currentSlot = 0;
+};
+
+inline void VUDecayTimer::scheduleDecay(unsigned long start,
+                                        unsigned long delay) {
+    VUDecayScheduler::getInstance().schedule(*this, start, delay);
+}
+
+inline void VUDecayTimer::cancelDecay() {
+    if (scheduled)
+        VUDecayScheduler::getInstance().cancel(*this);
+}
+
+} // namespace MCU
+
+END_CS_NAMESPACE
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "MIDIInputElementIndex.hpp"
 #include <Def/MIDIAddress.hpp>
 #include <MIDI_Parsers/MIDI_MessageTypes.hpp>
+#include <MIDI_Parsers/ParameterNumberAssembler.hpp>
 
 #include <Banks/Bank.hpp> // Bank<N>, BankSettingChangeCallback
 
@@ -20,10 +22,14 @@ BEGIN_CS_NAMESPACE
 template <MIDIMessageType Type>
 class MIDIInputElement : public AH::UpdatableCRTP<MIDIInputElement<Type>> {
   protected:
-    MIDIInputElement() = default;
+    MIDIInputElement() { invalidateIndex(); }
+    MIDIInputElement(const MIDIInputElement &other)
+        : AH::UpdatableCRTP<MIDIInputElement>(other) {
+        invalidateIndex();
+    }
 
   public:
-    virtual ~MIDIInputElement() = default;
+    virtual ~MIDIInputElement() { invalidateIndex(); }
 
   public:
     using MessageType =
@@ -44,13 +50,7 @@ class MIDIInputElement : public AH::UpdatableCRTP<MIDIInputElement<Type>> {
 
     /// Update all
     static bool updateAllWith(MessageType midimsg) {
-        for (auto &el : MIDIInputElement::updatables) {
-            if (el.updateWith(midimsg)) {
-                el.moveDown();
-                return true;
-            }
-        }
-        return false;
+        return updateAllWithImpl(midimsg);
     }
 
     /// Update all
@@ -67,8 +67,103 @@ class MIDIInputElement : public AH::UpdatableCRTP<MIDIInputElement<Type>> {
     static void resetAll() {
         MIDIInputElement::applyToAll(&MIDIInputElement::reset);
     }
+
+    /// @name Enabling and disabling
+    /// Same as @ref AH::UpdatableCRTP::enable and
+    /// @ref AH::UpdatableCRTP::disable, but they also invalidate the dispatch
+    /// index, so it only contains the enabled elements.
+    /// @{
+
+    /// Enable this element: insert it into the list of instances, so it
+    /// receives MIDI messages.
+    void enable() {
+        AH::UpdatableCRTP<MIDIInputElement>::enable();
+        invalidateIndex();
+    }
+    /// Disable this element: remove it from the list of instances, so it no
+    /// longer receives MIDI messages.
+    void disable() {
+        AH::UpdatableCRTP<MIDIInputElement>::disable();
+        invalidateIndex();
+    }
+
+    /// @copydoc enable()
+    static void enable(MIDIInputElement *element) { element->enable(); }
+    /// @copydoc enable()
+    static void enable(MIDIInputElement &element) { element.enable(); }
+    /// @copydoc enable()
+    template <class U, size_t N>
+    static void enable(U (&array)[N]) {
+        for (U &el : array)
+            enable(el);
+    }
+
+    /// @copydoc disable()
+    static void disable(MIDIInputElement *element) { element->disable(); }
+    /// @copydoc disable()
+    static void disable(MIDIInputElement &element) { element.disable(); }
+    /// @copydoc disable()
+    template <class U, size_t N>
+    static void disable(U (&array)[N]) {
+        for (U &el : array)
+            disable(el);
+    }
+
+    /// @}
+
+    /// @name Dispatch index
+    /// @{
+
+    /// Get the dispatch index that is currently used by @ref updateAllWith,
+    /// or `nullptr` if all elements are searched linearly.
+    static BaseMIDIInputElementIndex<Type> *getIndex() { return index; }
+    /// Set the dispatch index to use in @ref updateAllWith. Called by the
+    /// constructor of @ref MIDIInputElementIndex.
+    static void setIndex(BaseMIDIInputElementIndex<Type> *newIndex) {
+        index = newIndex;
+        invalidateIndex();
+    }
+    /// Invalidate the dispatch index (if any), so it gets rebuilt before the
+    /// next message is dispatched.
+    static void invalidateIndex() {
+        if (index != nullptr)
+            index->invalidate();
+    }
+
+    /// @}
+
+  protected:
+    /// Add this element to the given dispatch index. Returns false if this
+    /// element can't be indexed (the index then tries it for every message).
+    virtual bool addToIndex(BaseMIDIInputElementIndex<Type> &) { return false; }
+
+  private:
+    /// Try all elements, stop at the first one that matches the message.
+    static bool updateAllWithLinear(MessageType midimsg) {
+        for (auto &el : MIDIInputElement::updatables) {
+            if (el.updateWith(midimsg)) {
+                el.moveDown();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool updateAllWithImpl(ChannelMessage midimsg) {
+        return index != nullptr ? index->updateAllWith(midimsg)
+                                : updateAllWithLinear(midimsg);
+    }
+    static bool updateAllWithImpl(SysExMessage midimsg) {
+        return updateAllWithLinear(midimsg);
+    }
+
+    friend class BaseMIDIInputElementIndex<Type>;
+    static BaseMIDIInputElementIndex<Type> *index;
 };
 
+template <MIDIMessageType Type>
+BaseMIDIInputElementIndex<Type> *MIDIInputElement<Type>::index = nullptr;
+
 // -------------------------------------------------------------------------- //
 
 /// The @ref MIDIInputElement base class is very general: you give it a MIDI
@@ -101,6 +196,11 @@ class MatchingMIDIInputElement : public MIDIInputElement<Type> {
 
     virtual void handleUpdate(typename Matcher::Result match) = 0;
 
+  protected:
+    bool addToIndex(BaseMIDIInputElementIndex<Type> &index) override {
+        return index.insertMatcher(matcher, this);
+    }
+
   protected:
     Matcher matcher;
 };
@@ -149,4 +249,67 @@ using MIDIInputElementPB = MIDIInputElement<MIDIMessageType::PITCH_BEND>;
 /// MIDI Input Element that listens for MIDI System Exclusive messages.
 using MIDIInputElementSysEx = MIDIInputElement<MIDIMessageType::SYSEX_START>;
 
+// -------------------------------------------------------------------------- //
+
+/**
+ * @brief   A class for objects that listen for complete (Non-)Registered
+ *          Parameter Number values.
+ *
+ * The values are assembled from the Control Change messages that select and
+ * set the parameter by the @ref ParameterNumberAssembler, so an element is
+ * only updated once per value, instead of once for every Control Change
+ * message.
+ *
+ * @see     Control_Surface_::setParameterNumberAssembly
+ */
+class MIDIInputElementParameterNumber
+    : public AH::UpdatableCRTP<MIDIInputElementParameterNumber> {
+  protected:
+    MIDIInputElementParameterNumber() = default;
+
+  public:
+    virtual ~MIDIInputElementParameterNumber() = default;
+
+  public:
+    using MessageType = ParameterNumberMessage;
+
+    /// Initialize the input element.
+    virtual void begin() {} // LCOV_EXCL_LINE
+
+    /// Reset the input element to its initial state.
+    virtual void reset() {} // LCOV_EXCL_LINE
+
+    /// Update the value of the input element.
+    virtual void update() {} // LCOV_EXCL_LINE
+
+    /// Receive a new parameter value and update the internal state.
+    virtual bool updateWith(MessageType msg) = 0;
+
+    /// Update all
+    static bool updateAllWith(MessageType msg) {
+        for (auto &el : MIDIInputElementParameterNumber::updatables) {
+            if (el.updateWith(msg)) {
+                el.moveDown();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Update all
+    static void updateAll() {
+        applyToAll(&MIDIInputElementParameterNumber::update);
+    }
+
+    /// Begin all
+    static void beginAll() {
+        applyToAll(&MIDIInputElementParameterNumber::begin);
+    }
+
+    /// Reset all
+    static void resetAll() {
+        applyToAll(&MIDIInputElementParameterNumber::reset);
+    }
+};
+
 END_CS_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <AH/Debug/Debug.hpp>
+#include <Def/MIDIAddress.hpp>
+#include <MIDI_Parsers/MIDI_MessageTypes.hpp>
+
+#include <AH/STL/type_traits>
+#include <AH/STL/utility> // std::declval
+
+BEGIN_CS_NAMESPACE
+
+template <MIDIMessageType Type>
+class MIDIInputElement;
+
+/**
+ * @brief   Dispatch table that maps the address of incoming MIDI messages to
+ *          the @ref MIDIInputElement%s that listen to that address.
+ *
+ * Without an index, @ref MIDIInputElement::updateAllWith has to try all
+ * elements of the given type one by one until one of them matches. An index
+ * looks up the (cable, channel, data 1) key of the incoming message in a hash
+ * table, and only tries the elements that were registered for that key.
+ *
+ * The index is built lazily from the matchers of all enabled elements, the
+ * first time a message is dispatched after the index was invalidated.
+ * Elements with matchers that can't enumerate the addresses they listen to
+ * (e.g. user-defined matchers) are tried after the indexed candidates, in the
+ * same way as without an index.
+ *
+ * Bankable matchers register the addresses of all bank settings, so the index
+ * is independent of the active bank setting, and doesn't have to be rebuilt
+ * when a bank is selected.
+ *
+ * This class only contains the logic, the storage is provided by
+ * @ref MIDIInputElementIndex.
+ *
+ * Constructing, destroying, enabling or disabling a MIDI input element
+ * invalidates the index automatically.
+ */
+template <MIDIMessageType Type>
+class BaseMIDIInputElementIndex {
+  public:
+    using Element = MIDIInputElement<Type>;
+
+    /// Marks the end of a chain of entries.
+    constexpr static uint16_t NoEntry = 0xFFFF;
+
+    /// A single (key, element) pair in the index.
+    struct Entry {
+        uint16_t key;
+        uint16_t next;
+        Element *element;
+    };
+
+  protected:
+    BaseMIDIInputElementIndex(Entry *entries, uint16_t capacity,
+                              uint16_t *buckets, uint8_t bucketBits)
+        : entries(entries), buckets(buckets), capacity(capacity),
+          bucketBits(bucketBits) {
+        Element::setIndex(this);
+    }
+
+  public:
+    BaseMIDIInputElementIndex(const BaseMIDIInputElementIndex &) = delete;
+    BaseMIDIInputElementIndex &
+    operator=(const BaseMIDIInputElementIndex &) = delete;
+
+    ~BaseMIDIInputElementIndex() {
+        if (Element::getIndex() == this)
+            Element::setIndex(nullptr);
+    }
+
+    /// Mark the index as out of date, it will be rebuilt before the next
+    /// message is dispatched.
+    void invalidate() { valid = false; }
+    /// Check whether the index is up to date.
+    bool isValid() const { return valid; }
+
+    /// (Re)build the index from all enabled elements.
+    void build();
+
+    /// Send the given message to the first element that matches it.
+    /// @return True if an element matched the message, false otherwise.
+    bool updateAllWith(ChannelMessage msg);
+
+    /// Get the number of entries in use, including the entries of elements
+    /// that couldn't be indexed.
+    uint16_t getNumberOfEntries() const { return numEntries; }
+    /// Check whether the capacity of the index was too small to index all
+    /// elements. In that case, all messages are dispatched using a linear
+    /// search.
+    bool hasOverflowed() const { return overflowed; }
+
+  public:
+    /// Add the given element to the index under all addresses its matcher
+    /// could match. If the matcher can't enumerate its addresses, false is
+    /// returned and nothing is added.
+    template <class Matcher>
+    bool insertMatcher(const Matcher &matcher, Element *element) {
+        return insertMatcherImpl(matcher, element, 0);
+    }
+
+    /// Get the lookup key of a given MIDI address.
+    static uint16_t getKey(MIDIAddress address) {
+        return (uint16_t(address.getRawCableNumber()) << 11) |
+               (uint16_t(address.getRawChannel()) << 7) |
+               (address.getAddress() & 0x7F);
+    }
+    /// Get the lookup key of a given MIDI message.
+    static uint16_t getKey(ChannelMessage msg) {
+        return (uint16_t(msg.getCable().getRaw()) << 11) |
+               (uint16_t(msg.getChannel().getRaw()) << 7) |
+               (msg.getData1() & 0x7F);
+    }
+
+  private:
+    /// Functor that adds all addresses passed to it to the index.
+    struct Inserter {
+        BaseMIDIInputElementIndex *index;
+        Element *element;
+        bool success;
+        void operator()(MIDIAddress address) {
+            if (address.isValid())
+                success &= index->insert(getKey(address), element);
+        }
+    };
+
+    template <class Matcher>
+    auto insertMatcherImpl(const Matcher &matcher, Element *element, int)
+        -> decltype(matcher.forEachAddress(std::declval<Inserter &>()), true) {
+        Inserter inserter = {this, element, true};
+        matcher.forEachAddress(inserter);
+        return inserter.success;
+    }
+    template <class Matcher>
+    bool insertMatcherImpl(const Matcher &, Element *, long) {
+        return false;
+    }
+
+    uint16_t hash(uint16_t key) const {
+        return (key ^ (key >> bucketBits) ^ (key >> (2 * bucketBits))) &
+               ((1u << bucketBits) - 1);
+    }
+
+    /// Append an entry to the chain starting at `head`, unless the same entry
+    /// is already part of it.
+    bool append(uint16_t &head, uint16_t key, Element *element);
+    /// Add the given element to the index under the given key.
+    bool insert(uint16_t key, Element *element) {
+        return append(buckets[hash(key)], key, element);
+    }
+    /// Add an element that couldn't be indexed.
+    bool insertFallback(Element *element) {
+        return append(fallback, 0, element);
+    }
+    void clear();
+
+  private:
+    Entry *entries;
+    uint16_t *buckets;
+    uint16_t capacity;
+    uint16_t numEntries = 0;
+    uint16_t fallback = NoEntry;
+    uint8_t bucketBits;
+    bool valid = false;
+    bool overflowed = false;
+};
+
+/**
+ * @brief   Dispatch table for @ref MIDIInputElement%s with statically
+ *          allocated storage.
+ *
+ * Only one index can be active per message type. Constructing an index
+ * activates it, destroying it deactivates it again.
+ *
+ * ~~~cpp
+ * // Index all Control Change input elements, with room for 256 addresses.
+ * MIDIInputElementIndex<MIDIMessageType::CONTROL_CHANGE, 256> ccIndex;
+ * ~~~
+ *
+ * @tparam  Type
+ *          The type of MIDI input elements to index (not System Exclusive).
+ * @tparam  Capacity
+ *          The maximum number of (address, element) pairs. Single-address
+ *          elements use one entry, ranges use one entry per address in the
+ *          range, and bankable elements one entry per address per bank
+ *          setting.
+ * @tparam  BucketBits
+ *          The base-2 logarithm of the number of hash buckets.
+ *
+ * @ingroup MIDIInputElements
+ */
+template <MIDIMessageType Type, uint16_t Capacity, uint8_t BucketBits = 6>
+class MIDIInputElementIndex : public BaseMIDIInputElementIndex<Type> {
+    static_assert(Type != MIDIMessageType::SYSEX_START,
+                  "System Exclusive input elements cannot be indexed");
+    static_assert(Capacity < BaseMIDIInputElementIndex<Type>::NoEntry,
+                  "Capacity too large");
+    static_assert(BucketBits >= 1 && BucketBits <= 15, "Invalid BucketBits");
+
+  public:
+    using Entry = typename BaseMIDIInputElementIndex<Type>::Entry;
+
+    MIDIInputElementIndex()
+        : BaseMIDIInputElementIndex<Type>(entries, Capacity, buckets,
+                                          BucketBits) {}
+
+  private:
+    Entry entries[Capacity];
+    uint16_t buckets[1u << BucketBits];
+};
+
+END_CS_NAMESPACE
+
+// ---------------------------- Implementations ----------------------------- //
+
+BEGIN_CS_NAMESPACE
+
+template <MIDIMessageType Type>
+void BaseMIDIInputElementIndex<Type>::clear() {
+    for (uint16_t i = 0; i < (1u << bucketBits); ++i)
+        buckets[i] = NoEntry;
+    fallback = NoEntry;
+    numEntries = 0;
+    overflowed = false;
+}
+
+template <MIDIMessageType Type>
+bool BaseMIDIInputElementIndex<Type>::append(uint16_t &head, uint16_t key,
+                                             Element *element) {
+    uint16_t *link = &head;
+    while (*link != NoEntry) {
+        Entry &entry = entries[*link];
+        if (entry.key == key && entry.element == element)
+            return true;
+        link = &entry.next;
+    }
+    if (numEntries >= capacity)
+        return false;
+    entries[numEntries] = {key, NoEntry, element};
+    *link = numEntries++;
+    return true;
+}
+
+template <MIDIMessageType Type>
+void BaseMIDIInputElementIndex<Type>::build() {
+    clear();
+    for (Element &el : Element::updatables) {
+        if (!el.addToIndex(*this) && !insertFallback(&el)) {
+            DEBUGREF(F("Warning: MIDI input element index full (")
+                     << capacity << ')');
+            overflowed = true;
+            break;
+        }
+    }
+    valid = true;
+}
+
+template <MIDIMessageType Type>
+bool BaseMIDIInputElementIndex<Type>::updateAllWith(ChannelMessage msg) {
+    if (!valid)
+        build();
+    if (overflowed)
+        return Element::updateAllWithLinear(msg);
+    uint16_t key = getKey(msg);
+    for (uint16_t i = buckets[hash(key)]; i != NoEntry; i = entries[i].next) {
+        Entry &entry = entries[i];
+        if (entry.key == key && entry.element->isEnabled() &&
+            entry.element->updateWith(msg))
+            return true;
+    }
+    for (uint16_t i = fallback; i != NoEntry; i = entries[i].next) {
+        Element *element = entries[i].element;
+        if (element->isEnabled() && element->updateWith(msg))
+            return true;
+    }
+    return false;
+}
+
+END_CS_NAMESPACE
@@ -50,6 +50,13 @@ struct TwoByteMIDIMatcher {
         return {true, value};
     }
 
+    /// Call the given function with the address this matcher listens to.
+    /// Used to build a @ref MIDIInputElementIndex.
+    template <class Callback>
+    void forEachAddress(Callback &callback) const {
+        callback(address);
+    }
+
     MIDIAddress address;
 };
 
@@ -76,6 +83,32 @@ struct PitchBendMIDIMatcher {
 
 // -------------------------------------------------------------------------- //
 
+/// Matcher for complete (Non-)Registered Parameter Number values. Matches a
+/// single parameter number on a single channel and cable.
+struct ParameterNumberMIDIMatcher {
+    ParameterNumberMIDIMatcher(ParameterNumberMessage::Kind kind,
+                               uint16_t number, MIDIChannelCable address)
+        : kind(kind), number(number), address(address) {}
+
+    struct Result {
+        bool match;
+        uint16_t value;
+    };
+
+    Result operator()(ParameterNumberMessage m) {
+        if (m.kind != kind || m.number != number ||
+            !MIDIChannelCable::matchSingle(m.getChannelCable(), address))
+            return {false, 0};
+        return {true, m.value};
+    }
+
+    ParameterNumberMessage::Kind kind;
+    uint16_t number;
+    MIDIChannelCable address;
+};
+
+// -------------------------------------------------------------------------- //
+
 /// Matcher for MIDI messages with 2 data bytes, such as Note On/Off, Control
 /// Change, Key Pressure (but not Pitch Bend). Matches ranges of addresses on a
 /// single channel and cable.
@@ -98,6 +131,14 @@ struct TwoByteRangeMIDIMatcher {
         return {true, value, index};
     }
 
+    /// Call the given function with all addresses in the range this matcher
+    /// listens to. Used to build a @ref MIDIInputElementIndex.
+    template <class Callback>
+    void forEachAddress(Callback &callback) const {
+        for (uint8_t i = 0; i < length; ++i)
+            callback(address + i);
+    }
+
     MIDIAddress address;
     uint8_t length;
 };
@@ -168,6 +209,14 @@ struct BankableTwoByteMIDIMatcher {
         return {true, value, bankIndex};
     }
 
+    /// Call the given function with the addresses this matcher listens to,
+    /// for all bank settings. Used to build a @ref MIDIInputElementIndex.
+    template <class Callback>
+    void forEachAddress(Callback &callback) const {
+        BankableMIDIMatcherHelpers::forEachBankableAddress(address, config, 1,
+                                                           callback);
+    }
+
     Bank<BankSize> &getBank() { return config.bank; }
     const Bank<BankSize> &getBank() const { return config.bank; }
     BankType getBankType() const { return config.type; }
@@ -251,6 +300,15 @@ struct BankableTwoByteRangeMIDIMatcher {
         return {true, value, bankIndex, rangeIndex};
     }
 
+    /// Call the given function with all addresses in the ranges this matcher
+    /// listens to, for all bank settings. Used to build a
+    /// @ref MIDIInputElementIndex.
+    template <class Callback>
+    void forEachAddress(Callback &callback) const {
+        BankableMIDIMatcherHelpers::forEachBankableAddress(address, config,
+                                                           length, callback);
+    }
+
     Bank<BankSize> &getBank() { return config.bank; }
     const Bank<BankSize> &getBank() const { return config.bank; }
     static constexpr setting_t getBankSize() { return BankSize; }
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "InterfaceMIDIInputElements.hpp"
+#include "MIDIInputElementMatchers.hpp"
+
+BEGIN_CS_NAMESPACE
+
+// -------------------------------------------------------------------------- //
+
+/// Class that listens for complete (Non-)Registered Parameter Number values on
+/// a single parameter number and channel, and saves their 14-bit value.
+///
+/// Values are only received if (N)RPN assembly is enabled using
+/// @ref Control_Surface_::setParameterNumberAssembly.
+///
+/// @ingroup    MIDIInputElements
+class ParameterNumberValue : public MIDIInputElementParameterNumber,
+                             public Interfaces::IValue14 {
+  public:
+    using Matcher = ParameterNumberMIDIMatcher;
+
+    /// @param  kind
+    ///         Listen for Registered (RPN) or Non-Registered (NRPN) Parameter
+    ///         Numbers.
+    /// @param  number
+    ///         The 14-bit parameter number to listen to.
+    /// @param  address
+    ///         The MIDI channel and cable number to listen to.
+    ParameterNumberValue(ParameterNumberMessage::Kind kind, uint16_t number,
+                         MIDIChannelCable address = CHANNEL_1)
+        : matcher(kind, number, address) {}
+
+    bool updateWith(MessageType msg) override {
+        auto match = matcher(msg);
+        if (match.match)
+            handleUpdate(match);
+        return match.match;
+    }
+
+  protected:
+    void handleUpdate(typename Matcher::Result match) {
+        dirty |= value != match.value;
+        value = match.value;
+    }
+
+  public:
+    /// @name Data access
+    /// @{
+
+    /// Get the most recent parameter value that was received.
+    uint16_t getValue() const override { return value; }
+
+    /// @}
+
+    /// Reset the value to zero.
+    void reset() override {
+        value = 0;
+        dirty = true;
+    }
+
+  protected:
+    Matcher matcher;
+
+  private:
+    uint16_t value = 0;
+};
+
+END_CS_NAMESPACE
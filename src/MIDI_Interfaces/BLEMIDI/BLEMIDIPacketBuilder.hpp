@@ -127,6 +127,10 @@ class BLEMIDIPacketBuilder {
     /** 
      * @brief   Try adding a MIDI real-time message to the packet.
      * 
+     * Real-Time messages don't interrupt System Exclusive messages, so they
+     * can also be added to a packet before calling @ref continueSysEx, to
+     * send them without waiting for the rest of a long SysEx message.
+     * 
      * @param   rt 
      *          MIDI real-time byte.
      * @param   timestamp 
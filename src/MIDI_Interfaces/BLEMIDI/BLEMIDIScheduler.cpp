@@ -0,0 +1,124 @@
+#if defined(ESP32) || !defined(ARDUINO)
+
+#include "BLEMIDIScheduler.hpp"
+
+#include <algorithm>
+
+BEGIN_CS_NAMESPACE
+
+BLEMIDIScheduler::Connection *BLEMIDIScheduler::find(uint16_t conn_id) {
+    for (Connection &conn : connections)
+        if (conn.active && conn.id == conn_id)
+            return &conn;
+    return nullptr;
+}
+
+BLEMIDIScheduler::Connection *
+BLEMIDIScheduler::findOrConnect(uint16_t conn_id) {
+    if (Connection *conn = find(conn_id))
+        return conn;
+    for (Connection &conn : connections) {
+        if (!conn.active) {
+            conn = {};
+            conn.active = true;
+            conn.id = conn_id;
+            return &conn;
+        }
+    }
+    // All slots are in use, the connection is not tracked
+    return nullptr;
+}
+
+void BLEMIDIScheduler::connect(uint16_t conn_id) {
+    // A new connection starts with the default MTU and an unknown interval
+    disconnect(conn_id);
+    findOrConnect(conn_id);
+}
+
+void BLEMIDIScheduler::disconnect(uint16_t conn_id) {
+    if (Connection *conn = find(conn_id))
+        conn->active = false;
+}
+
+void BLEMIDIScheduler::setMTU(uint16_t conn_id, uint16_t mtu) {
+    if (Connection *conn = findOrConnect(conn_id))
+        conn->mtu = mtu;
+}
+
+void BLEMIDIScheduler::setConnectionInterval(uint16_t conn_id,
+                                             uint16_t interval,
+                                             time_point now) {
+    if (Connection *conn = findOrConnect(conn_id)) {
+        // The interval is reported in units of 1.25 ms
+        conn->interval = duration {interval * 1250};
+        conn->anchor = now;
+    }
+}
+
+uint8_t BLEMIDIScheduler::getNumberOfConnections() const {
+    uint8_t count = 0;
+    for (const Connection &conn : connections)
+        count += conn.active;
+    return count;
+}
+
+uint16_t BLEMIDIScheduler::getMinMTU() const {
+    uint16_t min_mtu = 0;
+    for (const Connection &conn : connections)
+        if (conn.active && (min_mtu == 0 || conn.mtu < min_mtu))
+            min_mtu = conn.mtu;
+    return min_mtu == 0 ? DefaultMTU : min_mtu;
+}
+
+const BLEMIDIScheduler::Connection *BLEMIDIScheduler::fastest() const {
+    const Connection *fastest = nullptr;
+    for (const Connection &conn : connections)
+        if (conn.active && conn.interval > duration::zero() &&
+            (!fastest || conn.interval < fastest->interval))
+            fastest = &conn;
+    return fastest;
+}
+
+BLEMIDIScheduler::duration BLEMIDIScheduler::getConnectionInterval() const {
+    const Connection *conn = fastest();
+    return conn ? conn->interval : budget;
+}
+
+BLEMIDIScheduler::time_point
+BLEMIDIScheduler::getFlushDeadline(time_point start, duration timeout) const {
+    const Connection *conn = fastest();
+    if (conn) {
+        // The connection events are estimated to be at anchor + k·interval,
+        // find the first one that is at least the margin after the start.
+        // If multiple clients are connected, schedule for the one with the
+        // shortest interval, so no client waits longer than necessary.
+        time_point target = start + margin;
+        clock::duration interval = conn->interval;
+        auto k = target <= conn->anchor
+                     ? 0
+                     : (target - conn->anchor + interval -
+                        clock::duration {1}) /
+                           interval;
+        return conn->anchor + k * interval - margin;
+    }
+    // Without a negotiated interval, there is no information about when the
+    // connection events happen, so just make sure that the packet is sent
+    // within one interval of the budget.
+    if (budget > duration::zero())
+        return start + std::max(budget - margin, duration::zero());
+    return start + timeout;
+}
+
+void BLEMIDIScheduler::recordNotification(size_t bytes, duration delay) {
+    ++stats.notifications;
+    stats.bytes += bytes;
+    stats.totalDelay += delay;
+    stats.maxDelay = std::max(stats.maxDelay, delay);
+}
+
+constexpr uint16_t BLEMIDIScheduler::DefaultMTU;
+constexpr size_t BLEMIDIScheduler::MaxConnections;
+
+END_CS_NAMESPACE
+
+#endif
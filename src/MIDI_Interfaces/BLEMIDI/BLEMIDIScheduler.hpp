@@ -0,0 +1,173 @@
+#pragma once
+
+#include <Settings/NamespaceSettings.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+BEGIN_CS_NAMESPACE
+
+/**
+ * @brief   Decides when the MIDI BLE packets are sent, based on the MTU and
+ *          the connection interval of the connected clients.
+ *
+ * A BLE peripheral can only send data during connection events, once every
+ * connection interval. Notifications that are handed to the BLE stack in
+ * between connection events simply wait until the next one, so there's no
+ * point in sending a half-empty packet early: it's better to keep adding
+ * messages to the packet, and only send it just before the next connection
+ * event. The scheduler keeps track of the negotiated MTU and connection
+ * interval of every connection, and computes these flush deadlines.
+ *
+ * It also keeps statistics about the notifications that were sent, so the
+ * effect of the scheduling can be measured.
+ *
+ * The scheduler is not thread-safe, the caller has to synchronize access.
+ */
+class BLEMIDIScheduler {
+  public:
+    using clock = std::chrono::steady_clock;
+    using time_point = clock::time_point;
+    using duration = std::chrono::microseconds;
+
+    /// The default MTU of a BLE link, before negotiation.
+    constexpr static uint16_t DefaultMTU = 23;
+    /// The maximum number of connections that are tracked.
+    constexpr static size_t MaxConnections = 4;
+
+    /// @name   Connections
+    /// @{
+
+    /// Start tracking a new connection.
+    void connect(uint16_t conn_id);
+    /// Stop tracking the given connection.
+    void disconnect(uint16_t conn_id);
+    /// Set the MTU that was negotiated for the given connection.
+    void setMTU(uint16_t conn_id, uint16_t mtu);
+    /**
+     * @brief   Set the connection interval that was negotiated for the given
+     *          connection.
+     *
+     * @param   conn_id
+     *          The connection identifier.
+     * @param   interval
+     *          The connection interval, in units of 1.25 ms (as reported by
+     *          the BLE stack).
+     * @param   now
+     *          The time at which the new parameters were reported. It is used
+     *          as an estimate of the time of a connection event.
+     */
+    void setConnectionInterval(uint16_t conn_id, uint16_t interval,
+                               time_point now);
+    /// Get the number of tracked connections.
+    uint8_t getNumberOfConnections() const;
+    /// Get the smallest MTU of all connections, or @ref DefaultMTU if there
+    /// are no connections.
+    uint16_t getMinMTU() const;
+
+    /// @}
+
+    /// @name   Timing
+    /// @{
+
+    /**
+     * @brief   Set the connection interval to use for connections that didn't
+     *          report their negotiated interval (yet).
+     *
+     * Without a negotiated interval, the time of the connection events is
+     * unknown, so packets are sent at most one budget after their first
+     * message. Set it to zero (the default) to fall back to a fixed timeout.
+     */
+    void setIntervalBudget(duration budget) { this->budget = budget; }
+    /// Set how long before the connection event the packet should be handed to
+    /// the BLE stack.
+    void setFlushMargin(duration margin) { this->margin = margin; }
+    /// Get the connection interval used for scheduling: the shortest
+    /// negotiated interval, or the budget if no interval was negotiated.
+    /// Zero means that there's no interval to schedule for.
+    duration getConnectionInterval() const;
+
+    /**
+     * @brief   Get the time at which a packet should be sent.
+     *
+     * @param   start
+     *          The time the first message was added to the packet.
+     * @param   timeout
+     *          The timeout to use if there is no connection interval.
+     * @return  The last moment before the next connection event (minus the
+     *          flush margin) that is not earlier than @p start. If no
+     *          interval was negotiated, one interval budget (minus the
+     *          margin) after @p start, or `start + timeout` if the budget is
+     *          zero.
+     */
+    time_point getFlushDeadline(time_point start, duration timeout) const;
+
+    /// @}
+
+    /// @name   Statistics
+    /// @{
+
+    /// Statistics about the notifications that were sent.
+    struct Statistics {
+        /// The number of notifications.
+        uint32_t notifications = 0;
+        /// The total number of bytes in all notifications.
+        uint64_t bytes = 0;
+        /// The sum of the queueing delays of all notifications.
+        duration totalDelay = duration::zero();
+        /// The longest queueing delay.
+        duration maxDelay = duration::zero();
+
+        /// Get the average number of bytes per notification.
+        float getBytesPerNotification() const {
+            return notifications ? float(bytes) / notifications : 0;
+        }
+        /// Get the average queueing delay.
+        duration getAverageDelay() const {
+            return notifications ? totalDelay / notifications
+                                 : duration::zero();
+        }
+    };
+
+    /**
+     * @brief   Record a notification that was sent.
+     *
+     * @param   bytes
+     *          The size of the packet.
+     * @param   delay
+     *          The time between adding the first message to the packet and
+     *          sending it.
+     */
+    void recordNotification(size_t bytes, duration delay);
+    /// Get the statistics of all notifications since the last reset.
+    const Statistics &getStatistics() const { return stats; }
+    /// Reset the statistics.
+    void resetStatistics() { stats = {}; }
+
+    /// @}
+
+  private:
+    struct Connection {
+        bool active = false;
+        uint16_t id = 0;
+        uint16_t mtu = DefaultMTU;
+        /// Negotiated connection interval, or zero if unknown.
+        duration interval = duration::zero();
+        /// Time at which the interval was reported.
+        time_point anchor = {};
+    };
+
+    Connection *find(uint16_t conn_id);
+    /// Get the connection with the shortest known interval (or null).
+    const Connection *fastest() const;
+    /// Find the given connection, or start tracking it if it is new.
+    Connection *findOrConnect(uint16_t conn_id);
+
+    Connection connections[MaxConnections];
+    duration budget = duration::zero();
+    duration margin = std::chrono::milliseconds {2};
+    Statistics stats;
+};
+
+END_CS_NAMESPACE
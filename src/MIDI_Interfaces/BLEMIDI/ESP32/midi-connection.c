@@ -14,6 +14,17 @@
 
 #include <esp_gap_ble_api.h>
 
+static midi_connection_callback_t midi_connection_callback = NULL;
+static midi_conn_interval_callback_t midi_conn_interval_callback = NULL;
+
+void midi_set_connection_callback(midi_connection_callback_t cb) {
+    midi_connection_callback = cb;
+}
+
+void midi_set_conn_interval_callback(midi_conn_interval_callback_t cb) {
+    midi_conn_interval_callback = cb;
+}
+
 void midi_handle_connect_event(esp_gatt_if_t gatts_if,
                                esp_ble_gatts_cb_param_t *param) {
     ESP_LOGI("MIDIBLE",
@@ -25,6 +36,8 @@ void midi_handle_connect_event(esp_gatt_if_t gatts_if,
              param->connect.remote_bda[5]);
 
     midi_set_connection_id(param->connect.conn_id);
+    if (midi_connection_callback)
+        midi_connection_callback(param->connect.conn_id, true);
 
     // <?> Why do we need to update the connection parameters?
     //     How are these parameters different from the advertising
@@ -48,9 +61,23 @@ void midi_handle_disconnect_event(esp_gatt_if_t gatts_if,
                                   esp_ble_gatts_cb_param_t *param) {
     ESP_LOGI("MIDIBLE", "Disconnect reason: %d", param->disconnect.reason);
 
+    if (midi_connection_callback)
+        midi_connection_callback(param->disconnect.conn_id, false);
+
     midi_set_connection_id(0);
 
     advertising_config();
 }
 
+void midi_handle_conn_params_event(esp_ble_gap_cb_param_t *param) {
+    if (param->update_conn_params.status != ESP_BT_STATUS_SUCCESS)
+        return;
+    ESP_LOGI("MIDIBLE", "Connection interval: %d (latency: %d)",
+             param->update_conn_params.conn_int,
+             param->update_conn_params.latency);
+    if (midi_conn_interval_callback)
+        midi_conn_interval_callback(midi_get_connection_id(),
+                                    param->update_conn_params.conn_int);
+}
+
 #endif
\ No newline at end of file
@@ -18,9 +18,10 @@ void midi_set_mtu_callback(midi_mtu_callback_t cb) { midi_mtu_callback = cb; }
 void midi_handle_mtu_event(esp_gatt_if_t gatts_if,
                            esp_ble_gatts_cb_param_t *param) {
     midi_mtu = param->mtu.mtu;
-    ESP_LOGI("MIDIBLE", "MTU: %d", midi_mtu);
+    ESP_LOGI("MIDIBLE", "MTU: %d (connection ID: %d)", midi_mtu,
+             param->mtu.conn_id);
     if (midi_mtu_callback) {
-        midi_mtu_callback(midi_mtu);
+        midi_mtu_callback(param->mtu.conn_id, midi_mtu);
     }
 }
 
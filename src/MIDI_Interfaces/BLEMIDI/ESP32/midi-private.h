@@ -8,6 +8,7 @@
  */
 
 #include "midi.h"
+#include <esp_gap_ble_api.h>
 #include <esp_gatt_defs.h>
 #include <esp_gatts_api.h>
 
@@ -30,6 +31,7 @@ void midi_handle_mtu_event(esp_gatt_if_t gatts_if,
                            esp_ble_gatts_cb_param_t *param);
 void midi_handle_read_event(esp_gatt_if_t gatts_if,
                             esp_ble_gatts_cb_param_t *param);
+void midi_handle_conn_params_event(esp_ble_gap_cb_param_t *param);
 
 uint16_t midi_get_service_handle(void);
 uint16_t midi_get_characteristic_handle(void);
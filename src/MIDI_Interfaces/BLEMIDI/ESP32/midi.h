@@ -14,10 +14,11 @@
 extern "C" {
 #endif
 
-/// Type for the MTU negotiation callback.
+/// Type for the MTU negotiation callback. The arguments are the connection ID
+/// and the negotiated MTU.
 /// @warning    Used in C code, use C calling convention (use `extern "C"` to
 ///             declare this function in C++ code).
-typedef void (*midi_mtu_callback_t)(uint16_t);
+typedef void (*midi_mtu_callback_t)(uint16_t, uint16_t);
 /// Set the callback that is to be called when the MTU negotiation with the BLE
 /// client is finished.
 void midi_set_mtu_callback(midi_mtu_callback_t cb);
@@ -25,6 +26,24 @@ void midi_set_mtu_callback(midi_mtu_callback_t cb);
 /// client.
 uint16_t midi_get_mtu(void);
 
+/// Type for the connection callback. The arguments are the connection ID and
+/// whether the client connected (true) or disconnected (false).
+/// @warning    Used in C code, use C calling convention (use `extern "C"` to
+///             declare this function in C++ code).
+typedef void (*midi_connection_callback_t)(uint16_t, bool);
+/// Set the callback that is to be called when a BLE client connects or
+/// disconnects.
+void midi_set_connection_callback(midi_connection_callback_t cb);
+
+/// Type for the connection interval callback. The arguments are the connection
+/// ID and the connection interval in units of 1.25 ms.
+/// @warning    Used in C code, use C calling convention (use `extern "C"` to
+///             declare this function in C++ code).
+typedef void (*midi_conn_interval_callback_t)(uint16_t, uint16_t);
+/// Set the callback that is to be called when the connection parameters of the
+/// link with the BLE client are updated.
+void midi_set_conn_interval_callback(midi_conn_interval_callback_t cb);
+
 /// Type for the BLE MIDI write callback.
 /// @warning    Used in C code, use C calling convention (use `extern "C"` to
 ///             declare this function in C++ code).
@@ -1,54 +1,11 @@
 #if defined(ESP32) || !defined(ARDUINO)
 
 #include "MIDIMessageQueue.hpp"
+#include <AH/Debug/Debug.hpp>
 
-BEGIN_CS_NAMESPACE
-
-MIDIMessageQueue::MIDIMessageQueueElement::MIDIMessageQueueElement(
-    SysExMessage message, uint16_t timestamp)
-    : eventType(message.isLastChunk() ? MIDIReadEvent::SYSEX_MESSAGE
-                                      : MIDIReadEvent::SYSEX_CHUNK),
-      message(message), timestamp(timestamp) {
-    // SysEx data is copied, not stored by pointer, so allocate new
-    // storage for the SysEx data, and copy it if allocation was
-    // successful.
-    uint8_t *newBuffer = new uint8_t[message.length];
-    // Make sure that allocation was successful.
-    if (newBuffer == nullptr) {
-        DEBUGREF(F("SysEx buffer allocation failed"));
-        this->eventType = MIDIReadEvent::NO_MESSAGE;
-        this->message.realtimemessage = 0x00;
-    } else {
-        // Copy the SysEx data to the newly allocated buffer
-        memcpy(newBuffer, message.data, message.length);
-        this->message.sysexmessage.data = newBuffer;
-    }
-}
-
-MIDIMessageQueue::MIDIMessageQueueElement::MIDIMessageQueueElement(
-    MIDIMessageQueue::MIDIMessageQueueElement &&that) {
-    *this = std::move(that);
-}
+#include <string.h>
 
-MIDIMessageQueue::MIDIMessageQueueElement &
-MIDIMessageQueue::MIDIMessageQueueElement::operator=(
-    MIDIMessageQueue::MIDIMessageQueueElement &&that) {
-    std::swap(this->eventType, that.eventType);
-    std::swap(this->message, that.message);
-    std::swap(this->timestamp, that.timestamp);
-    return *this;
-}
-
-void MIDIMessageQueue::MIDIMessageQueueElement::release() {
-    if (eventType == MIDIReadEvent::SYSEX_CHUNK ||
-        eventType == MIDIReadEvent::SYSEX_MESSAGE) {
-        delete[] message.sysexmessage.data;
-        message.sysexmessage.data = nullptr;
-        message.sysexmessage.length = 0;
-        eventType = MIDIReadEvent::NO_MESSAGE;
-        message.realtimemessage = 0x00;
-    }
-}
+BEGIN_CS_NAMESPACE
 
 bool MIDIMessageQueue::push(ChannelMessage message, uint16_t timestamp) {
     return push(MIDIMessageQueueElement(message, timestamp));
@@ -66,24 +23,58 @@ bool MIDIMessageQueue::push(SysExMessage message, uint16_t timestamp) {
     if (storage.size() == size.load(std::memory_order_acquire))
         return false;
 
-    // Allocate storage for the actual SysEx data and copy the data
-    MIDIMessageQueueElement el(message, timestamp);
-    // Check if allocation failed
-    if (el.eventType == MIDIReadEvent::NO_MESSAGE)
-        return true; // TODO: should we try again later?
+    size_t length = message.length;
+    size_t capacity = sysex_storage.size();
+    if (length > capacity) {
+        // This message will never fit, retrying is pointless
+        DEBUGREF(F("SysEx message too large for queue"));
+        sysex_dropped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
 
-    *write_p = std::move(el);
-    inc(write_p);
-    size.fetch_add(1, std::memory_order_release);
+    // Store the SysEx data contiguously: if it doesn't fit at the end of the
+    // storage, skip the remaining bytes and start at the beginning. If none of
+    // the storage is in use, always start at the beginning, so no bytes are
+    // skipped.
+    size_t in_use = sysex_used.load(std::memory_order_acquire);
+    if (in_use == 0)
+        sysex_write = 0;
+    size_t start = sysex_write;
+    size_t reserved = length;
+    if (start + length > capacity) {
+        reserved += capacity - start;
+        start = 0;
+    }
+    size_t used = in_use + reserved;
+    if (used > capacity) {
+        sysex_overflows.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
 
-    return true;
+    // Copy the data to the SysEx storage
+    uint8_t *data = sysex_storage.data() + start;
+    memcpy(data, message.data, length);
+    sysex_write = start + length == capacity ? 0 : start + length;
+    sysex_used.fetch_add(reserved, std::memory_order_relaxed);
+    if (used > sysex_peak.load(std::memory_order_relaxed))
+        sysex_peak.store(used, std::memory_order_relaxed);
+
+    MIDIMessageQueueElement el(message, timestamp);
+    el.message.sysexmessage.data = data;
+    el.sysexReserved = reserved;
+    return push(std::move(el));
 }
 
 bool MIDIMessageQueue::pop(MIDIMessageQueueElement &message) {
+    // The SysEx data of the previous message is no longer needed, release it
+    // even if the queue is empty, otherwise, the producer might have to wait
+    // for space that is only released when it pushes another message.
+    sysex_used.fetch_sub(sysex_popped, std::memory_order_release);
+    sysex_popped = 0;
     if (size.load(std::memory_order_acquire) == 0)
         return false;
-    message = std::move(*read_p);
-    read_p->release(); // release memory of old message
+    message = *read_p;
+    sysex_popped = message.sysexReserved;
     inc(read_p);
     size.fetch_sub(1, std::memory_order_release);
     return true;
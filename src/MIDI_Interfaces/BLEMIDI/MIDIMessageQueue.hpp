@@ -2,14 +2,35 @@
 
 #include <MIDI_Parsers/MIDIReadEvent.hpp>
 #include <MIDI_Parsers/MIDI_MessageTypes.hpp>
+#include <Settings/SettingsWrapper.hpp>
 
 #include <atomic>
 
 BEGIN_CS_NAMESPACE
 
+/**
+ * @brief   Lock-free single-producer, single-consumer queue for incoming MIDI
+ *          messages.
+ *
+ * The data of System Exclusive messages is copied into a preallocated
+ * circular buffer with a fixed byte budget, so no dynamic memory is allocated
+ * after construction. Each SysEx message is stored contiguously: if it
+ * doesn't fit at the end of the buffer, the remaining space is skipped and it
+ * is stored at the beginning. The data of a popped message remains valid until
+ * the next call to @ref pop, so the consumer should keep calling @ref pop until
+ * the queue is empty to release the storage.
+ */
 class MIDIMessageQueue {
   public:
-    MIDIMessageQueue(size_t capacity) : storage(storage_t(capacity)) {}
+    /// @param  capacity
+    ///         The maximum number of messages in the queue.
+    /// @param  sysex_capacity
+    ///         The total number of bytes available for the data of all SysEx
+    ///         messages in the queue.
+    MIDIMessageQueue(size_t capacity,
+                     uint16_t sysex_capacity = BLE_SYSEX_QUEUE_SIZE)
+        : storage(storage_t(capacity)),
+          sysex_storage(std::vector<uint8_t>(sysex_capacity)) {}
 
     struct MIDIMessageQueueElement {
         MIDIReadEvent eventType = MIDIReadEvent::NO_MESSAGE;
@@ -26,6 +47,9 @@ class MIDIMessageQueue {
             Message(SysExMessage msg) : sysexmessage(msg) {}
         } message;
         uint16_t timestamp = 0xFFFF;
+        /// The number of bytes of SysEx storage used by this message,
+        /// including the space that was skipped at the end of the buffer.
+        uint16_t sysexReserved = 0;
 
         MIDIMessageQueueElement() = default;
         MIDIMessageQueueElement(ChannelMessage message, uint16_t timestamp)
@@ -37,22 +61,10 @@ class MIDIMessageQueue {
         MIDIMessageQueueElement(RealTimeMessage message, uint16_t timestamp)
             : eventType(MIDIReadEvent::REALTIME_MESSAGE), message(message),
               timestamp(timestamp) {}
-        MIDIMessageQueueElement(SysExMessage message, uint16_t timestamp);
-
-        /// No copy constructor.
-        MIDIMessageQueueElement(const MIDIMessageQueueElement &) = delete;
-        /// No copy assignment.
-        MIDIMessageQueueElement &
-        operator=(const MIDIMessageQueueElement &) = delete;
-        /// Move constructor.
-        MIDIMessageQueueElement(MIDIMessageQueueElement &&that);
-        /// Move assignemnt.
-        MIDIMessageQueueElement &operator=(MIDIMessageQueueElement &&that);
-
-        /// Deallocate the storage for the SysEx data (if present).
-        void release();
-
-        ~MIDIMessageQueueElement() { release(); }
+        MIDIMessageQueueElement(SysExMessage message, uint16_t timestamp)
+            : eventType(message.isLastChunk() ? MIDIReadEvent::SYSEX_MESSAGE
+                                              : MIDIReadEvent::SYSEX_CHUNK),
+              message(message), timestamp(timestamp) {}
     };
 
     using storage_t = std::vector<MIDIMessageQueueElement>;
@@ -62,16 +74,56 @@ class MIDIMessageQueue {
     bool push(ChannelMessage message, uint16_t timestamp);
     bool push(SysCommonMessage message, uint16_t timestamp);
     bool push(RealTimeMessage message, uint16_t timestamp);
+    /// Copy the SysEx data into the SysEx storage and add the message to the
+    /// queue. Returns false if the queue or the SysEx storage is full, so it
+    /// can be retried later. Messages that are larger than the entire SysEx
+    /// storage are dropped (and true is returned).
     bool push(SysExMessage message, uint16_t timestamp);
 
+    /// Remove the oldest message from the queue. Returns false if the queue
+    /// is empty. Releases the SysEx data of the previously popped message.
     bool pop(MIDIMessageQueueElement &message);
 
+    /// @name   SysEx storage statistics
+    /// @{
+
+    /// Get the total number of bytes available for SysEx data.
+    size_t getSysExCapacity() const { return sysex_storage.size(); }
+    /// Get the number of bytes of SysEx storage currently in use.
+    size_t getSysExUsage() const { return sysex_used; }
+    /// Get the maximum number of bytes of SysEx storage that were in use at
+    /// the same time.
+    size_t getSysExPeakUsage() const { return sysex_peak; }
+    /// Get the number of times a SysEx message couldn't be added because the
+    /// SysEx storage was full.
+    size_t getSysExOverflowCount() const { return sysex_overflows; }
+    /// Get the number of SysEx messages that were dropped because they were
+    /// larger than the entire SysEx storage.
+    size_t getSysExDroppedCount() const { return sysex_dropped; }
+
+    /// @}
+
   private:
     storage_t storage = storage_t(64);
     iter_t write_p = storage.begin();
     iter_t read_p = storage.begin();
     std::atomic_size_t size{0};
 
+    /// Storage for the SysEx data of the messages in the queue.
+    std::vector<uint8_t> sysex_storage;
+    /// Index in the SysEx storage where the next message will be written.
+    /// (Only used by the producer.)
+    size_t sysex_write = 0;
+    /// Number of bytes of SysEx storage in use.
+    std::atomic_size_t sysex_used{0};
+    /// SysEx storage used by the message that was popped last. It's released
+    /// by the next call to @ref pop. (Only used by the consumer.)
+    uint16_t sysex_popped = 0;
+
+    std::atomic_size_t sysex_peak{0};
+    std::atomic_size_t sysex_overflows{0};
+    std::atomic_size_t sysex_dropped{0};
+
     bool push(MIDIMessageQueueElement &&message);
 
     void inc(iter_t &it) {
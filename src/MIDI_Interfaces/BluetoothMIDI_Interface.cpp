@@ -9,6 +9,13 @@ BEGIN_CS_NAMESPACE
 
 // The following section defines functions that send the MIDI BLE packets in
 // the background.
+//
+// The main thread writes all outgoing messages to a lock-free ring buffer,
+// and doesn't wait for the sender thread. If the ring is full, the message is
+// dropped. The only exception are SysEx messages that are larger than the
+// entire ring: those are written in pieces, waiting for the sender thread to
+// make room. The sender thread is the only one that touches the packet
+// builder.
 
 void BluetoothMIDI_Interface::startSendingThread() {
     // As long as you didn't get the stop signal, wait for data to send
@@ -23,54 +30,77 @@ void BluetoothMIDI_Interface::startSendingThread() {
 }
 
 bool BluetoothMIDI_Interface::handleSendEvents() {
-    lock_t lock(mtx);
-
-    // Wait for a packet to be started (or for a stop signal)
-    cv.wait(lock, [this] { return !packetbuilder.empty() || stop_sending; });
-    bool keep_going = !stop_sending;
-    // Wait for flush signal or timeout
-    bool flushing = cv.wait_for(lock, timeout, [this] { return flushnow; });
+    using clock = std::chrono::steady_clock;
+    std::chrono::milliseconds timeout{this->timeout};
+    auto flush_requested = [this] { return flush_requests != flushes_done; };
+    auto wake_up = [&] {
+        return !send_ring.empty() || !rt_send_ring.empty() || stop_sending ||
+               flush_requested();
+    };
 
-    // Send the packet over BLE, empty the buffer, and update the buffer size
-    // based on the MTU of the connected clients.
-    if (!packetbuilder.empty())
-        notifyMIDIBLE(packetbuilder.getPacket());
-    packetbuilder.reset();
-    packetbuilder.setCapacity(min_mtu - 3);
+    // Wait for a message to be sent (or for a stop signal). The main thread
+    // doesn't lock the mutex when notifying, so a notification could be
+    // missed, which is why the wait is limited to the timeout.
+    lock_t lock(mtx);
+    while (!wake_up())
+        cv.wait_for(lock, timeout);
+    lock.unlock();
 
-    // Notify the main thread that the flush was done
-    if (flushing) {
-        flushnow = false;
+    // Keep adding messages to the packet until just before the next
+    // connection event (or until the timeout expires if the connection
+    // interval is unknown), or until a flush or stop signal is received
+    lock_t sched_lock(scheduler_mtx);
+    auto deadline = scheduler.getFlushDeadline(clock::now(), timeout);
+    sched_lock.unlock();
+    uint_fast32_t requests;
+    while (true) {
+        // Read the number of requests before draining the ring, so all
+        // messages sent before the last flush request are included
+        requests = flush_requests;
+        drainSendRing();
+        if (stop_sending || requests != flushes_done ||
+            clock::now() >= deadline)
+            break;
+        lock.lock();
+        cv.wait_until(lock, deadline, wake_up);
         lock.unlock();
-        cv.notify_one();
     }
+    sendPacket();
+
+    // Notify the main thread that the flush was done
+    lock.lock();
+    bool flushed = requests != flushes_done;
+    flushes_done = requests;
+    bool keep_going =
+        !stop_sending || !send_ring.empty() || !rt_send_ring.empty();
+    lock.unlock();
+    if (flushed)
+        flushed_cv.notify_all();
     return keep_going;
 }
 
-void BluetoothMIDI_Interface::flushImpl(lock_t &lock) {
-    assert(lock.owns_lock());
-    // No need to send empty packets
-    if (packetbuilder.empty())
-        return;
-
-    // Tell the background sender thread to send the packet now
-    flushnow = true;
-    lock.unlock();
+void BluetoothMIDI_Interface::flush() {
+    ++flush_requests;
     cv.notify_one();
+}
 
-    // Wait for flush to complete (when the sender clears the flushnow flag)
-    lock.lock();
-    cv.wait(lock, [this] { return !flushnow; });
-    assert(lock.owns_lock());
+bool BluetoothMIDI_Interface::flushAndWait(std::chrono::milliseconds timeout) {
+    if (!send_thread.joinable())
+        return false;
+    uint_fast32_t request = ++flush_requests;
+    cv.notify_one();
+    lock_t lock(mtx);
+    // flushes_done only increases, also handle wrap-around
+    return flushed_cv.wait_for(lock, timeout, [&] {
+        return uint32_t(flushes_done - request) < 0x80000000u;
+    });
 }
 
 void BluetoothMIDI_Interface::stopSendingThread() {
-    // Tell the sender that this is the last packet
-    stop_sending = true;
-
-    // Tell it to send the packet right now (flush)
+    // Tell the sender that this is the last packet, it will send all
+    // remaining messages first
     lock_t lock(mtx);
-    flushnow = true;
+    stop_sending = true;
     lock.unlock();
     cv.notify_one();
 
@@ -79,6 +109,120 @@ void BluetoothMIDI_Interface::stopSendingThread() {
         send_thread.join();
 }
 
+bool BluetoothMIDI_Interface::pushSendRecord(SendRecordType type,
+                                             uint16_t timestamp,
+                                             const uint8_t *data,
+                                             size_t length) {
+    const uint8_t header[SendRecordHeaderSize] = {
+        type,
+        uint8_t(length),
+        uint8_t(timestamp),
+        uint8_t(timestamp >> 8),
+    };
+    if (!send_ring.write(header, sizeof(header), data, length))
+        return false;
+    // Wake up the sender thread, without locking
+    cv.notify_one();
+    return true;
+}
+
+void BluetoothMIDI_Interface::drainSendRing() {
+    uint8_t header[SendRecordHeaderSize];
+    while (true) {
+        // Real-Time messages go before any other queued messages
+        drainRealTimeSendRing();
+        if (!send_ring.peek(header, sizeof(header)))
+            break;
+        size_t length = header[1];
+        send_ring.skip(sizeof(header));
+        send_ring.read(send_record, length);
+        uint16_t timestamp = header[2] | (uint16_t(header[3]) << 8);
+        addToPacket(static_cast<SendRecordType>(header[0]), timestamp,
+                    send_record, length);
+    }
+}
+
+void BluetoothMIDI_Interface::drainRealTimeSendRing() {
+    uint8_t record[3];
+    while (rt_send_ring.read(record, sizeof(record))) {
+        uint16_t timestamp = record[1] | (uint16_t(record[2]) << 8);
+        addToPacket(SendRealTimeMessage, timestamp, record, 1);
+    }
+}
+
+void BluetoothMIDI_Interface::addToPacket(SendRecordType type,
+                                          uint16_t timestamp,
+                                          const uint8_t *data, size_t length) {
+    // Update the packet size based on the MTU of the connected clients, and
+    // remember when the packet was started to measure the queueing delay.
+    if (packetbuilder.empty()) {
+        packetbuilder.setCapacity(min_mtu - 3);
+        packet_start = BLEMIDIScheduler::clock::now();
+    }
+
+    // Try adding the message to the current packet, if that doesn't work,
+    // send the packet and add the message to the (now empty) next packet.
+    switch (type) {
+        case SendChannelMessage3B:
+            if (!packetbuilder.add3B(data[0], data[1], data[2], timestamp)) {
+                sendPacket();
+                packetbuilder.add3B(data[0], data[1], data[2], timestamp);
+            }
+            break;
+        case SendChannelMessage2B:
+            if (!packetbuilder.add2B(data[0], data[1], timestamp)) {
+                sendPacket();
+                packetbuilder.add2B(data[0], data[1], timestamp);
+            }
+            break;
+        case SendRealTimeMessage:
+            if (!packetbuilder.addRealTime(data[0], timestamp)) {
+                sendPacket();
+                packetbuilder.addRealTime(data[0], timestamp);
+            }
+            break;
+        case SendSysCommonMessage:
+            if (!packetbuilder.addSysCommon(length - 1, data[0], data[1],
+                                            data[2], timestamp)) {
+                sendPacket();
+                packetbuilder.addSysCommon(length - 1, data[0], data[1],
+                                           data[2], timestamp);
+            }
+            break;
+        case SendSysExChunk:
+            // Try adding at least the SysExStart header to the current packet
+            if (!packetbuilder.addSysEx(data, length, timestamp)) {
+                sendPacket();
+                packetbuilder.addSysEx(data, length, timestamp);
+            }
+            // As long as there's data to be sent in the next packet, send the
+            // previous (full) packet, and add the next part of the SysEx
+            // message to a continuation packet. Real-Time messages that were
+            // sent in the meantime are inserted before the continuation, so
+            // they don't have to wait for the entire SysEx message.
+            while (data) {
+                sendPacket();
+                drainRealTimeSendRing();
+                packetbuilder.continueSysEx(data, length, timestamp);
+            }
+            break;
+        default: break; // LCOV_EXCL_LINE
+    }
+}
+
+void BluetoothMIDI_Interface::sendPacket() {
+    if (!packetbuilder.empty()) {
+        notifyMIDIBLE(packetbuilder.getPacket());
+        auto delay = BLEMIDIScheduler::clock::now() - packet_start;
+        lock_t lock(scheduler_mtx);
+        scheduler.recordNotification(
+            packetbuilder.getSize(),
+            std::chrono::duration_cast<BLEMIDIScheduler::duration>(delay));
+    }
+    packetbuilder.reset();
+    packetbuilder.setCapacity(min_mtu - 3);
+}
+
 // -------------------------------------------------------------------------- //
 
 #ifdef ARDUINO
@@ -93,73 +237,37 @@ void BluetoothMIDI_Interface::notifyMIDIBLE(
 // The following section implements the MIDI sending functions.
 
 void BluetoothMIDI_Interface::sendChannelMessageImpl(ChannelMessage msg) {
-    msg.hasTwoDataBytes() ? sendChannelMessageImpl3Bytes(msg)
-                          : sendChannelMessageImpl2Bytes(msg);
-}
-
-void BluetoothMIDI_Interface::sendChannelMessageImpl3Bytes(ChannelMessage msg) {
-    // BLE packets are sent asynchronously, so we need a lock to access the
-    // packet buffer
-    lock_t lock(mtx);
     uint16_t timestamp = millis();
-    // Try adding the message to the current packet
-    if (!packetbuilder.add3B(msg.header, msg.data1, msg.data2, timestamp)) {
-        // If that doesn't work, flush the packet (send it now and wait until
-        // it is sent)
-        flushImpl(lock);
-        // And then add it to the (now emtpy) buffer
-        packetbuilder.add3B(msg.header, msg.data1, msg.data2, timestamp);
-    }
-    // Notify the packet sender that data has been added to the buffer
-    lock.unlock();
-    cv.notify_one();
-}
-
-void BluetoothMIDI_Interface::sendChannelMessageImpl2Bytes(ChannelMessage msg) {
-    // For comments, see
-    //   sendChannelMessageImpl3Bytes() above
-    lock_t lock(mtx);
-    uint16_t timestamp = millis();
-    if (!packetbuilder.add2B(msg.header, msg.data1, timestamp)) {
-        flushImpl(lock);
-        packetbuilder.add2B(msg.header, msg.data1, timestamp);
-    }
-    lock.unlock();
-    cv.notify_one();
+    const uint8_t data[] = {msg.header, msg.data1, msg.data2};
+    bool success =
+        msg.hasTwoDataBytes()
+            ? pushSendRecord(SendChannelMessage3B, timestamp, data, 3)
+            : pushSendRecord(SendChannelMessage2B, timestamp, data, 2);
+    if (!success)
+        ++dropped_messages;
 }
 
 void BluetoothMIDI_Interface::sendRealTimeImpl(RealTimeMessage msg) {
-    // For comments, see
-    //   sendChannelMessageImpl3Bytes() above
-    lock_t lock(mtx);
     uint16_t timestamp = millis();
-    if (!packetbuilder.addRealTime(msg.message, timestamp)) {
-        flushImpl(lock);
-        packetbuilder.addRealTime(msg.message, timestamp);
+    const uint8_t record[] = {msg.message, uint8_t(timestamp),
+                              uint8_t(timestamp >> 8)};
+    if (!rt_send_ring.write(record, sizeof(record))) {
+        ++dropped_messages;
+        return;
     }
-    lock.unlock();
+    // Wake up the sender thread, without locking
     cv.notify_one();
 }
 
 void BluetoothMIDI_Interface::sendSysCommonImpl(SysCommonMessage msg) {
-    // For comments, see
-    //   sendChannelMessageImpl3Bytes() above
-    lock_t lock(mtx);
     uint16_t timestamp = millis();
-    uint8_t num_data = msg.getNumberOfDataBytes();
-    if (!packetbuilder.addSysCommon(num_data, msg.header, msg.data1, msg.data2,
-                                    timestamp)) {
-        flushImpl(lock);
-        packetbuilder.addSysCommon(num_data, msg.header, msg.data1, msg.data2,
-                                   timestamp);
-    }
-    lock.unlock();
-    cv.notify_one();
+    const uint8_t data[] = {msg.header, msg.data1, msg.data2};
+    if (!pushSendRecord(SendSysCommonMessage, timestamp, data,
+                        1 + msg.getNumberOfDataBytes()))
+        ++dropped_messages;
 }
 
 void BluetoothMIDI_Interface::sendSysExImpl(SysExMessage msg) {
-    lock_t lock(mtx);
-
     size_t length = msg.length;
     const uint8_t *data = msg.data;
     uint16_t timestamp = millis(); // BLE MIDI timestamp
@@ -168,27 +276,63 @@ void BluetoothMIDI_Interface::sendSysExImpl(SysExMessage msg) {
     if ((timestamp & 0x77) == 0x77)
         timestamp &= 0xFFFE;
 
-    // Try adding at least the SysExStart header to the current packet
-    if (!packetbuilder.addSysEx(data, length, timestamp)) {
-        // If that didn't fit, flush the packet
-        flushImpl(lock);
-        // Add the first part of the SysEx message to this packet
-        packetbuilder.addSysEx(data, length, timestamp);
+    // SysEx messages are split into records of at most SendRecordMaxSize
+    // bytes. They are only added if the entire message fits, so the sender
+    // thread never sees half a message, and the main thread never waits for
+    // it.
+    size_t records = (length + SendRecordMaxSize - 1) / SendRecordMaxSize;
+    size_t required = length + records * SendRecordHeaderSize;
+    if (required > send_ring.capacity()) {
+        // This message can never fit at once, so wait for the sender thread
+        // to make room for each record
+        DEBUGREF(F("Warning: SysEx message larger than BLE send buffer"));
+        while (length > 0) {
+            if (!send_thread.joinable() || stop_sending) {
+                // Nobody will ever make room
+                ++dropped_messages;
+                return;
+            }
+            size_t chunk = std::min(length, SendRecordMaxSize);
+            if (pushSendRecord(SendSysExChunk, timestamp, data, chunk)) {
+                data += chunk;
+                length -= chunk;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        return;
     }
-    // As long as there's data to be sent in the next packet
-    while (data) {
-        // Send the previous (full) packet
-        flushImpl(lock);
-        // And add the next part of the SysEx message to a continuation packet
-        packetbuilder.continueSysEx(data, length, timestamp);
+    if (required > send_ring.writeAvailable()) {
+        ++dropped_messages;
+        return;
+    }
+    while (length > 0) {
+        size_t chunk = std::min(length, SendRecordMaxSize);
+        pushSendRecord(SendSysExChunk, timestamp, data, chunk);
+        data += chunk;
+        length -= chunk;
     }
-    // Notify the packet sender that data has been added to the buffer
-    lock.unlock();
-    cv.notify_one();
+}
+
+size_t BluetoothMIDI_Interface::getMaxSysExLength() const {
+    // Every full record holds SendRecordMaxSize bytes, the last one holds the
+    // remainder, all of them have a header.
+    size_t capacity = send_ring.capacity();
+    constexpr size_t FullRecord = SendRecordMaxSize + SendRecordHeaderSize;
+    size_t full = capacity / FullRecord;
+    size_t rest = capacity % FullRecord;
+    return full * SendRecordMaxSize +
+           (rest > SendRecordHeaderSize ? rest - SendRecordHeaderSize : 0);
 }
 
 // -------------------------------------------------------------------------- //
 
+// The parser waits until every SysEx chunk has been added to the queue, so a
+// chunk must always fit, even if the storage is in use by the chunk that was
+// popped last, or if it has to skip the bytes at the end of the storage.
+static_assert(SYSEX_BUFFER_SIZE <= BLE_SYSEX_QUEUE_SIZE / 2,
+              "SysEx chunks should fit in half of the BLE SysEx queue");
+
 void BluetoothMIDI_Interface::parse(const uint8_t *const data,
                                     const size_t len) {
     auto mididata = BLEMIDIParser(data, len);
@@ -207,11 +351,15 @@ void BluetoothMIDI_Interface::parse(const uint8_t *const data,
                                    mididata.getTimestamp()))
                     std::this_thread::yield();
                 break;
-            case MIDIReadEvent::REALTIME_MESSAGE:
-                while (!queue.push(parser.getRealTimeMessage(),
-                                   mididata.getTimestamp()))
+            case MIDIReadEvent::REALTIME_MESSAGE: {
+                // Real-Time messages skip the queue
+                uint16_t timestamp = mididata.getTimestamp();
+                const uint8_t record[] = {parser.getRealTimeMessage().message,
+                                          uint8_t(timestamp),
+                                          uint8_t(timestamp >> 8)};
+                while (!rt_receive_ring.write(record, sizeof(record)))
                     std::this_thread::yield();
-                break;
+            } break;
             case MIDIReadEvent::SYSCOMMON_MESSAGE:
                 while (!queue.push(parser.getSysCommonMessage(),
                                    mididata.getTimestamp()))
@@ -226,6 +374,13 @@ void BluetoothMIDI_Interface::parse(const uint8_t *const data,
 }
 
 MIDIReadEvent BluetoothMIDI_Interface::read() {
+    // Real-Time messages have priority over the other queued messages
+    uint8_t record[3];
+    if (rt_receive_ring.read(record, sizeof(record))) {
+        uint16_t timestamp = record[1] | (uint16_t(record[2]) << 8);
+        incomingMessage = {RealTimeMessage(record[0]), timestamp};
+        return incomingMessage.eventType;
+    }
     // Pop a new message from the queue
     if (!queue.pop(incomingMessage))
         return MIDIReadEvent::NO_MESSAGE;
@@ -264,27 +419,96 @@ uint16_t BluetoothMIDI_Interface::getTimestamp() const {
 
 // -------------------------------------------------------------------------- //
 
-void BluetoothMIDI_Interface::updateMTU(uint16_t mtu) {
+void BluetoothMIDI_Interface::refreshMinMTU() {
+    lock_t lock(scheduler_mtx);
+    uint16_t mtu = scheduler.getMinMTU();
+    lock.unlock();
     uint16_t force_min_mtu_c = force_min_mtu;
     if (force_min_mtu_c == 0)
         min_mtu = mtu;
     else
         min_mtu = std::min(force_min_mtu_c, mtu);
     DEBUGFN(NAMEDVALUE(min_mtu));
-    lock_t lock(mtx);
-    if (packetbuilder.getSize() == 0)
-        packetbuilder.setCapacity(min_mtu - 3);
+    // The sender thread updates the capacity of the packet builder before
+    // starting a new packet
+}
+
+void BluetoothMIDI_Interface::updateMTU(uint16_t conn_id, uint16_t mtu) {
+    lock_t lock(scheduler_mtx);
+    scheduler.setMTU(conn_id, mtu);
+    lock.unlock();
+    refreshMinMTU();
+}
+
+void BluetoothMIDI_Interface::updateConnection(uint16_t conn_id,
+                                               bool connected) {
+    lock_t lock(scheduler_mtx);
+    if (connected)
+        scheduler.connect(conn_id);
+    else
+        scheduler.disconnect(conn_id);
+    lock.unlock();
+    refreshMinMTU();
+}
+
+void BluetoothMIDI_Interface::updateConnectionInterval(uint16_t conn_id,
+                                                       uint16_t interval) {
+    lock_t lock(scheduler_mtx);
+    scheduler.setConnectionInterval(conn_id, interval,
+                                    BLEMIDIScheduler::clock::now());
+    DEBUGFN(NAMEDVALUE(conn_id) << ", " << NAMEDVALUE(interval));
 }
 
 void BluetoothMIDI_Interface::forceMinMTU(uint16_t mtu) {
     force_min_mtu = mtu;
-    updateMTU(min_mtu);
+    refreshMinMTU();
+}
+
+void BluetoothMIDI_Interface::setConnectionIntervalBudget(
+    std::chrono::microseconds budget) {
+    lock_t lock(scheduler_mtx);
+    scheduler.setIntervalBudget(budget);
+}
+
+void BluetoothMIDI_Interface::setFlushMargin(std::chrono::microseconds margin) {
+    lock_t lock(scheduler_mtx);
+    scheduler.setFlushMargin(margin);
+}
+
+std::chrono::microseconds
+BluetoothMIDI_Interface::getConnectionInterval() const {
+    lock_t lock(scheduler_mtx);
+    return scheduler.getConnectionInterval();
+}
+
+BLEMIDIScheduler::Statistics
+BluetoothMIDI_Interface::getNotificationStatistics() const {
+    lock_t lock(scheduler_mtx);
+    return scheduler.getStatistics();
+}
+
+void BluetoothMIDI_Interface::resetNotificationStatistics() {
+    lock_t lock(scheduler_mtx);
+    scheduler.resetStatistics();
 }
 
 // -------------------------------------------------------------------------- //
 
-extern "C" void BluetoothMIDI_Interface_midi_mtu_callback(uint16_t mtu) {
-    BluetoothMIDI_Interface::midi_mtu_callback(mtu);
+extern "C" void BluetoothMIDI_Interface_midi_mtu_callback(uint16_t conn_id,
+                                                          uint16_t mtu) {
+    BluetoothMIDI_Interface::midi_mtu_callback(conn_id, mtu);
+}
+
+extern "C" void
+BluetoothMIDI_Interface_midi_connection_callback(uint16_t conn_id,
+                                                 bool connected) {
+    BluetoothMIDI_Interface::midi_connection_callback(conn_id, connected);
+}
+
+extern "C" void
+BluetoothMIDI_Interface_midi_conn_interval_callback(uint16_t conn_id,
+                                                    uint16_t interval) {
+    BluetoothMIDI_Interface::midi_conn_interval_callback(conn_id, interval);
 }
 
 extern "C" void BluetoothMIDI_Interface_midi_write_callback(const uint8_t *data,
@@ -305,6 +529,10 @@ void BluetoothMIDI_Interface::setName(const char *name) {
 void BluetoothMIDI_Interface::begin() {
 #ifdef ARDUINO
     midi_set_mtu_callback(BluetoothMIDI_Interface_midi_mtu_callback);
+    midi_set_connection_callback(
+        BluetoothMIDI_Interface_midi_connection_callback);
+    midi_set_conn_interval_callback(
+        BluetoothMIDI_Interface_midi_conn_interval_callback);
     midi_set_write_callback(BluetoothMIDI_Interface_midi_write_callback);
     DEBUGFN(F("Initializing BLE MIDI Interface"));
     if (!midi_init()) {
@@ -328,6 +556,8 @@ void BluetoothMIDI_Interface::end() {
 // -------------------------------------------------------------------------- //
 
 BluetoothMIDI_Interface *BluetoothMIDI_Interface::instance = nullptr;
+constexpr size_t BluetoothMIDI_Interface::SendRecordHeaderSize;
+constexpr size_t BluetoothMIDI_Interface::SendRecordMaxSize;
 
 END_CS_NAMESPACE
 
@@ -3,9 +3,11 @@
 #include <AH/Error/Error.hpp>
 
 #include "BLEMIDI/BLEMIDIPacketBuilder.hpp"
+#include "BLEMIDI/BLEMIDIScheduler.hpp"
 #include "BLEMIDI/MIDIMessageQueue.hpp"
 #include "MIDI_Interface.hpp"
 #include "Util/ESP32Threads.hpp"
+#include "Util/SPSCByteRing.hpp"
 #include <MIDI_Parsers/BLEMIDIParser.hpp>
 #include <MIDI_Parsers/SerialMIDI_Parser.hpp>
 
@@ -24,6 +26,19 @@ BEGIN_CS_NAMESPACE
 /**
  * @brief   Bluetooth Low Energy MIDI Interface for the ESP32.
  * 
+ * Sending doesn't block: outgoing messages are written to a buffer of
+ * @ref BLE_SEND_BUFFER_SIZE bytes, and sent by a background thread. When the
+ * BLE connection can't keep up and the buffer is full, new messages (including
+ * Channel messages) are silently dropped, and counted in
+ * @ref getDroppedMessages(). A dropped Note Off message results in a stuck
+ * note, so callers that can't afford to lose messages must check
+ * @ref getSendBufferSpace() before sending.
+ * 
+ * System Exclusive messages are only sent if they fit in the buffer as a
+ * whole. The exception are messages longer than @ref getMaxSysExLength()
+ * (e.g. bulk dumps), which can never fit at once: they are sent in pieces,
+ * and sending them blocks until the last piece has been added to the buffer.
+ * 
  * @ingroup MIDIInterfaces
  */
 class BluetoothMIDI_Interface : public MIDI_Interface {
@@ -41,20 +56,87 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
     }
 
   public:
-    /// Send the buffered MIDI BLE packet immediately.
-    void flush() {
-        lock_t lock(mtx);
-        flushImpl(lock);
-    }
+    /// Tell the background sender thread to send the buffered MIDI BLE packet
+    /// as soon as possible. Doesn't wait for the packet to be sent.
+    void flush();
+
+    /// Send the buffered MIDI BLE packet immediately, and wait until all
+    /// messages sent before this call have been handed to the BLE stack.
+    /// @return False if the sender thread didn't finish in time, or if it
+    ///         isn't running.
+    bool flushAndWait(
+        std::chrono::milliseconds timeout = std::chrono::milliseconds{100});
 
     /// Set the timeout, the number of milliseconds to buffer the outgoing MIDI
     /// messages. A shorter timeout usually results in lower latency, but also
     /// causes more overhead, because more packets might be required.
     void setTimeout(std::chrono::milliseconds timeout) {
-        lock_t lock(mtx);
-        this->timeout = timeout;
+        this->timeout = timeout.count();
     }
 
+    /**
+     * @brief   Set the connection interval to schedule the packets for, as
+     *          long as the client didn't report the negotiated interval.
+     *
+     * When the connection interval is known, packets are filled with as many
+     * messages as possible, and sent just before the next connection event,
+     * instead of after the fixed timeout (see @ref setTimeout()).
+     * Zero (the default) uses the fixed timeout until the interval is known.
+     */
+    void setConnectionIntervalBudget(std::chrono::microseconds budget);
+    /// Set how long before the estimated connection event the packet is handed
+    /// to the BLE stack (default 2 ms).
+    void setFlushMargin(std::chrono::microseconds margin);
+    /// Get the connection interval the packets are scheduled for, zero if
+    /// there is none.
+    std::chrono::microseconds getConnectionInterval() const;
+    /// Get the statistics about the notifications that were sent: the average
+    /// number of bytes per notification, and the queueing delay, i.e. the
+    /// time between adding the first message to a packet and sending it.
+    BLEMIDIScheduler::Statistics getNotificationStatistics() const;
+    /// Reset the notification statistics.
+    void resetNotificationStatistics();
+
+    /// Get the number of outgoing messages that were dropped because the send
+    /// buffer was full, i.e. because the BLE connection couldn't keep up.
+    size_t getDroppedMessages() const { return dropped_messages; }
+    /// Get the number of bytes that are available in the send buffer. Every
+    /// message takes four bytes of overhead (for every 255 bytes of SysEx
+    /// data).
+    size_t getSendBufferSpace() const { return send_ring.writeAvailable(); }
+    /// Get the length of the longest System Exclusive message that fits in the
+    /// send buffer at once. Longer messages are sent in pieces, which blocks
+    /// until the sender thread has made room for all of them. (504 bytes with
+    /// the default @ref BLE_SEND_BUFFER_SIZE.)
+    size_t getMaxSysExLength() const;
+
+    /// @name   Incoming SysEx buffer statistics
+    /// Incoming System Exclusive data is buffered in a storage of
+    /// @ref BLE_SYSEX_QUEUE_SIZE bytes until it is read by the main loop.
+    /// @{
+
+    /// Get the total number of bytes available for incoming SysEx data.
+    size_t getSysExReceiveCapacity() const { return queue.getSysExCapacity(); }
+    /// Get the number of bytes of incoming SysEx data that are currently
+    /// buffered (including the last message that was read).
+    size_t getSysExReceiveUsage() const { return queue.getSysExUsage(); }
+    /// Get the maximum number of bytes of incoming SysEx data that were
+    /// buffered at the same time.
+    size_t getSysExReceivePeakUsage() const {
+        return queue.getSysExPeakUsage();
+    }
+    /// Get the number of times an incoming SysEx message had to wait because
+    /// the SysEx buffer was full, i.e. because the main loop didn't read the
+    /// incoming messages fast enough.
+    size_t getSysExOverflowCount() const {
+        return queue.getSysExOverflowCount();
+    }
+    /// Get the number of incoming SysEx messages that were dropped because
+    /// they were larger than the entire SysEx buffer.
+    size_t getSysExDroppedCount() const { return queue.getSysExDroppedCount(); }
+
+    /// @}
+
   public:
     /// Set the BLE device name. Must be called before @ref begin().
     void setName(const char *name);
@@ -90,8 +172,6 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
     void sendRealTimeImpl(RealTimeMessage) override;
     void sendNowImpl() override { flush(); }
 
-    void sendChannelMessageImpl3Bytes(ChannelMessage);
-    void sendChannelMessageImpl2Bytes(ChannelMessage);
 
   public:
     void parse(const uint8_t *const data, const size_t len);
@@ -104,9 +184,24 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
     /// @see    @ref forceMinMTU()
     std::atomic_uint_fast16_t force_min_mtu{0};
 
-    /// Set the maximum transmission unit of the Bluetooth link. Used to compute
-    /// the MIDI BLE packet size.
-    void updateMTU(uint16_t mtu);
+    /// Keeps track of the MTU and connection interval of all connections, and
+    /// computes when packets should be sent.
+    BLEMIDIScheduler scheduler;
+    /// Protects @ref scheduler, which is updated from the BLE stack's thread
+    /// and used by the sender thread.
+    mutable std::mutex scheduler_mtx;
+
+    /// Set the maximum transmission unit of the Bluetooth link with the given
+    /// client. Used to compute the MIDI BLE packet size.
+    void updateMTU(uint16_t conn_id, uint16_t mtu);
+    /// Start or stop tracking the MTU and interval of the given client.
+    void updateConnection(uint16_t conn_id, bool connected);
+    /// Set the connection interval of the link with the given client, in units
+    /// of 1.25 ms.
+    void updateConnectionInterval(uint16_t conn_id, uint16_t interval);
+    /// Recompute @ref min_mtu from the MTUs of all clients and
+    /// @ref force_min_mtu.
+    void refreshMinMTU();
 
   public:
     /// Get the minimum MTU of all connected clients.
@@ -120,52 +215,103 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
     static BluetoothMIDI_Interface *instance;
     /// MIDI Parser for incoming data.
     SerialMIDI_Parser parser{false};
-    /// Builds outgoing MIDI BLE packets.
+    /// Builds outgoing MIDI BLE packets. Only used by the sender thread.
     BLEMIDIPacketBuilder packetbuilder;
     /// Queue for incoming MIDI messages.
     MIDIMessageQueue queue{64};
+    /// Priority lane for incoming Real-Time messages, they are read before the
+    /// messages in @ref queue. Every record consists of the Real-Time byte
+    /// and two bytes of timestamp.
+    SPSCByteRing rt_receive_ring{3 * 16};
     /// Incoming message that can be from retrieved using the
     /// `getChannelMessage()`, `getSysCommonMessage()`, `getRealTimeMessage()`
     /// and `getSysExMessage()` methods.
     MIDIMessageQueue::MIDIMessageQueueElement incomingMessage;
 
   private:
-    // Synchronization for asynchronous BLE sending
+    // Asynchronous BLE sending
+
+    /// The types of records in the send ring.
+    enum SendRecordType : uint8_t {
+        SendChannelMessage3B,
+        SendChannelMessage2B,
+        SendRealTimeMessage,
+        SendSysCommonMessage,
+        SendSysExChunk,
+    };
+    /// The size of the header of a record in the send ring: type, length and
+    /// two bytes of timestamp.
+    constexpr static size_t SendRecordHeaderSize = 4;
+    /// The maximum number of data bytes in a single record.
+    constexpr static size_t SendRecordMaxSize = 0xFF;
+
+    /// Outgoing messages, written by the main thread and read by the sender
+    /// thread, without locking.
+    SPSCByteRing send_ring{BLE_SEND_BUFFER_SIZE};
+    /// Priority lane for outgoing Real-Time messages. The sender thread adds
+    /// them to the packet before the messages in @ref send_ring, and even
+    /// in between the continuation packets of a long SysEx message. Every
+    /// record consists of the Real-Time byte and two bytes of timestamp.
+    SPSCByteRing rt_send_ring{3 * 16};
+    /// Number of messages that didn't fit in the send ring.
+    size_t dropped_messages = 0;
+    /// Data of the record that is being added to the packet by the sender
+    /// thread.
+    uint8_t send_record[SendRecordMaxSize];
 
     /// Lock type used to lock the mutex
     using lock_t = std::unique_lock<std::mutex>;
-    /// Mutex to lock the MIDI BLE packet builder and the flush flag.
+    /// Mutex used by the sender thread to sleep while there's no data. It
+    /// doesn't protect any data, the main thread never blocks on it when
+    /// sending.
     std::mutex mtx;
-    /// Condition variable used by the background sender thread to wait for
-    /// data to send, and for the main thread to wait for the data to be flushed
-    /// by the sender thread.
+    /// Condition variable used to wake up the background sender thread.
     std::condition_variable cv;
+    /// Condition variable used by the sender thread to notify
+    /// @ref flushAndWait that a flush request was handled.
+    std::condition_variable flushed_cv;
     /// Background thread that sends the actual MIDI BLE packets.
     std::thread send_thread;
     /// Flag to stop the background thread.
     std::atomic_bool stop_sending{false};
-    /// Flag to tell the sender thread to send the packet immediately.
-    bool flushnow = false;
-    /// Timeout before the sender thread sends a packet.
+    /// Number of flush requests by the main thread.
+    std::atomic_uint_fast32_t flush_requests{0};
+    /// Number of flush requests handled by the sender thread.
+    uint_fast32_t flushes_done = 0;
+    /// Timeout in milliseconds before the sender thread sends a packet.
     /// @see    @ref setTimeout()
-    std::chrono::milliseconds timeout{10};
+    std::atomic_uint_fast32_t timeout{10};
+    /// Time at which the first message was added to the current packet.
+    /// (Sender thread only.)
+    BLEMIDIScheduler::time_point packet_start;
 
   private:
     /// Launch a thread that sends the BLE packets in the background.
     void startSendingThread();
 
-    /// Function that waits for BLE packets and sends them in the background.
-    /// It either sends them after a timeout (a given number of milliseconds
-    /// after the first data was added to the packet), or immediately when it
-    /// receives a flush signal from the main thread.
+    /// Function that waits for outgoing messages and sends them in the
+    /// background. It either sends them just before the next connection event
+    /// (or after a timeout if the connection interval is unknown), when the
+    /// packet is full, or immediately when it receives a flush signal from
+    /// the main thread.
     bool handleSendEvents();
 
-    /// Tell the background BLE sender thread to send the current packet.
-    /// Blocks until the packet is sent.
-    ///
-    /// @param  lock
-    ///         Lock should be locked at entry, will still be locked on exit.
-    void flushImpl(lock_t &lock);
+    /// Add a message to the send ring. Returns false if it doesn't fit, the
+    /// main thread never waits for the sender thread.
+    bool pushSendRecord(SendRecordType type, uint16_t timestamp,
+                        const uint8_t *data, size_t length);
+    /// Move all messages from the send ring to the packet builder, sending
+    /// the packet whenever it is full. (Sender thread only.)
+    void drainSendRing();
+    /// Move all Real-Time messages from the priority lane to the packet
+    /// builder. (Sender thread only.)
+    void drainRealTimeSendRing();
+    /// Add a single message to the current packet. (Sender thread only.)
+    void addToPacket(SendRecordType type, uint16_t timestamp,
+                     const uint8_t *data, size_t length);
+    /// Send the current packet (if not empty) and start a new one. (Sender
+    /// thread only.)
+    void sendPacket();
 
 #if !defined(ARDUINO) && !defined(DOXYGEN)
     public:
@@ -179,9 +325,20 @@ class BluetoothMIDI_Interface : public MIDI_Interface {
             instance->parse(data, length);
     }
 
-    static void midi_mtu_callback(uint16_t mtu) {
+    static void midi_mtu_callback(uint16_t conn_id, uint16_t mtu) {
+        if (instance)
+            instance->updateMTU(conn_id, mtu);
+    }
+
+    static void midi_connection_callback(uint16_t conn_id, bool connected) {
+        if (instance)
+            instance->updateConnection(conn_id, connected);
+    }
+
+    static void midi_conn_interval_callback(uint16_t conn_id,
+                                            uint16_t interval) {
         if (instance)
-            instance->updateMTU(mtu);
+            instance->updateConnectionInterval(conn_id, interval);
     }
 
 #ifdef ARDUINO
@@ -0,0 +1,81 @@
+#include "ControlChangeCoalescer.hpp"
+
+BEGIN_CS_NAMESPACE
+
+bool BaseControlChangeCoalescer::update(ChannelMessage msg,
+                                        unsigned long now) {
+    if (msg.getMessageType() != MIDIMessageType::CONTROL_CHANGE)
+        return true;
+    uint8_t channelCable = pack(msg.getChannelCable());
+    uint8_t controller = msg.getData1();
+    Entry *entry = find(channelCable, controller);
+    if (entry == nullptr) {
+        // First message to this address in a while, send it right away
+        entry = allocate(now);
+        if (entry == nullptr) {
+            ++untracked;
+            return true;
+        }
+        *entry = {now, channelCable, controller, 0, true, false};
+        return true;
+    }
+    if (now - entry->lastSent >= interval) {
+        entry->lastSent = now;
+        entry->pending = false;
+        return true;
+    }
+    if (entry->pending)
+        ++coalesced;
+    entry->value = msg.getData2();
+    entry->pending = true;
+    return false;
+}
+
+bool BaseControlChangeCoalescer::poll(unsigned long now, ChannelMessage &msg,
+                                      bool force) {
+    for (uint8_t i = 0; i < capacity; ++i) {
+        Entry &entry = entries[i];
+        if (entry.pending && (force || now - entry.lastSent >= interval)) {
+            msg = {
+                MIDIMessageType::CONTROL_CHANGE,
+                Channel(entry.channelCable & 0x0F),
+                entry.controller,
+                entry.value,
+                Cable(entry.channelCable >> 4),
+            };
+            entry.lastSent = now;
+            entry.pending = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+void BaseControlChangeCoalescer::reset() {
+    for (uint8_t i = 0; i < capacity; ++i)
+        entries[i] = {0, 0, 0, 0, false, false};
+}
+
+auto BaseControlChangeCoalescer::find(uint8_t channelCable, uint8_t controller)
+    -> Entry * {
+    for (uint8_t i = 0; i < capacity; ++i) {
+        Entry &entry = entries[i];
+        if (entry.used && entry.channelCable == channelCable &&
+            entry.controller == controller)
+            return &entry;
+    }
+    return nullptr;
+}
+
+auto BaseControlChangeCoalescer::allocate(unsigned long now) -> Entry * {
+    // Addresses that have nothing pending and whose interval has passed can
+    // be forgotten, since their next message would be sent right away anyway
+    for (uint8_t i = 0; i < capacity; ++i) {
+        Entry &entry = entries[i];
+        if (!entry.used || (!entry.pending && now - entry.lastSent >= interval))
+            return &entry;
+    }
+    return nullptr;
+}
+
+END_CS_NAMESPACE
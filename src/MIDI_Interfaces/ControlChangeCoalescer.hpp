@@ -0,0 +1,159 @@
+#pragma once
+
+#include <MIDI_Parsers/MIDI_MessageTypes.hpp>
+
+BEGIN_CS_NAMESPACE
+
+/**
+ * @brief   Limits the rate at which Control Change messages are sent to each
+ *          address, by holding back intermediate values.
+ *
+ * When a potentiometer or fader is moved quickly, it can generate many more
+ * Control Change messages than a slow MIDI link (e.g. 5-pin DIN MIDI at 31250
+ * baud, or Bluetooth) can handle. The coalescer keeps track of the time at
+ * which the last message was sent for each (cable, channel, controller)
+ * combination. If a new value arrives within the minimum interval, it is not
+ * sent, but remembered instead, replacing any older value that was held back.
+ * The latest value is sent as soon as the interval has passed, so the final
+ * position is never lost.
+ *
+ * Only Control Change messages are affected, all other messages are sent
+ * immediately. Note that a held back value can be overtaken by other messages
+ * that are sent later.
+ *
+ * This class only contains the logic, the storage is provided by
+ * @ref ControlChangeCoalescer.
+ */
+class BaseControlChangeCoalescer {
+  public:
+    /// The state of a single address.
+    struct Entry {
+        unsigned long lastSent;
+        uint8_t channelCable; ///< Cable number in the high nibble.
+        uint8_t controller;
+        uint8_t value; ///< The value that is held back.
+        bool used;
+        bool pending; ///< Whether a value is held back.
+    };
+
+  protected:
+    BaseControlChangeCoalescer(Entry *entries, uint8_t capacity,
+                               unsigned long interval)
+        : entries(entries), capacity(capacity), interval(interval) {
+        reset();
+    }
+
+  public:
+    BaseControlChangeCoalescer(const BaseControlChangeCoalescer &) = delete;
+    BaseControlChangeCoalescer &
+    operator=(const BaseControlChangeCoalescer &) = delete;
+
+    /**
+     * @brief   Decide whether the given message can be sent now.
+     *
+     * @param   msg
+     *          The outgoing MIDI message.
+     * @param   now
+     *          The current time in milliseconds.
+     *
+     * @retval  true
+     *          The message should be sent now.
+     * @retval  false
+     *          The message was held back, it will be returned by @ref poll
+     *          later (unless it's replaced by a newer value first).
+     */
+    bool update(ChannelMessage msg, unsigned long now);
+
+    /**
+     * @brief   Get a held back message whose interval has passed.
+     *
+     * Should be called regularly. Every call returns at most one message, so
+     * it should be called until it returns false.
+     *
+     * @param   now
+     *          The current time in milliseconds.
+     * @param   msg
+     *          Output: the message to send.
+     *
+     * @return  True if a message should be sent, false otherwise.
+     */
+    bool poll(unsigned long now, ChannelMessage &msg) {
+        return poll(now, msg, false);
+    }
+    /// Get a held back message, regardless of the interval. Call until it
+    /// returns false.
+    bool flush(ChannelMessage &msg) { return poll(0, msg, true); }
+
+    /// Forget all addresses and discard the values that are held back.
+    void reset();
+
+    /// Set the minimum time between two messages to the same address (in
+    /// milliseconds).
+    void setInterval(unsigned long interval) { this->interval = interval; }
+    /// Get the minimum time between two messages to the same address (in
+    /// milliseconds).
+    unsigned long getInterval() const { return interval; }
+
+    /// Get the number of messages that were replaced by a newer value before
+    /// they could be sent.
+    uint32_t getCoalescedCount() const { return coalesced; }
+    /// Get the number of messages that were sent immediately because there
+    /// was no room to keep track of their address.
+    uint32_t getUntrackedCount() const { return untracked; }
+
+  private:
+    static uint8_t pack(MIDIChannelCable cc) {
+        return (cc.getRawCableNumber() << 4) | cc.getRawChannel();
+    }
+    bool poll(unsigned long now, ChannelMessage &msg, bool force);
+    Entry *find(uint8_t channelCable, uint8_t controller);
+    Entry *allocate(unsigned long now);
+
+  private:
+    Entry *entries;
+    uint8_t capacity;
+    unsigned long interval;
+    uint32_t coalesced = 0;
+    uint32_t untracked = 0;
+};
+
+/**
+ * @brief   Limits the rate at which Control Change messages are sent to each
+ *          address, with statically allocated storage.
+ *
+ * ~~~cpp
+ * USBDebugMIDI_Interface midi;
+ * // Send at most one message every 20 ms per controller, keeping track of
+ * // up to 16 controllers at once.
+ * ControlChangeCoalescer<16> coalescer {20};
+ *
+ * void setup() {
+ *     midi.setControlChangeCoalescer(coalescer);
+ *     Control_Surface.begin();
+ * }
+ * ~~~
+ *
+ * @tparam  Capacity
+ *          The maximum number of addresses to keep track of at the same time.
+ *          If more addresses are active within a single interval, the
+ *          messages for the excess addresses are sent without limiting their
+ *          rate.
+ *
+ * @ingroup MIDIInterfaces
+ */
+template <uint8_t Capacity>
+class ControlChangeCoalescer : public BaseControlChangeCoalescer {
+    static_assert(Capacity > 0, "Capacity should be at least one");
+
+  public:
+    /// @param  interval
+    ///         The minimum time between two messages to the same address (in
+    ///         milliseconds).
+    ControlChangeCoalescer(unsigned long interval)
+        : BaseControlChangeCoalescer(entries, Capacity, interval) {}
+
+  private:
+    Entry entries[Capacity];
+};
+
+END_CS_NAMESPACE
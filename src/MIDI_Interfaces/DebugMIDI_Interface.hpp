@@ -53,6 +53,7 @@ class StreamDebugMIDI_Output : public StreamDebugMIDI_Base,
     void sendRealTimeImpl(RealTimeMessage);
     void sendNowImpl();
 
+    friend struct StaticMIDI_RouterDetail::SinkAccess;
     void sinkMIDIfromPipe(ChannelMessage m) override { send(m); }
     void sinkMIDIfromPipe(SysExMessage m) override { send(m); }
     void sinkMIDIfromPipe(SysCommonMessage m) override { send(m); }
@@ -221,6 +222,7 @@ class StreamDebugMIDI_Interface : public StreamDebugMIDI_Base,
 
   private:
     void handleStall() override;
+    MIDI_Parser *getRealTimeLaneParser() override { return &parser; }
 
   private:
     HexPuller<StreamPuller> hexstream;
@@ -28,6 +28,73 @@ MIDI_Interface *MIDI_Interface::getDefault() {
 
 MIDI_Interface *MIDI_Interface::DefaultMIDI_Interface = nullptr;
 
+void MIDI_Interface::flushAllAtLoopEnd() {
+    for (auto &el : updatables) {
+        auto &iface = DOWN_CAST<MIDI_Interface &>(el);
+        iface.sendCoalescedMessages();
+        iface.flushAtLoopEnd();
+    }
+}
+
+// -------------------------------------------------------------------------- //
+
+// Limiting the rate of Control Change messages
+
+void MIDI_Interface::sinkMIDIfromPipe(ChannelMessage msg) {
+    if (coalescer == nullptr || coalescer->update(msg, millis()))
+        send(msg);
+}
+
+void MIDI_Interface::setControlChangeCoalescer(
+    BaseControlChangeCoalescer *coalescer) {
+    // Don't lose the final values held back by the previous coalescer
+    sendCoalescedMessages(true);
+    this->coalescer = coalescer;
+}
+
+void MIDI_Interface::sendCoalescedMessages(bool all) {
+    if (coalescer == nullptr)
+        return;
+    unsigned long now = millis();
+    ChannelMessage msg = {0x00, 0x00, 0x00};
+    while (all ? coalescer->flush(msg) : coalescer->poll(now, msg))
+        send(msg);
+}
+
+// -------------------------------------------------------------------------- //
+
+// Handling stalled pipes
+
+bool MIDI_Interface::deferIncoming() {
+    if (stallMode != StallMode::Cooperative)
+        return false;
+    bool stalled = isStalled();
+    if (!stalled && !waitingForStall)
+        return false;
+    unsigned long now = millis();
+    if (!waitingForStall) {
+        waitingForStall = true;
+        stallStart = now;
+    }
+    unsigned long duration = now - stallStart;
+    if (stalled && duration < SYSEX_CHUNK_TIMEOUT) {
+        ++deferredUpdates;
+        return true;
+    }
+    // Either the stall is over, or it took too long and we'll block until
+    // the staller is done
+    waitingForStall = false;
+    if (duration > longestStall)
+        longestStall = duration;
+    return false;
+}
+
+void MIDI_Interface::resetStallStatistics() {
+    longestStall = 0;
+    deferredUpdates = 0;
+    droppedStalls = 0;
+}
+
 // -------------------------------------------------------------------------- //
 
 // Handling incoming MIDI events
@@ -51,9 +118,25 @@ void MIDI_Interface::onSysCommonMessage(SysCommonMessage message) {
 }
 
 void MIDI_Interface::onRealTimeMessage(RealTimeMessage message) {
+    if (realTimeCallback)
+        realTimeCallback(*this, message);
     sourceMIDItoPipe(message);
     if (callbacks)
         callbacks->onRealTimeMessage(*this, message);
 }
 
+// -------------------------------------------------------------------------- //
+
+// Real-Time priority lane
+
+void MIDI_Interface::setRealTimeCallback(RealTimeCallback cb) {
+    realTimeCallback = cb;
+    if (MIDI_Parser *parser = getRealTimeLaneParser())
+        parser->setRealTimeHandler(cb ? onRealTimeLane : nullptr, this);
+}
+
+void MIDI_Interface::onRealTimeLane(void *iface, RealTimeMessage message) {
+    static_cast<MIDI_Interface *>(iface)->onRealTimeMessage(message);
+}
+
 END_CS_NAMESPACE
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ControlChangeCoalescer.hpp"
 #include "MIDI_Pipes.hpp"
 #include "MIDI_Sender.hpp"
 #include "MIDI_Staller.hpp"
@@ -33,6 +34,12 @@ class MIDI_Interface : public TrueMIDI_SinkSource,
     void begin() override {}
     /// Read the MIDI interface and call the callback if a message was received.
     void update() override = 0;
+    /// Send any outgoing MIDI messages that were buffered until the end of the
+    /// main loop. Called by `Control_Surface.loop()`.
+    virtual void flushAtLoopEnd() {}
+    /// Send the Control Change messages held back by the coalescer, and call
+    /// @ref flushAtLoopEnd for all MIDI interfaces.
+    static void flushAllAtLoopEnd();
 
     /// @name   Default MIDI Interfaces
     /// @{
@@ -63,8 +70,102 @@ class MIDI_Interface : public TrueMIDI_SinkSource,
 
     /// @}
 
+    /// @name   Real-Time priority lane
+    /// @{
+
+    /// Function that is called for every incoming MIDI Real-Time message.
+    using RealTimeCallback = void (*)(MIDI_Interface &, RealTimeMessage);
+
+    /**
+     * @brief   Handle incoming Real-Time messages (e.g. MIDI clock) in a
+     *          priority lane.
+     *
+     * The given function is called for every incoming Real-Time message,
+     * before the message is sent to the pipes and to the normal callbacks.
+     * For interfaces that parse their input in the main loop (Serial and
+     * USB), the parser hands Real-Time messages to the interface immediately,
+     * as soon as they are parsed, even in the middle of a System Exclusive
+     * message. Interfaces that receive their data in a different thread (BLE)
+     * deliver Real-Time messages before any other queued messages.
+     *
+     * @param   cb
+     *          The function to call, or `nullptr` to disable the priority
+     *          lane.
+     */
+    void setRealTimeCallback(RealTimeCallback cb);
+    /// Get the function that is called for incoming Real-Time messages.
+    RealTimeCallback getRealTimeCallback() const { return realTimeCallback; }
+
+    /// @}
+
+    /// @name   Limiting the rate of Control Change messages
+    /// @{
+
+    /// Limit the rate of the Control Change messages that are sent to this
+    /// interface through its pipes (e.g. by Control_Surface).
+    /// Intermediate values are held back by the given coalescer, the held back
+    /// values are sent by @ref sendCoalescedMessages.
+    /// Pass `nullptr` to disable rate limiting.
+    void setControlChangeCoalescer(BaseControlChangeCoalescer *coalescer);
+    /// @copydoc setControlChangeCoalescer
+    void setControlChangeCoalescer(BaseControlChangeCoalescer &coalescer) {
+        setControlChangeCoalescer(&coalescer);
+    }
+    /// Get the coalescer that limits the rate of Control Change messages.
+    BaseControlChangeCoalescer *getControlChangeCoalescer() const {
+        return coalescer;
+    }
+    /// Send the Control Change messages that were held back by the coalescer
+    /// and whose interval has passed. Called by `Control_Surface.loop()`.
+    /// @param  all
+    ///         Send all messages that are held back, regardless of the
+    ///         interval.
+    void sendCoalescedMessages(bool all = false);
+
+    /// @}
+
+    /// @name   Stall handling
+    /// @{
+
+    /// What to do with incoming messages while the pipes are stalled by
+    /// another MIDI source (e.g. another interface that is in the middle of
+    /// receiving a chunked System Exclusive message).
+    enum class StallMode : uint8_t {
+        /// Keep reading the source that stalled the pipes until its message
+        /// is finished, or until @ref SYSEX_CHUNK_TIMEOUT expires. This
+        /// blocks the main loop in the meantime.
+        Blocking,
+        /// Leave the incoming messages in the input buffer and return
+        /// immediately, they will be read during the next update, once the
+        /// pipes are no longer stalled. If the pipes are still stalled after
+        /// @ref SYSEX_CHUNK_TIMEOUT, fall back to blocking.
+        Cooperative,
+    };
+
+    /// Select how stalled pipes are handled when reading this interface.
+    void setStallMode(StallMode mode) { stallMode = mode; }
+    /// Get the way stalled pipes are handled when reading this interface.
+    StallMode getStallMode() const { return stallMode; }
+
+    /// Get the number of updates that were postponed because the pipes were
+    /// stalled by another source (only in cooperative mode).
+    uint32_t getDeferredUpdates() const { return deferredUpdates; }
+    /// Get the longest time (in milliseconds) this interface had to postpone
+    /// reading because of a stall (only in cooperative mode).
+    unsigned long getLongestStall() const { return longestStall; }
+    /// Get the number of times this interface stalled the pipes, and didn't
+    /// finish its chunked message within @ref SYSEX_CHUNK_TIMEOUT when it was
+    /// asked to. The rest of the message is then no longer protected against
+    /// other messages being interleaved with it.
+    uint16_t getDroppedStalls() const { return droppedStalls; }
+    /// Reset the stall statistics to zero.
+    void resetStallStatistics();
+
+    /// @}
+
   protected:
     friend class MIDI_Sender<MIDI_Interface>;
+    friend struct StaticMIDI_RouterDetail::SinkAccess;
     /// Low-level function for sending a MIDI channel voice message.
     virtual void sendChannelMessageImpl(ChannelMessage) = 0;
     /// Low-level function for sending a MIDI system common message.
@@ -78,7 +179,7 @@ class MIDI_Interface : public TrueMIDI_SinkSource,
 
   protected:
     /// Accept an incoming MIDI Channel message from the source pipe.
-    void sinkMIDIfromPipe(ChannelMessage msg) override { send(msg); }
+    void sinkMIDIfromPipe(ChannelMessage msg) override;
     /// Accept an incoming MIDI System Exclusive message from the source pipe.
     void sinkMIDIfromPipe(SysExMessage msg) override { send(msg); }
     /// Accept an incoming MIDI System Common message from the source pipe.
@@ -98,6 +199,16 @@ class MIDI_Interface : public TrueMIDI_SinkSource,
     /// pipe.
     void onRealTimeMessage(RealTimeMessage message);
 
+    /// Get the parser that should surface Real-Time messages directly to
+    /// this interface when the priority lane is enabled, or `nullptr` if the
+    /// interface doesn't parse its input in the main thread.
+    /// @see    setRealTimeCallback
+    virtual MIDI_Parser *getRealTimeLaneParser() { return nullptr; }
+
+  private:
+    /// Handler for the parser of the priority lane.
+    static void onRealTimeLane(void *iface, RealTimeMessage message);
+
   public:
     /// Read, parse and dispatch incoming MIDI messages on the given interface.
     template <class MIDIInterface_t>
@@ -108,11 +219,25 @@ class MIDI_Interface : public TrueMIDI_SinkSource,
     /// Un-stall the given MIDI interface. Assumes the interface has been
     /// stalled because of a chunked SysEx messages. Waits untill that message
     /// is finished.
+    /// @see    StallMode
     template <class MIDIInterface_t>
     static void handleStall(MIDIInterface_t *iface);
 
+  private:
+    /// Check whether reading incoming MIDI messages should be postponed
+    /// because the pipes are stalled by another source.
+    bool deferIncoming();
+
   private:
     MIDI_Callbacks *callbacks = nullptr;
+    RealTimeCallback realTimeCallback = nullptr;
+    BaseControlChangeCoalescer *coalescer = nullptr;
+    StallMode stallMode = StallMode::Blocking;
+    bool waitingForStall = false;
+    unsigned long stallStart = 0;
+    unsigned long longestStall = 0;
+    uint32_t deferredUpdates = 0;
+    uint16_t droppedStalls = 0;
 
   private:
     static MIDI_Interface *DefaultMIDI_Interface;
@@ -122,6 +247,8 @@ template <class MIDIInterface_t>
 void MIDI_Interface::updateIncoming(MIDIInterface_t *iface) {
     if (iface->getStaller() == iface)
         iface->unstall(iface);
+    if (iface->deferIncoming())
+        return;
     bool chunked = false;
     MIDIReadEvent event = iface->read();
     while (event != MIDIReadEvent::NO_MESSAGE) {
@@ -134,9 +261,11 @@ void MIDI_Interface::updateIncoming(MIDIInterface_t *iface) {
     }
     if (chunked)
         iface->stall(iface);
-    // TODO: add logic to detect MIDI messages such as (N)RPN that span over
-    // multiple channel voice messages and that shouldn't be interrupted.
-    // For short messages such as (N)RPN, I suggest waiting with a timeout.
+    // (N)RPN messages that span over multiple channel voice messages are not
+    // combined here, because the individual Control Change messages still
+    // have to be routed through the pipes. They are assembled by the sink,
+    // see ParameterNumberAssembler and
+    // Control_Surface_::setParameterNumberAssembly.
 }
 
 template <class MIDIInterface_t>
@@ -174,6 +303,7 @@ void MIDI_Interface::handleStall(MIDIInterface_t *iface) {
         else if (event == MIDIReadEvent::SYSEX_MESSAGE)
             return;
     }
+    ++iface->droppedStalls;
     DEBUGREF(F("Warning: Unable to un-stall pipes: ")
              << iface->getStallerName());
 }
@@ -13,6 +13,11 @@ AH_DIAGNOSTIC_WERROR()
 BEGIN_CS_NAMESPACE
 
 struct MIDIStaller;
+/// @cond
+namespace StaticMIDI_RouterDetail {
+struct SinkAccess;
+} // namespace StaticMIDI_RouterDetail
+/// @endcond
 MIDIStaller *const eternal_stall =
     reinterpret_cast<MIDIStaller *>(std::numeric_limits<std::uintptr_t>::max());
 
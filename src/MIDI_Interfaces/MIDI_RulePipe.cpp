@@ -0,0 +1,101 @@
+#include "MIDI_RulePipe.hpp"
+
+BEGIN_CS_NAMESPACE
+
+MIDI_Rule &MIDI_Rule::matchTypes(std::initializer_list<MIDIMessageType> ts) {
+    types = 0;
+    for (MIDIMessageType type : ts)
+        types |= 1u << typeIndex(type);
+    return *this;
+}
+
+MIDI_Rule &MIDI_Rule::matchChannels(std::initializer_list<Channel> chs) {
+    channels = 0;
+    for (Channel channel : chs)
+        channels |= 1u << channel.getRaw();
+    return *this;
+}
+
+MIDI_Rule &MIDI_Rule::matchCables(std::initializer_list<Cable> cbs) {
+    cables = 0;
+    for (Cable cable : cbs)
+        cables |= 1u << cable.getRaw();
+    return *this;
+}
+
+MIDI_Rule &MIDI_Rule::matchData1(uint8_t min, uint8_t max) {
+    data1Min = min;
+    data1Max = max;
+    return *this;
+}
+
+MIDI_Rule &MIDI_Rule::matchData2(uint8_t min, uint8_t max) {
+    data2Min = min;
+    data2Max = max;
+    return *this;
+}
+
+MIDI_Rule &MIDI_Rule::drop() {
+    action = Drop;
+    return *this;
+}
+
+MIDI_Rule &MIDI_Rule::copy() {
+    action = Copy;
+    return *this;
+}
+
+MIDI_Rule &MIDI_Rule::setChannel(Channel channel) {
+    newChannel = channel.getRaw();
+    return *this;
+}
+
+MIDI_Rule &MIDI_Rule::transpose(int8_t semitones) {
+    this->semitones = semitones;
+    return *this;
+}
+
+MIDI_Rule &MIDI_Rule::rescale(uint8_t min, uint8_t max) {
+    rescaling = true;
+    rescaleMin = min;
+    rescaleMax = max;
+    return *this;
+}
+
+bool MIDI_Rule::matchesData(ChannelMessage msg) const {
+    return (cables & (1u << msg.getCable().getRaw())) &&
+           msg.data1 >= data1Min && msg.data1 <= data1Max &&
+           msg.data2 >= data2Min && msg.data2 <= data2Max;
+}
+
+bool MIDI_Rule::matches(ChannelMessage msg) const {
+    return (types & (1u << typeIndex(msg.getMessageType()))) &&
+           (channels & (1u << msg.getChannel().getRaw())) && matchesData(msg);
+}
+
+bool MIDI_Rule::apply(ChannelMessage &msg) const {
+    if (newChannel != NoChange)
+        msg.setChannel(Channel(newChannel));
+    auto type = msg.getMessageType();
+    if (semitones != 0 && type <= MIDIMessageType::KEY_PRESSURE) {
+        int16_t note = int16_t(msg.data1) + semitones;
+        if (note < 0 || note > 127)
+            return false;
+        msg.data1 = uint8_t(note);
+    }
+    if (rescaling) {
+        uint8_t &value = msg.hasTwoDataBytes() ? msg.data2 : msg.data1;
+        uint8_t inMin = msg.hasTwoDataBytes() ? data2Min : data1Min;
+        uint8_t inMax = msg.hasTwoDataBytes() ? data2Max : data1Max;
+        uint8_t inRange = inMax - inMin;
+        int16_t outRange = int16_t(rescaleMax) - int16_t(rescaleMin);
+        int16_t offset = inRange == 0 ? 0
+                                      : (int16_t(value - inMin) * outRange +
+                                         (outRange < 0 ? -1 : 1) * inRange / 2) /
+                                            inRange;
+        value = uint8_t(rescaleMin + offset);
+    }
+    return true;
+}
+
+END_CS_NAMESPACE
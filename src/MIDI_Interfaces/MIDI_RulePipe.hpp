@@ -0,0 +1,231 @@
+#pragma once
+
+#include "MIDI_Pipes.hpp"
+#include <AH/Error/Error.hpp>
+#include <AH/STL/initializer_list>
+#include <AH/STL/type_traits>
+
+AH_DIAGNOSTIC_WERROR()
+
+BEGIN_CS_NAMESPACE
+
+/// @addtogroup MIDI_Routing
+/// @{
+
+/**
+ * @brief   A rule that filters or transforms MIDI Channel messages traveling
+ *          through a @ref MIDI_RulePipe.
+ *
+ * A rule consists of a number of conditions and an action. By default, a rule
+ * matches all Channel messages, and forwards them unchanged. Conditions and
+ * transformations can be added using the builder functions:
+ *
+ * ~~~cpp
+ * // Move all notes below middle C on channel 1 to channel 2.
+ * MIDI_Rule()
+ *     .matchTypes({MIDIMessageType::NOTE_ON, MIDIMessageType::NOTE_OFF})
+ *     .matchChannels({CHANNEL_1})
+ *     .matchData1(0, 59)
+ *     .setChannel(CHANNEL_2);
+ * ~~~
+ */
+struct MIDI_Rule {
+    /// What to do with a message that matches the rule.
+    enum Action : uint8_t {
+        /// Forward the transformed message, and stop evaluating rules.
+        Map,
+        /// Forward a transformed copy of the message, and continue evaluating
+        /// the following rules with the original message. This can be used
+        /// to split a stream, e.g. to layer two channels.
+        Copy,
+        /// Drop the message.
+        Drop,
+    };
+
+    /// @name Conditions
+    /// @{
+
+    /// Only match messages of the given types.
+    MIDI_Rule &matchTypes(std::initializer_list<MIDIMessageType> types);
+    /// Only match messages on the given channels.
+    MIDI_Rule &matchChannels(std::initializer_list<Channel> channels);
+    /// Only match messages on the given cables.
+    MIDI_Rule &matchCables(std::initializer_list<Cable> cables);
+    /// Only match messages with a first data byte in the range [min, max].
+    MIDI_Rule &matchData1(uint8_t min, uint8_t max);
+    /// Only match messages with a second data byte in the range [min, max].
+    MIDI_Rule &matchData2(uint8_t min, uint8_t max);
+
+    /// @}
+
+    /// @name Actions
+    /// @{
+
+    /// Drop all matching messages.
+    MIDI_Rule &drop();
+    /// Forward the transformed messages, but keep the original as well.
+    MIDI_Rule &copy();
+    /// Change the channel of matching messages.
+    MIDI_Rule &setChannel(Channel channel);
+    /// Transpose Note On, Note Off and Key Pressure messages by the given
+    /// number of semitones. Notes that end up outside of the range [0, 127]
+    /// are dropped.
+    MIDI_Rule &transpose(int8_t semitones);
+    /// Linearly map the value byte (the second data byte, or the first one for
+    /// Program Change and Channel Pressure) from the matched range (see
+    /// @ref matchData2) to the range [min, max].
+    MIDI_Rule &rescale(uint8_t min, uint8_t max);
+
+    /// @}
+
+    /// Check the conditions that aren't already covered by the decision table
+    /// of the pipe (cable and data ranges).
+    bool matchesData(ChannelMessage msg) const;
+    /// Check all conditions.
+    bool matches(ChannelMessage msg) const;
+    /// Apply the transformations to the given message. Returns false if the
+    /// message should be dropped.
+    bool apply(ChannelMessage &msg) const;
+
+    /// Convert a channel message type to an index in [0, 6].
+    static uint8_t typeIndex(MIDIMessageType type) {
+        return (static_cast<uint8_t>(type) >> 4) - 0x8;
+    }
+
+    uint8_t types = 0x7F;      ///< Bit mask of @ref typeIndex values.
+    uint16_t channels = 0xFFFF; ///< Bit mask of channels.
+    uint16_t cables = 0xFFFF;   ///< Bit mask of cables.
+    uint8_t data1Min = 0, data1Max = 127;
+    uint8_t data2Min = 0, data2Max = 127;
+    Action action = Map;
+    uint8_t newChannel = NoChange; ///< Zero-based channel, or NoChange.
+    int8_t semitones = 0;
+    bool rescaling = false;
+    uint8_t rescaleMin = 0, rescaleMax = 127;
+
+    constexpr static uint8_t NoChange = 0xFF;
+};
+
+/**
+ * @brief   A MIDI pipe that filters and transforms Channel messages using a
+ *          table of @ref MIDI_Rule%s, without having to create a custom
+ *          @ref MIDI_Pipe subclass.
+ *
+ * When rules are added, they are compiled into a decision table indexed by
+ * the status byte of the message (type and channel). Every entry is a bit
+ * mask of the rules that can match messages with that status byte, so rules
+ * for other types or channels are never evaluated, and messages that don't
+ * match any rule are forwarded after a single table lookup.
+ *
+ * The rules are evaluated in the order they were added. The first rule that
+ * matches with a @ref MIDI_Rule::Map or @ref MIDI_Rule::Drop action
+ * determines what happens to the message. Messages that don't match any rule
+ * are forwarded unchanged. System Exclusive, System Common and Real-Time
+ * messages are always forwarded unchanged.
+ *
+ * ~~~cpp
+ * USBMIDI_Interface usbmidi;
+ * HardwareSerialMIDI_Interface serialmidi = Serial1;
+ * MIDI_RulePipe<2> pipe;
+ *
+ * void setup() {
+ *     // Drop all aftertouch
+ *     pipe.addRule(MIDI_Rule()
+ *                      .matchTypes({MIDIMessageType::KEY_PRESSURE,
+ *                                   MIDIMessageType::CHANNEL_PRESSURE})
+ *                      .drop());
+ *     // Transpose channel 1 up an octave
+ *     pipe.addRule(MIDI_Rule()
+ *                      .matchTypes({MIDIMessageType::NOTE_ON,
+ *                                   MIDIMessageType::NOTE_OFF})
+ *                      .matchChannels({CHANNEL_1})
+ *                      .transpose(12));
+ *     serialmidi >> pipe >> usbmidi;
+ * }
+ * ~~~
+ *
+ * @tparam  MaxRules
+ *          The maximum number of rules [1, 32]. The decision table uses one
+ *          byte per status byte for up to 8 rules, two bytes for up to 16
+ *          rules, and four bytes for up to 32 rules.
+ */
+template <uint8_t MaxRules = 8>
+class MIDI_RulePipe : public MIDI_Pipe {
+    static_assert(MaxRules > 0 && MaxRules <= 32,
+                  "MaxRules should be in [1, 32]");
+
+  public:
+    /// The type used for the bit masks of rules in the decision table.
+    using Mask = typename std::conditional<
+        (MaxRules <= 8), uint8_t,
+        typename std::conditional<(MaxRules <= 16), uint16_t,
+                                  uint32_t>::type>::type;
+
+    /// Add a rule after all existing rules. Returns false if the maximum
+    /// number of rules was exceeded.
+    bool addRule(const MIDI_Rule &rule) {
+        if (numRules >= MaxRules) {
+            ERROR(F("Too many rules in MIDI_RulePipe"), 0x7211);
+            return false; // LCOV_EXCL_LINE
+        }
+        uint8_t index = numRules++;
+        rules[index] = rule;
+        Mask bit = Mask(1) << index;
+        for (uint8_t t = 0; t < NumTypes; ++t)
+            if (rule.types & (1u << t))
+                for (uint8_t c = 0; c < 16; ++c)
+                    if (rule.channels & (1u << c))
+                        table[t][c] |= bit;
+        return true;
+    }
+
+    /// Remove all rules.
+    void clearRules() {
+        numRules = 0;
+        for (auto &row : table)
+            for (Mask &entry : row)
+                entry = 0;
+    }
+
+    /// Get the number of rules.
+    uint8_t getNumberOfRules() const { return numRules; }
+    /// Get the rule with the given index.
+    const MIDI_Rule &getRule(uint8_t index) const { return rules[index]; }
+
+    /// Get the bit mask of the rules that can match the given status byte.
+    Mask getCandidates(uint8_t header) const {
+        return table[(header >> 4) - 0x8][header & 0x0F];
+    }
+
+  private:
+    void mapForwardMIDI(ChannelMessage msg) override {
+        Mask candidates = getCandidates(msg.header);
+        for (uint8_t i = 0; candidates; ++i, candidates >>= 1) {
+            if (!(candidates & 1))
+                continue;
+            const MIDI_Rule &rule = rules[i];
+            if (!rule.matchesData(msg))
+                continue;
+            if (rule.action == MIDI_Rule::Drop)
+                return;
+            ChannelMessage transformed = msg;
+            if (rule.apply(transformed))
+                sourceMIDItoSink(transformed);
+            if (rule.action == MIDI_Rule::Map)
+                return;
+        }
+        sourceMIDItoSink(msg);
+    }
+
+  private:
+    constexpr static uint8_t NumTypes = 7;
+    MIDI_Rule rules[MaxRules];
+    Mask table[NumTypes][16] = {};
+    uint8_t numRules = 0;
+};
+
+/// @}
+
+END_CS_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
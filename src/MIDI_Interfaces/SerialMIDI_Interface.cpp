@@ -1,5 +1,4 @@
 #include "SerialMIDI_Interface.hpp"
-#include <MIDI_Parsers/StreamPuller.hpp>
 
 BEGIN_CS_NAMESPACE
 
@@ -8,7 +7,33 @@ BEGIN_CS_NAMESPACE
 // Reading MIDI
 
 MIDIReadEvent StreamMIDI_Interface::read() {
-    return parser.pull(StreamPuller(stream));
+    while (true) {
+        size_t consumed;
+        MIDIReadEvent event = parser.feed(readBuffer + readIndex,
+                                          readLength - readIndex, consumed);
+        readIndex += consumed;
+        if (event != MIDIReadEvent::NO_MESSAGE)
+            return event;
+        // All bytes in the buffer have been parsed, read some more
+        if (!fillReadBuffer())
+            return MIDIReadEvent::NO_MESSAGE;
+    }
+}
+
+bool StreamMIDI_Interface::fillReadBuffer() {
+    readIndex = 0;
+    readLength = 0;
+    int available = stream.available();
+    if (available > STREAM_MIDI_READ_BUFFER_SIZE)
+        available = STREAM_MIDI_READ_BUFFER_SIZE;
+    // Read at least one byte, in case the stream doesn't implement available
+    do {
+        int c = stream.read();
+        if (c < 0)
+            break;
+        readBuffer[readLength++] = c;
+    } while (readLength < available);
+    return readLength > 0;
 }
 
 void StreamMIDI_Interface::update() { MIDI_Interface::updateIncoming(this); }
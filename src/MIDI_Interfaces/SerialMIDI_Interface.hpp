@@ -48,10 +48,22 @@ class StreamMIDI_Interface : public MIDI_Interface {
 
   protected:
     void handleStall() override;
+    MIDI_Parser *getRealTimeLaneParser() override { return &parser; }
+
+  private:
+    /// Read the bytes that are available from the stream into the read buffer.
+    /// Returns false if no bytes were available.
+    bool fillReadBuffer();
 
   protected:
     Stream &stream;
     SerialMIDI_Parser parser;
+
+  private:
+    /// Bytes read from the stream that haven't been parsed yet.
+    uint8_t readBuffer[STREAM_MIDI_READ_BUFFER_SIZE];
+    uint8_t readIndex = 0;
+    uint8_t readLength = 0;
 };
 
 // -------------------------------------------------------------------------- //
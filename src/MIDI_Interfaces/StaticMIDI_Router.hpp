@@ -0,0 +1,187 @@
+#pragma once
+
+#include "MIDI_Pipes.hpp"
+#include <AH/STL/tuple>
+
+AH_DIAGNOSTIC_WERROR()
+
+BEGIN_CS_NAMESPACE
+
+/// @addtogroup MIDI_Routing
+/// @{
+
+/// @cond
+
+namespace StaticMIDI_RouterDetail {
+
+/// Calls the `sinkMIDIfromPipe` function of the given type of sink directly.
+/// The qualified name bypasses the virtual dispatch, so the call can be
+/// inlined, but overrides in classes derived from `Sink` are not called.
+/// Sinks that don't make this function public befriend this struct.
+struct SinkAccess {
+    template <class Sink, class Message>
+    static void sink(Sink &sink, Message msg) {
+        sink.Sink::sinkMIDIfromPipe(msg);
+    }
+};
+
+/// Send the message to the sinks with indices [I, N) whose bit is set in Mask.
+/// The mask is a template argument, so all checks are resolved at compile time
+/// and the recursion is unrolled into direct calls.
+template <size_t I, size_t N>
+struct Route {
+    template <uint32_t Mask, class Tuple, class Message>
+    static void apply(Tuple &sinks, Message msg) {
+        if (Mask & (uint32_t(1) << I))
+            SinkAccess::sink(std::get<I>(sinks), msg);
+        Route<I + 1, N>::template apply<Mask>(sinks, msg);
+    }
+};
+
+template <size_t N>
+struct Route<N, N> {
+    template <uint32_t Mask, class Tuple, class Message>
+    static void apply(Tuple &, Message) {}
+};
+
+} // namespace StaticMIDI_RouterDetail
+
+/// @endcond
+
+/**
+ * @brief   A MIDI router with a routing matrix that is fixed at compile time.
+ *
+ * Every hop through a chain of @ref MIDI_Pipe%s costs a virtual call, and
+ * fanning out a message to multiple sinks means walking the chain of “through”
+ * outputs, with another two virtual calls for every pipe. For fixed routing
+ * topologies, this class resolves the routes at compile time instead: each
+ * source is connected to a single @ref Input pipe, and the row of the routing
+ * matrix of that input (a bit mask of sinks) is a template argument. When a
+ * message arrives, it is handed to all selected sinks directly, without
+ * walking any lists. The router knows the types of the sinks, so it calls
+ * their `sinkMIDIfromPipe` functions without virtual dispatch. Only the
+ * @ref Input pipe itself is reached through a virtual call.
+ *
+ * The router coexists with the dynamic pipes: an @ref Input is a normal
+ * @ref MIDI_Pipe, so other pipes can still be connected to the same source
+ * (through the “through” output of the input), and the input can have its own
+ * sink as well.
+ *
+ * ~~~cpp
+ * USBMIDI_Interface usbmidi;
+ * HardwareSerialMIDI_Interface serialmidi = Serial1;
+ * BluetoothMIDI_Interface btmidi;
+ *
+ * // Sink 0 is Control Surface, sink 1 is the serial port.
+ * StaticMIDI_Router<Control_Surface_, HardwareSerialMIDI_Interface> router = {
+ *     Control_Surface, serialmidi,
+ * };
+ * // USB and BLE go to both sinks, serial only to Control Surface.
+ * decltype(router)::Input<0b11> fromUSB{router}, fromBLE{router};
+ * decltype(router)::Input<0b01> fromSerial{router};
+ *
+ * MIDI_PipeFactory<1> pipes;
+ *
+ * void setup() {
+ *     usbmidi >> fromUSB;
+ *     btmidi >> fromBLE;
+ *     serialmidi >> fromSerial;
+ *     Control_Surface >> pipes >> usbmidi;
+ *     Control_Surface.begin();
+ * }
+ * ~~~
+ *
+ * @note    If Control Surface is one of the sinks, make sure to connect its
+ *          output as well, otherwise `Control_Surface.begin()` connects the
+ *          default MIDI interface in both directions, and the messages from
+ *          that interface arrive twice.
+ *
+ * @note    The static routes don't take part in the stalling mechanism of the
+ *          pipes: messages are always delivered, so chunked System Exclusive
+ *          messages from different sources can be interleaved at a sink.
+ *
+ * @warning The `sinkMIDIfromPipe` functions are called as members of the
+ *          exact sink types given as template arguments, without virtual
+ *          dispatch. If you list a base class (e.g. @ref MIDI_Interface) and
+ *          pass an object of a derived class that overrides these functions,
+ *          the overrides are silently skipped. Always list the most derived
+ *          type of every sink.
+ *
+ * @tparam  Sinks
+ *          The types of the sinks (at most 32). All of them must be
+ *          @ref TrueMIDI_Sink%s, and must be the most derived types of the
+ *          sink objects (see the warning above). The `sinkMIDIfromPipe`
+ *          functions may be inherited from a base class, e.g.
+ *          @ref StreamMIDI_Interface inherits them from @ref MIDI_Interface.
+ *          If these functions are not public, the class that declares them
+ *          has to befriend `StaticMIDI_RouterDetail::SinkAccess`, as the MIDI
+ *          interfaces and Control Surface do.
+ */
+template <class... Sinks>
+class StaticMIDI_Router {
+  public:
+    static_assert(sizeof...(Sinks) <= 32, "At most 32 sinks are supported");
+
+    /// Constructor.
+    StaticMIDI_Router(Sinks &...sinks) : sinks(sinks...) {}
+
+    StaticMIDI_Router(const StaticMIDI_Router &) = delete;
+    StaticMIDI_Router &operator=(const StaticMIDI_Router &) = delete;
+
+    /// Get the number of sinks.
+    static constexpr size_t getNumberOfSinks() { return sizeof...(Sinks); }
+
+    /**
+     * @brief   Send the given message to all sinks selected by the mask.
+     *
+     * @tparam  RouteMask
+     *          A bit mask where bit `i` is set if the message should be sent
+     *          to sink `i` (in the order of the template arguments).
+     */
+    template <uint32_t RouteMask, class Message>
+    void route(Message msg) {
+        static_assert(sizeof...(Sinks) == 32 ||
+                          (RouteMask >> sizeof...(Sinks)) == 0,
+                      "Route mask selects a sink that doesn't exist");
+        using Impl = StaticMIDI_RouterDetail::Route<0, sizeof...(Sinks)>;
+        Impl::template apply<RouteMask>(sinks, msg);
+    }
+
+    /**
+     * @brief   A pipe that connects a source to the router.
+     *
+     * @tparam  RouteMask
+     *          The row of the routing matrix for this source: a bit mask where
+     *          bit `i` is set if messages from this source should be sent to
+     *          sink `i` of the router.
+     */
+    template <uint32_t RouteMask>
+    class Input : public MIDI_Pipe {
+      public:
+        /// Constructor.
+        Input(StaticMIDI_Router &router) : router(router) {}
+
+      private:
+        void mapForwardMIDI(ChannelMessage msg) override { forward(msg); }
+        void mapForwardMIDI(SysExMessage msg) override { forward(msg); }
+        void mapForwardMIDI(SysCommonMessage msg) override { forward(msg); }
+        void mapForwardMIDI(RealTimeMessage msg) override { forward(msg); }
+
+        template <class Message>
+        void forward(Message msg) {
+            router.template route<RouteMask>(msg);
+            sourceMIDItoSink(msg);
+        }
+
+        StaticMIDI_Router &router;
+    };
+
+  private:
+    std::tuple<Sinks &...> sinks;
+};
+
+/// @}
+
+END_CS_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
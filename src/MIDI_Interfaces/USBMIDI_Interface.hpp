@@ -24,7 +24,8 @@ class GenericUSBMIDI_Interface : public MIDI_Interface {
     template <class... Args>
     GenericUSBMIDI_Interface(Args &&...args)
         : backend(std::forward<Args>(args)...),
-          alwaysSendImmediately_(backend.preferImmediateSend()) {}
+          sendPolicy(backend.preferImmediateSend() ? SendPolicy::Immediate
+                                                   : SendPolicy::Buffered) {}
 
   private:
     // MIDI send implementations
@@ -32,14 +33,16 @@ class GenericUSBMIDI_Interface : public MIDI_Interface {
     void sendSysCommonImpl(SysCommonMessage) override;
     void sendSysExImpl(SysExMessage) override;
     void sendRealTimeImpl(RealTimeMessage) override;
-    void sendNowImpl() override { backend.sendNow(); }
+    void sendNowImpl() override;
 
   private:
     void handleStall() override;
+    MIDI_Parser *getRealTimeLaneParser() override { return &parser; }
 
   public:
     void begin() override;
     void update() override;
+    void flushAtLoopEnd() override;
 
   public:
     /// @name   Reading incoming MIDI messages
@@ -75,38 +78,118 @@ class GenericUSBMIDI_Interface : public MIDI_Interface {
         void operator()(Cable cn, MIDICodeIndexNumber cin, uint8_t d0,
                         uint8_t d1, uint8_t d2) {
             uint8_t cn_cin = (cn.getRaw() << 4) | uint8_t(cin);
-            iface->backend.write({cn_cin, d0, d1, d2});
+            iface->writePacket({cn_cin, d0, d1, d2});
         }
     };
     /// @}
 
+  public:
+    /// When to send the buffered USB packets to the host.
+    enum class SendPolicy : uint8_t {
+        /// Send the USB packets immediately after every MIDI message.
+        Immediate,
+        /// Leave the packets in the backend's buffer until @ref sendNow() is
+        /// called, or until the backend decides to send them (e.g. because its
+        /// buffer is full or after a timeout).
+        Buffered,
+        /// Collect the packets until a full batch is available (see
+        /// @ref setBatchSize), until the oldest packet has been waiting for
+        /// longer than the deadline (see @ref setBatchDeadline), or until the
+        /// end of `Control_Surface.loop()`, whichever comes first. This allows
+        /// e.g. all messages caused by a bank change to be sent in a handful
+        /// of transfers rather than one transfer per message.
+        Batched,
+    };
+
+  private:
+    /// Write a single USB MIDI packet to the backend and send the packets if
+    /// the endpoint is full.
+    void writePacket(typename Backend::MIDIUSBPacket_t packet);
+    /// Send the packets after a MIDI message, depending on the send policy.
+    void afterSend();
+    /// Send the buffered packets to the host if there are any.
+    void flushPackets();
+
   private:
     /// Parses USB packets into MIDI messages.
     USBMIDI_Parser parser;
     /// Sends USB MIDI messages.
     USBMIDI_Sender sender;
-    /// @see neverSendImmediately()
-    bool alwaysSendImmediately_ = true;
+    /// @see setSendPolicy()
+    SendPolicy sendPolicy = SendPolicy::Immediate;
+    /// Number of packets written since the last transfer (not counted when
+    /// using the `Buffered` policy).
+    uint8_t pendingPackets = 0;
+    /// @see setBatchSize()
+    uint8_t batchSize = USB_MIDI_BATCH_PACKETS;
+    /// @see setBatchDeadline()
+    unsigned long batchDeadline = USB_MIDI_BATCH_DEADLINE;
+    /// Time (micros) at which the first pending packet was written.
+    unsigned long batchStart = 0;
+    /// Total number of packets sent using @ref flushPackets.
+    uint32_t packetCount = 0;
+    /// Total number of transfers started by @ref flushPackets.
+    uint32_t transferCount = 0;
 
   public:
     /// @name   Buffering USB packets
     /// @{
 
+    /// Select when the USB packets are sent to the host. The default value
+    /// depends on the MIDI USB backend being used: `Immediate` for the
+    /// `MIDIUSB` library, and `Buffered` for the Teensy Core USB MIDI functions
+    /// (because they have a short timeout).
+    void setSendPolicy(SendPolicy policy);
+    /// Get the current send policy.
+    SendPolicy getSendPolicy() const { return sendPolicy; }
+
+    /// Set the maximum number of USB packets to collect before sending them
+    /// when using the `Batched` policy (long SysEx messages are split into
+    /// transfers of this size when using the `Immediate` policy as well).
+    /// Should be the size of the USB endpoint divided by four.
+    void setBatchSize(uint8_t packets) {
+        batchSize = packets > 0 ? packets : 1;
+    }
+    /// Get the maximum number of USB packets in a batch.
+    uint8_t getBatchSize() const { return batchSize; }
+    /// Set the maximum time (in microseconds) a packet can be kept in a batch
+    /// when using the `Batched` policy. The deadline is checked whenever a
+    /// message is sent and when the interface is updated.
+    void setBatchDeadline(unsigned long deadline) { batchDeadline = deadline; }
+    /// Get the maximum time (in microseconds) a packet can be kept in a batch.
+    unsigned long getBatchDeadline() const { return batchDeadline; }
+
+    /// Get the total number of USB packets sent by this interface's
+    /// (automatic or explicit) calls to @ref sendNow().
+    uint32_t getPacketCount() const { return packetCount; }
+    /// Get the number of transfers (calls to the backend's `sendNow`) that
+    /// contained at least one packet. Transfers the backend starts by itself
+    /// (with the `Buffered` policy) are not counted.
+    uint32_t getTransferCount() const { return transferCount; }
+    /// Get the average number of USB packets per transfer.
+    float getPacketsPerTransfer() const {
+        return transferCount == 0 ? 0 : float(packetCount) / transferCount;
+    }
+    /// Reset the packet and transfer counters to zero.
+    void resetTransferStatistics() { packetCount = transferCount = 0; }
+
     /// Check if this USB interface always sends its USB packets immediately
-    /// after sending a MIDI message. The default value depends on the MIDI USB
-    /// backend being used: `true` for the `MIDIUSB` library, and `false` for
-    /// the Teensy Core USB MIDI functions (because they have a short timeout).
-    bool alwaysSendsImmediately() const { return alwaysSendImmediately_; }
+    /// after sending a MIDI message.
+    bool alwaysSendsImmediately() const {
+        return sendPolicy == SendPolicy::Immediate;
+    }
     /// Don't send the USB packets immediately after sending a MIDI message.
     /// By disabling immediate transmission, packets are buffered until you
     /// call @ref sendNow() or until a timeout is reached, so multiple MIDI
     /// messages can be transmitted in a single USB packet. This is more
     /// efficient and results in a higher maximum bandwidth, but it could
     /// increase latency when used incorrectly.
-    void neverSendImmediately() { alwaysSendImmediately_ = false; }
+    /// Equivalent to `setSendPolicy(SendPolicy::Buffered)`.
+    void neverSendImmediately() { setSendPolicy(SendPolicy::Buffered); }
     /// Send the USB packets immediately after sending a MIDI message.
+    /// Equivalent to `setSendPolicy(SendPolicy::Immediate)`.
     /// @see @ref neverSendImmediately()
-    void alwaysSendImmediately() { alwaysSendImmediately_ = true; }
+    void alwaysSendImmediately() { setSendPolicy(SendPolicy::Immediate); }
 
     /// @}
 };
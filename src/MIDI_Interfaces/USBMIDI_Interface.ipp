@@ -25,6 +25,15 @@ void GenericUSBMIDI_Interface<Backend>::begin() {
 template <class Backend>
 void GenericUSBMIDI_Interface<Backend>::update() {
     MIDI_Interface::updateIncoming(this);
+    if (sendPolicy == SendPolicy::Batched && pendingPackets > 0 &&
+        micros() - batchStart >= batchDeadline)
+        flushPackets();
+}
+
+template <class Backend>
+void GenericUSBMIDI_Interface<Backend>::flushAtLoopEnd() {
+    if (sendPolicy == SendPolicy::Batched)
+        flushPackets();
 }
 
 template <class Backend>
@@ -63,30 +72,83 @@ template <class Backend>
 void GenericUSBMIDI_Interface<Backend>::sendChannelMessageImpl(
     ChannelMessage msg) {
     sender.sendChannelMessage(msg, Sender {this});
-    if (alwaysSendImmediately_)
-        backend.sendNow();
+    afterSend();
 }
 
 template <class Backend>
 void GenericUSBMIDI_Interface<Backend>::sendSysCommonImpl(
     SysCommonMessage msg) {
     sender.sendSysCommonMessage(msg, Sender {this});
-    if (alwaysSendImmediately_)
-        backend.sendNow();
+    afterSend();
 }
 
 template <class Backend>
 void GenericUSBMIDI_Interface<Backend>::sendSysExImpl(const SysExMessage msg) {
     sender.sendSysEx(msg, Sender {this});
-    if (alwaysSendImmediately_)
-        backend.sendNow();
+    afterSend();
 }
 
 template <class Backend>
 void GenericUSBMIDI_Interface<Backend>::sendRealTimeImpl(RealTimeMessage msg) {
     sender.sendRealTimeMessage(msg, Sender {this});
-    if (alwaysSendImmediately_)
-        backend.sendNow();
+    // Real-Time messages (e.g. MIDI clock) don't wait for the rest of the
+    // batch or for the timeout of the backend, regardless of the send policy.
+    sendNowImpl();
+}
+
+// Buffering USB packets
+// -----------------------------------------------------------------------------
+
+template <class Backend>
+void GenericUSBMIDI_Interface<Backend>::writePacket(
+    typename Backend::MIDIUSBPacket_t packet) {
+    backend.write(packet);
+    // With the buffered policy, the backend decides when to send the packets
+    if (sendPolicy == SendPolicy::Buffered)
+        return;
+    if (pendingPackets == 0 && sendPolicy == SendPolicy::Batched)
+        batchStart = micros();
+    if (++pendingPackets >= batchSize)
+        flushPackets();
+}
+
+template <class Backend>
+void GenericUSBMIDI_Interface<Backend>::afterSend() {
+    switch (sendPolicy) {
+        case SendPolicy::Immediate: flushPackets(); break;
+        case SendPolicy::Batched:
+            if (pendingPackets > 0 && micros() - batchStart >= batchDeadline)
+                flushPackets();
+            break;
+        case SendPolicy::Buffered: break;
+        default: break; // LCOV_EXCL_LINE
+    }
+}
+
+template <class Backend>
+void GenericUSBMIDI_Interface<Backend>::flushPackets() {
+    if (pendingPackets == 0)
+        return;
+    backend.sendNow();
+    packetCount += pendingPackets;
+    ++transferCount;
+    pendingPackets = 0;
+}
+
+template <class Backend>
+void GenericUSBMIDI_Interface<Backend>::sendNowImpl() {
+    if (pendingPackets == 0)
+        backend.sendNow(); // The backend might have buffered data of its own
+    else
+        flushPackets();
+}
+
+template <class Backend>
+void GenericUSBMIDI_Interface<Backend>::setSendPolicy(SendPolicy policy) {
+    // Don't leave any packets behind that the new policy wouldn't send
+    if (policy != sendPolicy)
+        flushPackets();
+    sendPolicy = policy;
 }
 
 END_CS_NAMESPACE
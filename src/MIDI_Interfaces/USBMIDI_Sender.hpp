@@ -22,6 +22,9 @@ class USBMIDI_Sender {
     void sendSysCommonMessage(SysCommonMessage, Send &&send);
 
     /// Send a MIDI Real-Time message using the given sender.
+    /// Real-Time messages are never held back: they can be sent in between
+    /// the chunks of a SysEx message, without affecting the SysEx bytes that
+    /// are stored until the next chunk arrives.
     template <class Send>
     void sendRealTimeMessage(RealTimeMessage, Send &&send);
 
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <Settings/NamespaceSettings.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+BEGIN_CS_NAMESPACE
+
+/**
+ * @brief   Lock-free single-producer, single-consumer ring buffer of bytes.
+ *
+ * One thread may write to the ring while another thread reads from it,
+ * without any locks. Writes are all-or-nothing: either all bytes fit and are
+ * published at once, or nothing is written, so the consumer never sees a
+ * partially written record.
+ */
+class SPSCByteRing {
+  public:
+    /// Create a ring that can hold up to `capacity` bytes.
+    SPSCByteRing(size_t capacity) : buffer(capacity + 1) {}
+
+    /// Get the maximum number of bytes the ring can hold.
+    size_t capacity() const { return buffer.size() - 1; }
+
+    /// @name   Producer
+    /// @{
+
+    /// Get the number of bytes that can be written without overflowing.
+    size_t writeAvailable() const {
+        size_t w = write_idx.load(std::memory_order_relaxed);
+        size_t r = read_idx.load(std::memory_order_acquire);
+        return r > w ? r - w - 1 : buffer.size() - (w - r) - 1;
+    }
+
+    /// Write the bytes of `head`, followed by the bytes of `body`, and
+    /// publish them to the consumer. Returns false without writing anything
+    /// if there's not enough space.
+    bool write(const uint8_t *head, size_t headLength,
+               const uint8_t *body = nullptr, size_t bodyLength = 0) {
+        if (headLength + bodyLength > writeAvailable())
+            return false;
+        size_t w = write_idx.load(std::memory_order_relaxed);
+        w = copyIn(w, head, headLength);
+        w = copyIn(w, body, bodyLength);
+        write_idx.store(w, std::memory_order_release);
+        return true;
+    }
+
+    /// @}
+
+    /// @name   Consumer
+    /// @{
+
+    /// Get the number of bytes that can be read.
+    size_t readAvailable() const {
+        size_t w = write_idx.load(std::memory_order_acquire);
+        size_t r = read_idx.load(std::memory_order_relaxed);
+        return w >= r ? w - r : buffer.size() - (r - w);
+    }
+
+    /// Check whether there are no bytes to be read.
+    bool empty() const { return readAvailable() == 0; }
+
+    /// Copy `length` bytes to `data` without removing them from the ring.
+    bool peek(uint8_t *data, size_t length) const {
+        if (length > readAvailable())
+            return false;
+        copyOut(read_idx.load(std::memory_order_relaxed), data, length);
+        return true;
+    }
+
+    /// Copy `length` bytes to `data` and remove them from the ring.
+    bool read(uint8_t *data, size_t length) {
+        if (!peek(data, length))
+            return false;
+        skip(length);
+        return true;
+    }
+
+    /// Remove `length` bytes from the ring (at most @ref readAvailable).
+    void skip(size_t length) {
+        size_t r = read_idx.load(std::memory_order_relaxed);
+        read_idx.store(advance(r, length), std::memory_order_release);
+    }
+
+    /// @}
+
+  private:
+    size_t advance(size_t idx, size_t n) const {
+        idx += n;
+        return idx >= buffer.size() ? idx - buffer.size() : idx;
+    }
+
+    size_t copyIn(size_t w, const uint8_t *data, size_t length) {
+        size_t first = std::min(length, buffer.size() - w);
+        if (first > 0)
+            std::memcpy(&buffer[w], data, first);
+        if (length > first)
+            std::memcpy(&buffer[0], data + first, length - first);
+        return advance(w, length);
+    }
+
+    void copyOut(size_t r, uint8_t *data, size_t length) const {
+        size_t first = std::min(length, buffer.size() - r);
+        if (first > 0)
+            std::memcpy(data, &buffer[r], first);
+        if (length > first)
+            std::memcpy(data + first, &buffer[0], length - first);
+    }
+
+  private:
+    std::vector<uint8_t> buffer;
+    std::atomic_size_t write_idx{0};
+    std::atomic_size_t read_idx{0};
+};
+
+END_CS_NAMESPACE
@@ -28,9 +28,47 @@ class MIDI_Parser {
     SysExMessage getSysExMessage() const { return {nullptr, 0, CABLE_1}; }
 #endif
 
+    /// Function that handles Real-Time messages as soon as they are parsed.
+    /// @see    setRealTimeHandler
+    using RealTimeHandler = void (*)(void *context, RealTimeMessage msg);
+
+    /**
+     * @brief   Hand all Real-Time messages to the given function as soon as
+     *          they are parsed, instead of returning them as
+     *          `MIDIReadEvent::REALTIME_MESSAGE`.
+     *
+     * This is the priority lane for MIDI clock: parsing simply continues
+     * after handling the Real-Time message, so the caller of the parser never
+     * has to deal with them, and they can't be held up behind other messages
+     * (e.g. the chunks of a long SysEx message) that are waiting to be
+     * dispatched.
+     *
+     * @param   handler
+     *          The function to call, or `nullptr` to return Real-Time
+     *          messages as normal events again.
+     * @param   context
+     *          Pointer that is passed to the handler as its first argument.
+     */
+    void setRealTimeHandler(RealTimeHandler handler, void *context = nullptr) {
+        this->rtHandler = handler;
+        this->rtContext = context;
+    }
+
+  protected:
+    /// Call the Real-Time handler with the message in @ref rtmsg if there is
+    /// one, otherwise report it to the caller.
+    MIDIReadEvent surfaceRealTime() {
+        if (rtHandler == nullptr)
+            return MIDIReadEvent::REALTIME_MESSAGE;
+        rtHandler(rtContext, rtmsg);
+        return MIDIReadEvent::NO_MESSAGE;
+    }
+
   protected:
     MIDIMessage midimsg = {0x00, 0x00, 0x00};
     RealTimeMessage rtmsg = {0x00};
+    RealTimeHandler rtHandler = nullptr;
+    void *rtContext = nullptr;
 
   public:
     /// Check if the given byte is a MIDI header/status byte.
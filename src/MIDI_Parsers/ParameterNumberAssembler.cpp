@@ -0,0 +1,131 @@
+#include "ParameterNumberAssembler.hpp"
+#include <MIDI_Constants/Control_Change.hpp>
+
+BEGIN_CS_NAMESPACE
+
+auto ParameterNumberAssembler::update(ChannelMessage msg, unsigned long now)
+    -> Result {
+    if (msg.getMessageType() != MIDIMessageType::CONTROL_CHANGE)
+        return Result::Ignored;
+    uint8_t channelCable = pack(msg.getChannelCable());
+    uint8_t controller = msg.getData1();
+    uint8_t value = msg.getData2();
+
+    switch (controller) {
+        // Select a new parameter number
+        case MIDI_CC::NRPN_MSB: // fallthrough
+        case MIDI_CC::NRPN_LSB: // fallthrough
+        case MIDI_CC::RPN_MSB:  // fallthrough
+        case MIDI_CC::RPN_LSB: {
+            bool completed = false;
+            Slot *slot = find(channelCable);
+            if (slot == nullptr) {
+                slot = allocate(channelCable, completed);
+            } else if (slot->pending) {
+                // The previous parameter never received its LSB
+                complete(*slot, 0);
+                completed = true;
+            }
+            bool nrpn = controller == MIDI_CC::NRPN_MSB ||
+                        controller == MIDI_CC::NRPN_LSB;
+            bool msb = controller == MIDI_CC::NRPN_MSB ||
+                       controller == MIDI_CC::RPN_MSB;
+            slot->kind = nrpn ? ParameterNumberMessage::NRPN
+                              : ParameterNumberMessage::RPN;
+            (msb ? slot->numberMSB : slot->numberLSB) = value;
+            return completed ? Result::Complete : Result::Consumed;
+        }
+        // Set the value of the selected parameter
+        case MIDI_CC::Data_Entry_MSB: {
+            Slot *slot = find(channelCable);
+            if (slot == nullptr || !slot->isSelected())
+                return Result::Ignored;
+            bool completed = slot->pending;
+            if (completed)
+                complete(*slot, 0);
+            slot->valueMSB = value;
+            slot->pending = true;
+            slot->time = now;
+            return completed ? Result::Complete : Result::Consumed;
+        }
+        case MIDI_CC::Data_Entry_MSB_LSB: {
+            Slot *slot = find(channelCable);
+            if (slot == nullptr || !slot->isSelected())
+                return Result::Ignored;
+            complete(*slot, value);
+            return Result::Complete;
+        }
+        default: return Result::Ignored;
+    }
+}
+
+bool ParameterNumberAssembler::poll(unsigned long now) {
+    return poll(now, false);
+}
+
+bool ParameterNumberAssembler::poll(unsigned long now, bool force) {
+    for (Slot &slot : slots) {
+        if (slot.used && slot.pending &&
+            (force || now - slot.time >= PARAMETER_NUMBER_TIMEOUT)) {
+            complete(slot, 0);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ParameterNumberAssembler::reset(MIDIChannelCable channelCable) {
+    Slot *slot = find(pack(channelCable));
+    if (slot != nullptr)
+        *slot = Slot();
+}
+
+void ParameterNumberAssembler::resetAll() {
+    for (Slot &slot : slots)
+        slot = Slot();
+    nextEviction = 0;
+}
+
+auto ParameterNumberAssembler::find(uint8_t channelCable) -> Slot * {
+    for (Slot &slot : slots)
+        if (slot.used && slot.channelCable == channelCable)
+            return &slot;
+    return nullptr;
+}
+
+auto ParameterNumberAssembler::allocate(uint8_t channelCable, bool &completed)
+    -> Slot * {
+    Slot *slot = nullptr;
+    for (Slot &s : slots) {
+        if (!s.used) {
+            slot = &s;
+            break;
+        }
+    }
+    if (slot == nullptr) {
+        // All slots are in use, forget one of the channels (round-robin)
+        slot = &slots[nextEviction];
+        nextEviction = (nextEviction + 1) % PARAMETER_NUMBER_CHANNELS;
+        if (slot->pending) {
+            complete(*slot, 0);
+            completed = true;
+        }
+    }
+    *slot = Slot();
+    slot->used = true;
+    slot->channelCable = channelCable;
+    return slot;
+}
+
+void ParameterNumberAssembler::complete(Slot &slot, uint8_t valueLSB) {
+    message = {
+        slot.kind,
+        slot.getNumber(),
+        uint16_t((slot.valueMSB << 7) | valueLSB),
+        Channel(slot.channelCable & 0x0F),
+        Cable(slot.channelCable >> 4),
+    };
+    slot.pending = false;
+}
+
+END_CS_NAMESPACE
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "MIDI_MessageTypes.hpp"
+#include <Settings/SettingsWrapper.hpp>
+
+BEGIN_CS_NAMESPACE
+
+/**
+ * @brief   A complete Registered or Non-Registered Parameter Number value,
+ *          assembled from a sequence of Control Change messages by the
+ *          @ref ParameterNumberAssembler.
+ *
+ * @ingroup MIDIParsers
+ */
+struct ParameterNumberMessage {
+    /// Registered (RPN) or Non-Registered (NRPN) Parameter Number.
+    enum Kind : uint8_t {
+        RPN = 0,
+        NRPN = 1,
+    };
+
+    /// Constructor.
+    ParameterNumberMessage(Kind kind, uint16_t number, uint16_t value,
+                           Channel channel, Cable cable = CABLE_1)
+        : kind(kind), number(number), value(value), channel(channel),
+          cable(cable) {}
+
+    Kind kind;       ///< RPN or NRPN.
+    uint16_t number; ///< The 14-bit parameter number.
+    uint16_t value;  ///< The 14-bit parameter value.
+    Channel channel; ///< The MIDI channel the message was received on.
+    Cable cable;     ///< The MIDI USB cable the message was received on.
+
+    /// Get the MIDI channel.
+    Channel getChannel() const { return channel; }
+    /// Get the MIDI USB cable number.
+    Cable getCable() const { return cable; }
+    /// Get the MIDI channel and cable number.
+    MIDIChannelCable getChannelCable() const { return {channel, cable}; }
+
+    /// Check whether two messages are identical.
+    bool operator==(ParameterNumberMessage other) const {
+        return this->kind == other.kind && this->number == other.number &&
+               this->value == other.value && this->channel == other.channel &&
+               this->cable == other.cable;
+    }
+    /// Check whether two messages are not identical.
+    bool operator!=(ParameterNumberMessage other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief   Combines the Control Change messages that select and set a
+ *          Registered or Non-Registered Parameter Number into a single
+ *          @ref ParameterNumberMessage.
+ *
+ * The parameter number is selected using CC 101/100 (RPN MSB/LSB) or CC 99/98
+ * (NRPN MSB/LSB), the value is then set using CC 6 (Data Entry MSB),
+ * optionally followed by CC 38 (Data Entry LSB).
+ * The assembler keeps track of the selected parameter for each combination of
+ * MIDI channel and cable separately. Data Entry messages complete a
+ * parameter value as soon as the LSB arrives. If the LSB doesn't arrive
+ * within @ref PARAMETER_NUMBER_TIMEOUT milliseconds, or if a new parameter or
+ * MSB is received first, the value is completed with an LSB of zero, so 7-bit
+ * senders are supported as well. A lone LSB updates the most recent MSB.
+ *
+ * Data Entry messages for a channel without a selected parameter (or after
+ * the Null RPN was selected) are not consumed and should be handled as
+ * ordinary Control Change messages. The same is true for Data Increment and
+ * Decrement (CC 96/97).
+ *
+ * @ingroup MIDIParsers
+ */
+class ParameterNumberAssembler {
+  public:
+    /// What happened to the Control Change message passed to @ref update.
+    enum class Result : uint8_t {
+        Ignored,  ///< Not part of a parameter number sequence.
+        Consumed, ///< Part of a parameter number sequence.
+        Complete, ///< Consumed and a parameter value is available.
+    };
+
+    /**
+     * @brief   Process a MIDI Control Change message.
+     *
+     * @param   msg
+     *          The Control Change message to process.
+     * @param   now
+     *          The current time in milliseconds, used for the Data Entry LSB
+     *          timeout.
+     *
+     * @return  Whether the message was consumed, and if so, whether a
+     *          parameter value was completed. In that case, it can be
+     *          retrieved using @ref getMessage.
+     */
+    Result update(ChannelMessage msg, unsigned long now);
+
+    /**
+     * @brief   Complete the parameter values whose Data Entry LSB timed out.
+     *
+     * Should be called regularly. Every call completes at most one value, so
+     * it should be called until it returns false.
+     *
+     * @param   now
+     *          The current time in milliseconds.
+     *
+     * @return  True if a parameter value was completed, it can be retrieved
+     *          using @ref getMessage.
+     */
+    bool poll(unsigned long now);
+
+    /// Complete the parameter values that are waiting for a Data Entry LSB,
+    /// regardless of the timeout. Call until it returns false.
+    bool flush() { return poll(0, true); }
+
+    /// Forget the parameter selection of the given channel and cable, as
+    /// required by Reset All Controllers.
+    void reset(MIDIChannelCable channelCable);
+    /// Forget the parameter selection of all channels and cables.
+    void resetAll();
+
+    /// Get the most recently completed parameter value.
+    ParameterNumberMessage getMessage() const { return message; }
+
+  private:
+    /// The state of a single combination of MIDI channel and cable.
+    struct Slot {
+        uint8_t channelCable = 0; ///< Cable number in the high nibble.
+        bool used = false;
+        bool pending = false; ///< Waiting for the Data Entry LSB.
+        ParameterNumberMessage::Kind kind = ParameterNumberMessage::RPN;
+        uint8_t numberMSB = 0x7F;
+        uint8_t numberLSB = 0x7F;
+        uint8_t valueMSB = 0;
+        unsigned long time = 0;
+
+        bool isSelected() const {
+            return numberMSB != 0x7F || numberLSB != 0x7F;
+        }
+        uint16_t getNumber() const { return (numberMSB << 7) | numberLSB; }
+    };
+
+    static uint8_t pack(MIDIChannelCable cc) {
+        return (cc.getRawCableNumber() << 4) | cc.getRawChannel();
+    }
+    Slot *find(uint8_t channelCable);
+    Slot *allocate(uint8_t channelCable, bool &completed);
+    void complete(Slot &slot, uint8_t valueLSB);
+    bool poll(unsigned long now, bool force);
+
+  private:
+    Slot slots[PARAMETER_NUMBER_CHANNELS];
+    uint8_t nextEviction = 0;
+    ParameterNumberMessage message = {ParameterNumberMessage::RPN, 0, 0,
+                                      CHANNEL_1};
+};
+
+END_CS_NAMESPACE
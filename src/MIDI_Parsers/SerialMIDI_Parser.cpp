@@ -4,7 +4,7 @@ BEGIN_CS_NAMESPACE
 
 MIDIReadEvent SerialMIDI_Parser::handleRealTime(uint8_t midiByte) {
     rtmsg.message = midiByte;
-    return MIDIReadEvent::REALTIME_MESSAGE;
+    return surfaceRealTime();
 }
 
 MIDIReadEvent SerialMIDI_Parser::handleNonRealTimeStatus(uint8_t midiByte) {
@@ -209,6 +209,47 @@ MIDIReadEvent SerialMIDI_Parser::feed(uint8_t midiByte) {
     }
 }
 
+MIDIReadEvent SerialMIDI_Parser::feed(const uint8_t *data, size_t length,
+                                      size_t &consumed) {
+    consumed = 0;
+    // First try resuming the parser, we might have a stored byte that has to
+    // be parsed first.
+    MIDIReadEvent evt = resume();
+    if (evt != MIDIReadEvent::NO_MESSAGE)
+        return evt;
+
+    while (consumed < length) {
+#if !IGNORE_SYSEX
+        // If we're receiving a SysEx message, add all data bytes up to the
+        // next status byte at once
+        if (currentHeader == uint8_t(MIDIMessageType::SYSEX_START)) {
+            const uint8_t *run = data + consumed;
+            size_t runLength = 0;
+            while (runLength < length - consumed && !isStatus(run[runLength]))
+                ++runLength;
+            size_t space = sysexbuffer.getSpaceLeft();
+            size_t n = runLength < space ? runLength : space;
+            addSysExBytes(run, n);
+            consumed += n;
+            // If the buffer is full, remember the next data byte and return
+            // the chunk we have saved up to now
+            if (runLength > n) {
+                storeByte(data[consumed++]);
+                return MIDIReadEvent::SYSEX_CHUNK;
+            }
+            if (consumed == length)
+                break;
+        }
+#endif
+        // Status bytes and the data bytes of other messages are handled one
+        // by one
+        evt = feed(data[consumed++]);
+        if (evt != MIDIReadEvent::NO_MESSAGE)
+            return evt;
+    }
+    return MIDIReadEvent::NO_MESSAGE;
+}
+
 MIDIReadEvent SerialMIDI_Parser::resume() {
     if (!hasStoredByte())
         return MIDIReadEvent::NO_MESSAGE;
@@ -26,6 +26,27 @@ class SerialMIDI_Parser : public MIDI_Parser {
     template <class BytePuller>
     MIDIReadEvent pull(BytePuller &&puller);
 
+    /**
+     * @brief   Parse one incoming MIDI message from a buffer of bytes.
+     *
+     * Has the same effect as @ref pull with a puller that reads from the given
+     * buffer, but the data bytes of System Exclusive messages are copied to
+     * the SysEx buffer in bulk, up to the next status byte, instead of being
+     * handled one by one.
+     *
+     * @param   data
+     *          The MIDI bytes to parse.
+     * @param   length
+     *          The number of bytes in `data`.
+     * @param[out] consumed
+     *          The number of bytes of `data` that were used. The remaining
+     *          bytes should be passed to the next call.
+     * @return  The type of MIDI message available, or
+     *          `MIDIReadEvent::NO_MESSAGE` if all bytes were consumed before
+     *          a complete message was parsed.
+     */
+    MIDIReadEvent feed(const uint8_t *data, size_t length, size_t &consumed);
+
   protected:
     /// Feed a new byte to the parser.
     MIDIReadEvent feed(uint8_t midibyte);
@@ -41,6 +62,9 @@ class SerialMIDI_Parser : public MIDI_Parser {
 
   protected:
     void addSysExByte(uint8_t data) { sysexbuffer.add(data); }
+    void addSysExBytes(const uint8_t *data, uint16_t length) {
+        sysexbuffer.add(data, length);
+    }
     bool hasSysExSpace() const { return sysexbuffer.hasSpaceLeft(); }
     void startSysEx() { sysexbuffer.start(); }
     void endSysEx() { sysexbuffer.end(); }
@@ -17,7 +17,7 @@ void SysExBuffer::add(uint8_t data) {
     ++length;
 }
 
-void SysExBuffer::add(const uint8_t *data, uint8_t len) {
+void SysExBuffer::add(const uint8_t *data, uint16_t len) {
     memcpy(buffer + length, data, len);
     length += len;
 }
@@ -132,7 +132,7 @@ MIDIReadEvent USBMIDI_Parser::handleSingleByte(MIDIUSBPacket_t packet,
                                                Cable cable) {
     rtmsg.message = packet[1];
     rtmsg.cable = cable;
-    return MIDIReadEvent::REALTIME_MESSAGE;
+    return surfaceRealTime();
 }
 
 // https://usb.org/sites/default/files/midi10.pdf
@@ -35,6 +35,16 @@ constexpr unsigned long VU_PEAK_HOLD_TIME = 400; // milliseconds
 /// pixel at a time), if set to false, they will decay one unit at a time. */
 constexpr bool VU_PEAK_SMOOTH_DECAY = true;
 
+/// The resolution in milliseconds of the timer wheel that drives the decay of
+/// the MCU VU meters and the VU meter display peak bars.
+/// @see    MCU::VUDecayScheduler
+constexpr unsigned long VU_DECAY_WHEEL_RESOLUTION = 20; // milliseconds
+
+/// Measure how long it takes to notify all bankable elements when the setting
+/// of a Bank changes.
+/// @see    Bank::getLastSelectStats
+constexpr bool BANK_SELECT_TIMING = false;
+
 /// Determines when a note input should be interpreted as 'on'.
 constexpr uint8_t NOTE_VELOCITY_THRESHOLD = 1;
 
@@ -44,12 +54,44 @@ constexpr uint8_t NOTE_VELOCITY_THRESHOLD = 1;
 #define NO_SYSEX_OUTPUT 0
 
 /// The length of the maximum System Exclusive message that can be received.
-/// The maximum length sent by the MCU protocol is 120 bytes.
+/// The maximum length sent by the MCU protocol is 120 bytes, but since the
+/// MCU::LCD class handles chunked messages, a smaller buffer can be used.
 constexpr uint16_t SYSEX_BUFFER_SIZE = 128;
 
 /// Timeout in milliseconds to wait for a SysEx chunk to complete.
 constexpr unsigned long SYSEX_CHUNK_TIMEOUT = 500;
 
+/// The total number of bytes of incoming System Exclusive data that the
+/// Bluetooth MIDI interface can buffer until it is read by the main loop.
+constexpr uint16_t BLE_SYSEX_QUEUE_SIZE = 1024;
+
+/// The size in bytes of the buffer for outgoing Bluetooth MIDI messages. Every
+/// message takes four bytes of overhead (for every 255 bytes of SysEx data).
+/// Outgoing System Exclusive messages that are longer than the buffer (504
+/// bytes of SysEx data with the default size) are sent in pieces, and block
+/// until the last piece has been added to the buffer.
+constexpr uint16_t BLE_SEND_BUFFER_SIZE = 512;
+
+/// Timeout in milliseconds to wait for the Data Entry LSB of a (Non-)Registered
+/// Parameter Number before completing the value with an LSB of zero.
+constexpr unsigned long PARAMETER_NUMBER_TIMEOUT = 10;
+
+/// The number of MIDI channel and cable combinations for which the
+/// (Non-)Registered Parameter Number selection is remembered.
+constexpr uint8_t PARAMETER_NUMBER_CHANNELS = 4;
+
+/// The default number of 4-byte USB MIDI packets that are sent in a single
+/// transfer when batching is enabled (64-byte full-speed bulk endpoint).
+constexpr uint8_t USB_MIDI_BATCH_PACKETS = 16;
+
+/// The default time in microseconds after which a partially filled batch of
+/// USB MIDI packets is sent (one full-speed USB frame).
+constexpr unsigned long USB_MIDI_BATCH_DEADLINE = 1000;
+
+/// The number of bytes a StreamMIDI_Interface reads from its Stream at once
+/// before parsing them.
+constexpr uint8_t STREAM_MIDI_READ_BUFFER_SIZE = 16;
+
 /// The baud rate to use for Hairless MIDI.
 constexpr unsigned long HAIRLESS_BAUD = 115200;
 
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <AH/Filters/EMA.hpp>
+#include <AH/Filters/EMABank.hpp>
 #include <algorithm>
 #include <array>
 #include <cmath>
@@ -81,3 +82,39 @@ TEST(EMA, EMA_overflow_reset) {
     EXPECT_EQ(ema(maximum), maximum);
     EXPECT_EQ(ema(maximum), maximum);
 }
+
+TEST(EMABank, sameAsEMA) {
+    using namespace std;
+    constexpr size_t N = 5;
+    EMABank<N, 3, int16_t, uint32_t> bank(-7);
+    array<EMA<3, int16_t, uint32_t>, N> emas;
+    fill(emas.begin(), emas.end(), EMA<3, int16_t, uint32_t>(-7));
+    int16_t values[N];
+    for (int n = 0; n < 200; ++n) {
+        for (size_t i = 0; i < N; ++i)
+            values[i] = int16_t((n * 37 + int(i) * 1011) % 4001 - 2000);
+        int16_t input = values[2];
+        bank.filter(values);
+        for (size_t i = 0; i < N; ++i)
+            ASSERT_EQ(values[i], emas[i](int16_t((n * 37 + int(i) * 1011) %
+                                                     4001 -
+                                                 2000)))
+                << n << ", " << i;
+        if (n == 100) {
+            bank.reset(2, input);
+            emas[2].reset(input);
+        }
+    }
+}
+
+TEST(EMABank, filterSingleChannel) {
+    EMABank<3, 2, uint16_t> bank;
+    EMA<2, uint16_t> ema;
+    for (uint16_t x : {100, 100, 25, 25, 50, 123, 465, 75, 56})
+        EXPECT_EQ(bank.filter(1, x), ema(x));
+    uint16_t values[3] = {0, 0, 0};
+    bank.filter(values);
+    EXPECT_EQ(values[0], 0);
+    EXPECT_EQ(values[1], ema(0));
+    EXPECT_EQ(values[2], 0);
+}
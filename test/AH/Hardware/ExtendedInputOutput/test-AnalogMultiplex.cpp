@@ -302,4 +302,73 @@ TEST(AnalogMultiplex, pinModeBuffered) {
     ExtIO::pinModeBuffered(mux.pin(0b1111), INPUT_PULLUP);
 
     ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
-}
\ No newline at end of file
+}
+
+TEST(BufferedAnalogMultiplex, grayCodeScan) {
+    BufferedAnalogMultiplex<2> mux = {A0, {2, 3}, 4};
+    mux.discardFirstReading(false);
+
+    ::testing::InSequence seq;
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(2, OUTPUT));
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(3, OUTPUT));
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(4, OUTPUT));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(4, 1));
+    // Initial scan in Gray code order: 0b00, 0b01, 0b11, 0b10
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(3, 0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(4, 0));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .WillOnce(::testing::Return(100));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 1));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .WillOnce(::testing::Return(101));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(3, 1));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .WillOnce(::testing::Return(103));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 0));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .WillOnce(::testing::Return(102));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(4, 1));
+    mux.begin();
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // Reads are served from the cache
+    EXPECT_EQ(ExtIO::analogRead(mux.pin(0)), 100);
+    EXPECT_EQ(ExtIO::analogRead(mux.pin(1)), 101);
+    EXPECT_EQ(ExtIO::analogReadBuffered(mux.pin(2)), 102);
+    EXPECT_EQ(ExtIO::analogReadBuffered(mux.pin(3)), 103);
+}
+
+TEST(BufferedAnalogMultiplex, binaryScan) {
+    BufferedAnalogMultiplex<2> mux = {A0, {2, 3}};
+    mux.grayCodeScan(false);
+
+    ::testing::InSequence seq;
+    // Address 0b00 with dummy reading
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(3, 0));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .WillOnce(::testing::Return(0))
+        .WillOnce(::testing::Return(200));
+    // 0b01
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 1));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .WillOnce(::testing::Return(0))
+        .WillOnce(::testing::Return(201));
+    // 0b10
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(3, 1));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .WillOnce(::testing::Return(0))
+        .WillOnce(::testing::Return(202));
+    // 0b11
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 1));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .WillOnce(::testing::Return(0))
+        .WillOnce(::testing::Return(203));
+    mux.updateBufferedInputs();
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    for (pin_t i = 0; i < 4; ++i)
+        EXPECT_EQ(ExtIO::analogRead(mux.pin(i)), 200 + i);
+}
@@ -0,0 +1,132 @@
+#include <gmock/gmock.h>
+
+#include <AH/Hardware/ExtendedInputOutput/SPIShiftRegisterOut.hpp>
+
+using namespace ::testing;
+USING_AH_NAMESPACE;
+
+struct MockSPI {
+    MOCK_METHOD(void, begin, ());
+    MOCK_METHOD(void, beginTransaction, (SPISettings));
+    MOCK_METHOD(void, endTransaction, ());
+    MOCK_METHOD(uint8_t, transfer, (uint8_t));
+    MOCK_METHOD(void, transfer, (void *, size_t));
+};
+
+struct MockAsyncSPI : MockSPI {
+    MOCK_METHOD(void, transferAsync,
+                (const uint8_t *, size_t, void (*)(void *), void *));
+};
+
+/// Expect a single bulk transfer of the given data, latched by the given pin.
+static void expectTransfer(MockSPI &spi, pin_t latch,
+                           std::vector<uint8_t> expected) {
+    InSequence seq;
+    EXPECT_CALL(spi, beginTransaction(_));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(latch, LOW));
+    EXPECT_CALL(spi, transfer(_, expected.size()))
+        .WillOnce([expected](void *buf, size_t len) {
+            auto data = static_cast<uint8_t *>(buf);
+            EXPECT_EQ(std::vector<uint8_t>(data, data + len), expected);
+            std::fill(data, data + len, 0xAA); // received data
+        });
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(latch, HIGH));
+    EXPECT_CALL(spi, endTransaction());
+}
+
+TEST(SPIShiftRegisterOut, bulkTransferMSBFirst) {
+    StrictMock<MockSPI> spi;
+    SPIShiftRegisterOut<24, MockSPI &> sr(spi, 10, MSBFIRST);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(10, OUTPUT));
+    EXPECT_CALL(spi, begin());
+    expectTransfer(spi, 10, {0x00, 0x00, 0x00});
+    sr.begin();
+    Mock::VerifyAndClear(&spi);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    sr.digitalWriteBuffered(0, HIGH);
+    sr.digitalWriteBuffered(9, HIGH);
+    sr.digitalWriteBuffered(23, HIGH);
+    expectTransfer(spi, 10, {0x80, 0x02, 0x01});
+    sr.updateBufferedOutputs();
+    Mock::VerifyAndClear(&spi);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // Nothing changed, so nothing is sent
+    sr.updateBufferedOutputs();
+    // The received data doesn't affect the outputs
+    sr.digitalWriteBuffered(1, HIGH);
+    expectTransfer(spi, 10, {0x80, 0x02, 0x03});
+    sr.updateBufferedOutputs();
+    Mock::VerifyAndClear(&spi);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(SPIShiftRegisterOut, bulkTransferLSBFirst) {
+    StrictMock<MockSPI> spi;
+    SPIShiftRegisterOut<16, MockSPI &> sr(spi, 10, LSBFIRST);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(10, OUTPUT));
+    EXPECT_CALL(spi, begin());
+    expectTransfer(spi, 10, {0x00, 0x00});
+    sr.begin();
+    Mock::VerifyAndClear(&spi);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    sr.digitalWriteBuffered(0, HIGH);
+    sr.digitalWriteBuffered(15, HIGH);
+    expectTransfer(spi, 10, {0x01, 0x80});
+    sr.updateBufferedOutputs();
+    Mock::VerifyAndClear(&spi);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(SPIShiftRegisterOut, asyncTransfer) {
+    StrictMock<MockAsyncSPI> spi;
+    SPIShiftRegisterOut<16, MockAsyncSPI &> sr(spi, 10, MSBFIRST);
+
+    void (*callback)(void *) = nullptr;
+    void *arg = nullptr;
+    auto expectStart = [&](std::vector<uint8_t> expected) {
+        InSequence seq;
+        EXPECT_CALL(spi, beginTransaction(_));
+        EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, LOW));
+        EXPECT_CALL(spi, transferAsync(_, 2, _, _))
+            .WillOnce([&, expected](const uint8_t *buf, size_t len,
+                                    void (*cb)(void *), void *a) {
+                EXPECT_EQ(std::vector<uint8_t>(buf, buf + len), expected);
+                callback = cb;
+                arg = a;
+            });
+    };
+    auto complete = [&] {
+        InSequence seq;
+        EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(10, HIGH));
+        EXPECT_CALL(spi, endTransaction());
+        callback(arg);
+        Mock::VerifyAndClear(&spi);
+        Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    };
+
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(10, OUTPUT));
+    EXPECT_CALL(spi, begin());
+    expectStart({0x00, 0x00});
+    sr.begin();
+    Mock::VerifyAndClear(&spi);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_TRUE(sr.isBusy());
+
+    // Changes during the transfer are sent after it completes
+    sr.digitalWriteBuffered(8, HIGH);
+    sr.updateBufferedOutputs();
+    complete();
+    EXPECT_FALSE(sr.isBusy());
+
+    expectStart({0x01, 0x00});
+    sr.updateBufferedOutputs();
+    Mock::VerifyAndClear(&spi);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    complete();
+    sr.updateBufferedOutputs();
+}
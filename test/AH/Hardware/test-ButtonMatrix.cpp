@@ -0,0 +1,137 @@
+#include <AH/Hardware/ButtonMatrix.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+USING_AH_NAMESPACE;
+
+struct TestMatrix : ButtonMatrix<TestMatrix, 1, 2> {
+    TestMatrix() : ButtonMatrix({2}, {3, 4}) {}
+    MOCK_METHOD(void, onButtonChanged, (uint8_t, uint8_t, bool));
+};
+
+/// Scan the matrix at the given time with the given column states.
+static void scan(TestMatrix &matrix, unsigned long time, bool col0,
+                 bool col1) {
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(time));
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(2, OUTPUT));
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(2, INPUT));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(3))
+        .WillOnce(Return(col0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(4))
+        .WillOnce(Return(col1));
+    matrix.update();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    Mock::VerifyAndClear(&matrix);
+}
+
+TEST(ButtonMatrix, perKeyEager) {
+    TestMatrix matrix;
+    matrix.setDebounceTime(30);
+    matrix.setDebounceMode(ButtonMatrixDebounceMode::Eager);
+
+    scan(matrix, 1000, HIGH, HIGH);
+    // First edge is reported immediately
+    EXPECT_CALL(matrix, onButtonChanged(0, 0, LOW));
+    scan(matrix, 1001, LOW, HIGH);
+    // Bounces of the first key are ignored, other keys are not delayed
+    EXPECT_CALL(matrix, onButtonChanged(0, 1, LOW));
+    scan(matrix, 1003, HIGH, LOW);
+    scan(matrix, 1005, LOW, LOW);
+    scan(matrix, 1025, HIGH, LOW);
+    // After the debounce time, the first key can change again
+    EXPECT_CALL(matrix, onButtonChanged(0, 0, HIGH));
+    scan(matrix, 1035, HIGH, LOW);
+    scan(matrix, 1036, HIGH, LOW);
+}
+
+TEST(ButtonMatrix, perKeyDeferred) {
+    TestMatrix matrix;
+    matrix.setDebounceTime(30);
+    matrix.setDebounceMode(ButtonMatrixDebounceMode::Deferred);
+
+    scan(matrix, 1000, HIGH, HIGH);
+    // The new state is not reported until it's stable
+    scan(matrix, 1001, LOW, HIGH);
+    scan(matrix, 1012, LOW, LOW);
+    // A bounce restarts the debounce interval of that key only
+    scan(matrix, 1025, HIGH, LOW);
+    scan(matrix, 1026, LOW, LOW);
+    scan(matrix, 1032, LOW, LOW);
+    EXPECT_CALL(matrix, onButtonChanged(0, 1, LOW));
+    scan(matrix, 1042, LOW, LOW);
+    EXPECT_CALL(matrix, onButtonChanged(0, 0, LOW));
+    scan(matrix, 1052, LOW, LOW);
+    scan(matrix, 1100, LOW, LOW);
+}
+
+TEST(ButtonMatrix, globalDebounce) {
+    TestMatrix matrix;
+    matrix.setDebounceTime(30);
+
+    EXPECT_CALL(matrix, onButtonChanged(0, 0, LOW));
+    scan(matrix, 1000, LOW, HIGH);
+    // No scans during the debounce time of the whole matrix
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1010));
+    matrix.update();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_CALL(matrix, onButtonChanged(0, 1, LOW));
+    scan(matrix, 1030, LOW, LOW);
+}
+
+struct MockRowReader : ButtonMatrixRowReader {
+    MOCK_METHOD(void, begin, (const pin_t *, const pin_t *), (override));
+    MOCK_METHOD(void, readRow, (uint8_t, uint8_t *), (override));
+};
+
+struct TestMatrix2x10 : ButtonMatrix<TestMatrix2x10, 2, 10> {
+    TestMatrix2x10()
+        : ButtonMatrix({2, 3}, {4, 5, 6, 7, 8, 9, 10, 11, 12, 13}) {}
+    MOCK_METHOD(void, onButtonChanged, (uint8_t, uint8_t, bool));
+};
+
+TEST(ButtonMatrix, rowReader) {
+    MockRowReader reader;
+    TestMatrix2x10 matrix;
+    matrix.setRowReader(&reader);
+
+    EXPECT_CALL(reader, begin(_, _))
+        .WillOnce([](const pin_t *rows, const pin_t *cols) {
+            EXPECT_EQ(rows[1], 3);
+            EXPECT_EQ(cols[9], 13);
+        });
+    matrix.begin(); // no pinMode calls
+    Mock::VerifyAndClear(&reader);
+
+    // Column 9 of row 0 and column 2 of row 1 are pressed
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1000));
+    EXPECT_CALL(reader, readRow(0, _)).WillOnce([](uint8_t, uint8_t *states) {
+        states[0] = 0xFF;
+        states[1] = 0xFD;
+    });
+    EXPECT_CALL(reader, readRow(1, _)).WillOnce([](uint8_t, uint8_t *states) {
+        states[0] = 0xFB;
+        states[1] = 0xFF;
+    });
+    EXPECT_CALL(matrix, onButtonChanged(0, 9, LOW));
+    EXPECT_CALL(matrix, onButtonChanged(1, 2, LOW));
+    matrix.update();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    Mock::VerifyAndClear(&reader);
+    Mock::VerifyAndClear(&matrix);
+}
+
+TEST(ButtonMatrix, extIORowReaderNativePins) {
+    ExtIOButtonMatrixRowReader<1, 2> reader;
+    TestMatrix matrix;
+    matrix.setRowReader(&reader);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(2, INPUT));
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(3, INPUT_PULLUP));
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(4, INPUT_PULLUP));
+    matrix.begin();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    EXPECT_CALL(matrix, onButtonChanged(0, 1, LOW));
+    scan(matrix, 1000, HIGH, LOW);
+}
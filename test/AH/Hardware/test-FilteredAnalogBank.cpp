@@ -0,0 +1,100 @@
+#include <gmock/gmock.h>
+
+#include <AH/Hardware/FilteredAnalogBank.hpp>
+
+USING_AH_NAMESPACE;
+
+using ::testing::Mock;
+using ::testing::Return;
+
+TEST(FilteredAnalogBank, sameAsFilteredAnalog) {
+    constexpr size_t N = 4;
+    FilteredAnalogBank<N, 7> bank = {{A0, A1, A2, A3}};
+    FilteredAnalog<7> analogs[N] = {A0, A1, A2, A3};
+
+    // Slowly varying signals with noise
+    auto signal = [](int n, size_t i) -> analog_t {
+        int value = (n * int(i + 1) * 3) % 2048;
+        value = value < 1024 ? value : 2047 - value;
+        return analog_t(value ^ ((n * 7 + int(i)) % 4));
+    };
+    for (int n = 0; n < 600; ++n) {
+        for (size_t i = 0; i < N; ++i)
+            EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0 + i))
+                .Times(2)
+                .WillRepeatedly(Return(signal(n, i)));
+        bool anyChanged = false;
+        bool changed[N];
+        for (size_t i = 0; i < N; ++i)
+            anyChanged |= changed[i] = analogs[i].update();
+        ASSERT_EQ(bank.update(), anyChanged) << n;
+        Mock::VerifyAndClear(&ArduinoMock::getInstance());
+        for (size_t i = 0; i < N; ++i) {
+            ASSERT_EQ(bank.hasChanged(i), changed[i]) << n << ", " << i;
+            ASSERT_EQ(bank.getValue(i), analogs[i].getValue()) << n;
+        }
+    }
+}
+
+TEST(FilteredAnalogBank, hysteresis) {
+    FilteredAnalogBank<2, 9, 0> bank = {{A0, A1}};
+
+    auto update = [&](analog_t a, analog_t b) {
+        EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+            .WillOnce(Return(a));
+        EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A1))
+            .WillOnce(Return(b));
+        bool changed = bank.update();
+        Mock::VerifyAndClear(&ArduinoMock::getInstance());
+        return changed;
+    };
+
+    EXPECT_TRUE(update(1023, 0));
+    EXPECT_TRUE(bank.hasChanged(0));
+    EXPECT_FALSE(bank.hasChanged(1));
+    EXPECT_EQ(bank.getValue(0), 511);
+    EXPECT_EQ(bank.getValue(1), 0);
+    EXPECT_FLOAT_EQ(bank.getFloatValue(0), 511. / 511);
+
+    EXPECT_FALSE(update(1021, 1));
+    EXPECT_EQ(bank.getValue(0), 511);
+    EXPECT_EQ(bank.getValue(1), 0);
+
+    EXPECT_TRUE(update(1020, 3));
+    EXPECT_TRUE(bank.hasChanged(0));
+    EXPECT_TRUE(bank.hasChanged(1));
+    EXPECT_EQ(bank.getValue(0), 510);
+    EXPECT_EQ(bank.getValue(1), 1);
+
+    EXPECT_FALSE(update(1022, 2));
+    EXPECT_FALSE(bank.hasChanged(0));
+    EXPECT_FALSE(bank.hasChanged(1));
+    EXPECT_EQ(bank.getValue(0), 510);
+    EXPECT_EQ(bank.getValue(1), 1);
+}
+
+TEST(FilteredAnalogBank, invertAndReset) {
+    FilteredAnalogBank<2, 9, 0> bank = {{A0, A1}};
+    bank.invert();
+
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0)).WillOnce(Return(0));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A1))
+        .WillOnce(Return(1023));
+    EXPECT_TRUE(bank.update());
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(bank.getValue(0), 511);
+    EXPECT_EQ(bank.getValue(1), 0);
+
+    bank.reset(1, 503);
+    EXPECT_EQ(bank.getValue(0), 511);
+    EXPECT_EQ(bank.getValue(1), 503);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .WillOnce(Return(2 * 193));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A1))
+        .WillOnce(Return(2 * 17));
+    bank.resetToCurrentValue();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(bank.getValue(0), 193);
+    EXPECT_EQ(bank.getValue(1), 17);
+}
@@ -0,0 +1,114 @@
+#include <AH/Hardware/MCP23017Encoders.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+USING_AH_NAMESPACE;
+
+struct MockWire {
+    MOCK_METHOD(void, beginTransmission, (uint8_t));
+    MOCK_METHOD(size_t, write, (const uint8_t *, size_t));
+    MOCK_METHOD(uint8_t, endTransmission, ());
+    MOCK_METHOD(uint8_t, requestFrom, (uint8_t, size_t));
+    MOCK_METHOD(int, read, ());
+};
+
+/// Expect the initialization of the MCP23017 at address 0x21.
+static void expectBegin(MockWire &wire, bool burst) {
+    // Without burst reads, the GPIOA address is written again before reading
+    int selects = burst ? 1 : 2;
+    EXPECT_CALL(wire, beginTransmission(0x21)).Times(4 + selects);
+    EXPECT_CALL(wire, write(_, 2)).Times(1);       // IOCON
+    EXPECT_CALL(wire, write(_, 3)).Times(3);       // IODIR, GPINTEN, GPPU
+    EXPECT_CALL(wire, write(_, 1)).Times(selects); // GPIOA address
+    EXPECT_CALL(wire, endTransmission()).Times(4 + selects);
+    EXPECT_CALL(wire, requestFrom(0x21, 2)).WillOnce(Return(2));
+    EXPECT_CALL(wire, read()).WillOnce(Return(0xFF)).WillOnce(Return(0xFF));
+}
+
+/// Expect a single I²C write selecting the GPIOA register.
+static void expectSelectGPIOA(MockWire &wire) {
+    EXPECT_CALL(wire, beginTransmission(0x21));
+    EXPECT_CALL(wire, write(_, 1)).WillOnce([](const uint8_t *data, size_t) {
+        EXPECT_EQ(data[0], 0x12);
+        return 1;
+    });
+    EXPECT_CALL(wire, endTransmission());
+}
+
+/// Expect a read of GPIOA and GPIOB.
+static void expectReadGPIO(MockWire &wire, uint8_t a, uint8_t b) {
+    EXPECT_CALL(wire, requestFrom(0x21, 2)).WillOnce(Return(2));
+    EXPECT_CALL(wire, read()).WillOnce(Return(a)).WillOnce(Return(b));
+}
+
+TEST(MCP23017Encoders, selectRegisterEveryRead) {
+    StrictMock<MockWire> wire;
+    MCP23017Encoders<MockWire> encs(wire, 1);
+    expectBegin(wire, false);
+    encs.begin();
+    Mock::VerifyAndClear(&wire);
+
+    expectSelectGPIOA(wire);
+    expectReadGPIO(wire, 0xFE, 0xFF); // Encoder 0 pin A low
+    encs.update();
+    Mock::VerifyAndClear(&wire);
+}
+
+TEST(MCP23017Encoders, burstRead) {
+    StrictMock<MockWire> wire;
+    MCP23017Encoders<MockWire> encs(wire, 1);
+    encs.setBurstRead(true);
+    expectBegin(wire, true);
+    encs.begin();
+    Mock::VerifyAndClear(&wire);
+
+    // Every update is a single read, without writing the register address
+    expectReadGPIO(wire, 0xFE, 0xFF);
+    encs.update();
+    Mock::VerifyAndClear(&wire);
+    expectReadGPIO(wire, 0xFC, 0xFF);
+    encs.update();
+    Mock::VerifyAndClear(&wire);
+    EXPECT_EQ(encs.read(0), -2);
+
+    // After a failed read, the register address is written again
+    EXPECT_CALL(wire, requestFrom(0x21, 2)).WillOnce(Return(0));
+    encs.update();
+    Mock::VerifyAndClear(&wire);
+    expectSelectGPIOA(wire);
+    expectReadGPIO(wire, 0xFD, 0xFF);
+    encs.update();
+    Mock::VerifyAndClear(&wire);
+    expectReadGPIO(wire, 0xFF, 0xFF);
+    encs.update();
+    Mock::VerifyAndClear(&wire);
+    EXPECT_EQ(encs.read(0), -4);
+}
+
+TEST(MCP23017Encoders, interruptGated) {
+    StrictMock<MockWire> wire;
+    MCP23017Encoders<MockWire> encs(wire, 1, 7);
+    encs.setBurstRead(true);
+    expectBegin(wire, true);
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(7, INPUT_PULLUP));
+    encs.begin();
+    Mock::VerifyAndClear(&wire);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // No pin change interrupt, so no I²C traffic
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(7))
+        .WillOnce(Return(HIGH));
+    encs.update();
+    Mock::VerifyAndClear(&wire);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // The interrupt pin is active-low
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(7))
+        .WillOnce(Return(LOW));
+    expectReadGPIO(wire, 0xFE, 0xFF);
+    encs.update();
+    Mock::VerifyAndClear(&wire);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(encs.read(0), -1);
+}
@@ -1,6 +1,7 @@
 #include <gmock/gmock.h>
 
 #include <Banks/Bank.hpp>
+#include <Banks/BankAddresses.hpp>
 
 USING_CS_NAMESPACE;
 using AH::ErrorException;
@@ -48,6 +49,29 @@ TEST(Bank, select) {
     EXPECT_EQ(bank.getSelection(), 5);
 }
 
+struct CountingBankable : BankSettingChangeCallback {
+    CountingBankable(Bank<4> &bank) : bank(bank) { bank.add(this); }
+    ~CountingBankable() { bank.remove(this); }
+    void onBankSettingChange() override { ++changes; }
+    Bank<4> &bank;
+    unsigned changes = 0;
+};
+
+TEST(Bank, selectNotifiesOnce) {
+    Bank<4> bank = {4};
+    CountingBankable a = bank, b = bank, c = bank;
+    bank.select(2);
+    EXPECT_EQ(a.changes, 1u);
+    EXPECT_EQ(c.changes, 1u);
+    EXPECT_EQ(bank.getLastSelectStats().callbacks, 3);
+    // Selecting the same setting again notifies everyone as well
+    bank.select(2);
+    EXPECT_EQ(b.changes, 2u);
+    EXPECT_EQ(bank.getLastSelectStats().callbacks, 3);
+    bank.select(0);
+    EXPECT_EQ(b.changes, 3u);
+}
+
 TEST(Bank, selectOutOfBounds) {
     Bank<10> bank = {4};
     bank.select(9);
@@ -127,4 +151,32 @@ TEST(Transposer, setTransposition12) {
     EXPECT_EQ(t.getOffset(), +12);
     EXPECT_EQ(t.getTransposition(), +1);
     EXPECT_EQ(t.getTranspositionSemitones(), +12);
-}
\ No newline at end of file
+}
+// -------------------------------------------------------------------------- //
+
+TEST(PrecomputedAddress, sameAsSingleAddress) {
+    Bank<4> bank = {2, 0, 1};
+    for (BankType type : {CHANGE_ADDRESS, CHANGE_CHANNEL, CHANGE_CABLENB}) {
+        MIDIAddress base = {0x10, CHANNEL_3, CABLE_2};
+        Bankable::SingleAddress single = {OutputBankConfig<>{bank, type}, base};
+        Bankable::PrecomputedAddress<4> precomputed = {
+            BankConfig<4>{bank, type},
+            base,
+        };
+        EXPECT_EQ(precomputed.getBaseAddress(), base);
+        for (setting_t s = 0; s < 4; ++s) {
+            bank.select(s);
+            EXPECT_EQ(precomputed.getActiveAddress(),
+                      single.getActiveAddress());
+        }
+        // Locking works the same way as well
+        precomputed.lock();
+        bank.select(0);
+        RelativeMIDIAddress offset = {type == CHANGE_ADDRESS ? 8 : 0,
+                                      type == CHANGE_CHANNEL ? 8 : 0,
+                                      type == CHANGE_CABLENB ? 8 : 0};
+        EXPECT_EQ(precomputed.getActiveAddress(), base + offset);
+        precomputed.unlock();
+        EXPECT_EQ(precomputed.getActiveAddress(), single.getActiveAddress());
+    }
+}
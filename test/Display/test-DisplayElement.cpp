@@ -0,0 +1,139 @@
+#include <gmock/gmock.h>
+
+#include <Control_Surface/Control_Surface_Class.hpp>
+#include <Display/DisplayElement.hpp>
+
+USING_CS_NAMESPACE;
+using namespace ::testing;
+
+class MockDisplay : public DisplayInterface {
+  public:
+    MOCK_METHOD(void, clear, (), (override));
+    MOCK_METHOD(void, drawBackground, (), (override));
+    MOCK_METHOD(void, display, (), (override));
+    MOCK_METHOD(void, drawPixel, (int16_t, int16_t, uint16_t), (override));
+    MOCK_METHOD(void, setTextColor, (uint16_t), (override));
+    MOCK_METHOD(void, setTextSize, (uint8_t), (override));
+    MOCK_METHOD(void, setCursor, (int16_t, int16_t), (override));
+    MOCK_METHOD(size_t, write, (uint8_t), (override));
+    MOCK_METHOD(void, drawLine, (int16_t, int16_t, int16_t, int16_t, uint16_t),
+                (override));
+    MOCK_METHOD(void, drawFastVLine, (int16_t, int16_t, int16_t, uint16_t),
+                (override));
+    MOCK_METHOD(void, drawFastHLine, (int16_t, int16_t, int16_t, uint16_t),
+                (override));
+    MOCK_METHOD(void, drawXBitmap,
+                (int16_t, int16_t, const uint8_t[], int16_t, int16_t,
+                 uint16_t),
+                (override));
+    MOCK_METHOD(void, clearArea, (const DisplayRect &), (override));
+    MOCK_METHOD(void, drawBackgroundArea, (const DisplayRect &), (override));
+    MOCK_METHOD(size_t, displayArea, (const DisplayRect &), (override));
+};
+
+class MockElement : public DisplayElement {
+  public:
+    MockElement(DisplayInterface &display, DisplayRect bounds)
+        : DisplayElement(display), bounds(bounds) {}
+    MOCK_METHOD(void, draw, (), (override));
+    MOCK_METHOD(bool, getDirty, (), (const, override));
+    DisplayRect getBounds() const override { return bounds; }
+    DisplayRect bounds;
+};
+
+class MockUnboundedElement : public DisplayElement {
+  public:
+    MockUnboundedElement(DisplayInterface &display)
+        : DisplayElement(display) {}
+    MOCK_METHOD(void, draw, (), (override));
+    MOCK_METHOD(bool, getDirty, (), (const, override));
+};
+
+MATCHER_P4(IsRect, x, y, w, h, "") {
+    return arg.x == x && arg.y == y && arg.w == w && arg.h == h;
+}
+
+TEST(DisplayRect, uniteAndIntersect) {
+    DisplayRect a = {0, 0, 10, 10};
+    DisplayRect b = {20, 5, 4, 10};
+    EXPECT_THAT(a.unite(b), IsRect(0, 0, 24, 15));
+    EXPECT_THAT(a.unite(DisplayRect::empty()), IsRect(0, 0, 10, 10));
+    EXPECT_TRUE(a.unite(DisplayRect::everything()).isEverything());
+    EXPECT_FALSE(a.intersects(b));
+    EXPECT_TRUE(a.intersects({9, 9, 1, 1}));
+    EXPECT_FALSE(a.intersects({10, 0, 1, 1}));
+    EXPECT_TRUE(a.intersects(DisplayRect::everything()));
+    EXPECT_FALSE(a.intersects(DisplayRect::empty()));
+    EXPECT_THAT(DisplayRect::everything().clip(128, 64), IsRect(0, 0, 128, 64));
+    EXPECT_THAT(DisplayRect({-5, 60, 10, 10}).clip(128, 64),
+                IsRect(0, 60, 5, 4));
+    EXPECT_TRUE(DisplayRect({130, 0, 10, 10}).clip(128, 64).isEmpty());
+}
+
+TEST(DisplayElement, partialRedraw) {
+    MockDisplay display;
+    StrictMock<MockElement> a{display, DisplayRect{0, 0, 10, 10}};
+    StrictMock<MockElement> b{display, DisplayRect{20, 0, 10, 10}};
+    StrictMock<MockElement> c{display, DisplayRect{5, 5, 10, 10}};
+
+    EXPECT_CALL(a, getDirty()).WillOnce(Return(true));
+    EXPECT_CALL(b, getDirty()).WillOnce(Return(false));
+    EXPECT_CALL(c, getDirty()).WillOnce(Return(false));
+    {
+        InSequence seq;
+        EXPECT_CALL(ArduinoMock::getInstance(), micros())
+            .WillOnce(Return(1000));
+        EXPECT_CALL(display, clearArea(IsRect(0, 0, 10, 10)));
+        EXPECT_CALL(display, drawBackgroundArea(IsRect(0, 0, 10, 10)));
+        // Only the elements that overlap with the dirty area are redrawn
+        EXPECT_CALL(a, draw());
+        EXPECT_CALL(c, draw());
+        EXPECT_CALL(display, displayArea(IsRect(0, 0, 10, 10)))
+            .WillOnce(Return(20));
+        EXPECT_CALL(ArduinoMock::getInstance(), micros())
+            .WillOnce(Return(1250));
+    }
+    Control_Surface.updateDisplays();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    Mock::VerifyAndClear(&display);
+
+    const DisplayFrameStats &stats = display.getLastFrameStats();
+    EXPECT_THAT(stats.area, IsRect(0, 0, 10, 10));
+    EXPECT_EQ(stats.frameTime, 250);
+    EXPECT_EQ(stats.bytesTransmitted, 20);
+    EXPECT_EQ(stats.elementsDrawn, 2);
+
+    // Nothing dirty, nothing drawn
+    EXPECT_CALL(a, getDirty()).WillOnce(Return(false));
+    EXPECT_CALL(b, getDirty()).WillOnce(Return(false));
+    EXPECT_CALL(c, getDirty()).WillOnce(Return(false));
+    Control_Surface.updateDisplays();
+}
+
+TEST(DisplayElement, unboundedElementRedrawsEverything) {
+    MockDisplay display;
+    StrictMock<MockElement> a{display, DisplayRect{0, 0, 10, 10}};
+    StrictMock<MockUnboundedElement> b{display};
+
+    EXPECT_CALL(a, getDirty()).WillOnce(Return(false));
+    EXPECT_CALL(b, getDirty()).WillOnce(Return(true));
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillOnce(Return(1000))
+        .WillOnce(Return(3000));
+    {
+        InSequence seq;
+        EXPECT_CALL(display, clearArea(Truly([](const DisplayRect &r) {
+                        return r.isEverything();
+                    })));
+        EXPECT_CALL(display, drawBackgroundArea(_));
+        EXPECT_CALL(a, draw());
+        EXPECT_CALL(b, draw());
+        EXPECT_CALL(display, displayArea(_)).WillOnce(Return(1024));
+    }
+    Control_Surface.updateDisplays();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    EXPECT_EQ(display.getLastFrameStats().frameTime, 2000);
+    EXPECT_EQ(display.getLastFrameStats().bytesTransmitted, 1024);
+    EXPECT_EQ(display.getLastFrameStats().elementsDrawn, 2);
+}
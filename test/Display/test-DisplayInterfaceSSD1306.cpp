@@ -0,0 +1,135 @@
+#include <gmock/gmock.h>
+
+#include <Display/DisplayInterfaces/DisplayInterfaceSSD1306.hpp>
+
+USING_CS_NAMESPACE;
+using namespace ::testing;
+
+class TestDisplay : public SSD1306_PageDiffDisplayInterface<> {
+  public:
+    TestDisplay(Adafruit_SSD1306 &display)
+        : SSD1306_PageDiffDisplayInterface(display) {}
+    void drawBackground() override {}
+    MOCK_METHOD(bool, sendSpan,
+                (uint8_t, uint8_t, uint8_t, const uint8_t *), (override));
+};
+
+TEST(SSD1306_PageDiffDisplayInterface, sendChangedSpans) {
+    Adafruit_SSD1306 ssd1306;
+    StrictMock<TestDisplay> display(ssd1306);
+
+    // The first frame is always sent completely
+    display.begin();
+    EXPECT_EQ(ssd1306.displayCount, 1u);
+    EXPECT_TRUE(display.getTransferStats().fullFrame);
+    EXPECT_EQ(display.getTransferStats().bytes, 1024);
+
+    // Nothing changed, nothing is sent
+    EXPECT_EQ(display.displayArea(DisplayRect::everything()), 0u);
+    EXPECT_EQ(display.getTransferStats().spans, 0);
+    EXPECT_EQ(display.getTransferStats().dirtyPages, 0);
+
+    // Nearby changes are merged into a single span
+    display.drawPixel(10, 3, WHITE);
+    display.drawPixel(14, 3, WHITE);
+    display.drawPixel(100, 20, WHITE);
+    {
+        InSequence seq;
+        EXPECT_CALL(display, sendSpan(0, 10, 5, _))
+            .WillOnce([](uint8_t, uint8_t, uint8_t, const uint8_t *data) {
+                EXPECT_EQ(std::vector<uint8_t>(data, data + 5),
+                          std::vector<uint8_t>({0x08, 0, 0, 0, 0x08}));
+                return true;
+            });
+        EXPECT_CALL(display, sendSpan(2, 100, 1, Pointee(0x10)))
+            .WillOnce(Return(true));
+    }
+    EXPECT_EQ(display.displayArea(DisplayRect::everything()), 6u);
+    Mock::VerifyAndClear(&display);
+    EXPECT_EQ(ssd1306.displayCount, 1u);
+    EXPECT_FALSE(display.getTransferStats().fullFrame);
+    EXPECT_EQ(display.getTransferStats().spans, 2);
+    EXPECT_EQ(display.getTransferStats().dirtyPages, 2);
+    EXPECT_EQ(display.getTransferStats().bytes, 6);
+
+    // Changes that are far apart are sent separately
+    display.drawPixel(10, 3, BLACK);
+    display.drawPixel(30, 3, WHITE);
+    EXPECT_CALL(display, sendSpan(0, 10, 1, Pointee(0x00)))
+        .WillOnce(Return(true));
+    EXPECT_CALL(display, sendSpan(0, 30, 1, Pointee(0x08)))
+        .WillOnce(Return(true));
+    EXPECT_EQ(display.displayArea(DisplayRect::everything()), 2u);
+    Mock::VerifyAndClear(&display);
+    EXPECT_EQ(display.getTransferStats().dirtyPages, 1);
+
+    // Clearing the display sends only the columns that contained pixels
+    display.clear();
+    EXPECT_CALL(display, sendSpan(0, 14, 1, _)).WillOnce(Return(true));
+    EXPECT_CALL(display, sendSpan(0, 30, 1, _)).WillOnce(Return(true));
+    EXPECT_CALL(display, sendSpan(2, 100, 1, _)).WillOnce(Return(true));
+    EXPECT_EQ(display.displayArea(DisplayRect::everything()), 3u);
+    Mock::VerifyAndClear(&display);
+}
+
+TEST(SSD1306_PageDiffDisplayInterface, fallBackToFullTransfer) {
+    Adafruit_SSD1306 ssd1306;
+    StrictMock<TestDisplay> display(ssd1306);
+    display.begin();
+
+    display.drawPixel(0, 0, WHITE);
+    EXPECT_CALL(display, sendSpan(0, 0, 1, _)).WillOnce(Return(false));
+    EXPECT_EQ(display.displayArea(DisplayRect::everything()), 1024u);
+    Mock::VerifyAndClear(&display);
+    EXPECT_EQ(ssd1306.displayCount, 2u);
+    EXPECT_TRUE(display.getTransferStats().fullFrame);
+
+    // After invalidating, the next frame is sent completely
+    display.invalidate();
+    EXPECT_EQ(display.displayArea(DisplayRect::everything()), 1024u);
+    EXPECT_EQ(ssd1306.displayCount, 3u);
+}
+
+struct MockI2CWire {
+    MOCK_METHOD(void, beginTransmission, (uint8_t));
+    MOCK_METHOD(size_t, write, (const uint8_t *, size_t));
+    MOCK_METHOD(uint8_t, endTransmission, ());
+};
+
+class I2CTestDisplay : public SSD1306_PageDiffDisplayInterface<> {
+  public:
+    I2CTestDisplay(Adafruit_SSD1306 &display, MockI2CWire &wire)
+        : SSD1306_PageDiffDisplayInterface(display), wire(wire) {}
+    void drawBackground() override {}
+    bool sendSpan(uint8_t page, uint8_t firstColumn, uint8_t numColumns,
+                  const uint8_t *data) override {
+        return sendSpanI2C(wire, 0x3C, page, firstColumn, numColumns, data);
+    }
+    MockI2CWire &wire;
+};
+
+TEST(SSD1306_PageDiffDisplayInterface, sendSpanI2C) {
+    Adafruit_SSD1306 ssd1306;
+    StrictMock<MockI2CWire> wire;
+    I2CTestDisplay display(ssd1306, wire);
+    display.begin();
+
+    display.drawFastHLine(50, 60, 40, WHITE);
+    ssd1306.commands.clear();
+    {
+        InSequence seq;
+        for (size_t chunk : {31, 9}) {
+            EXPECT_CALL(wire, beginTransmission(0x3C));
+            EXPECT_CALL(wire, write(Pointee(0x40), 1)).WillOnce(Return(1));
+            EXPECT_CALL(wire, write(Pointee(0x10), chunk))
+                .WillOnce(Return(chunk));
+            EXPECT_CALL(wire, endTransmission()).WillOnce(Return(0));
+        }
+    }
+    EXPECT_EQ(display.displayArea(DisplayRect::everything()), 40u);
+    Mock::VerifyAndClear(&wire);
+    EXPECT_EQ(ssd1306.commands,
+              std::vector<uint8_t>({SSD1306_PAGEADDR, 7, 7, SSD1306_COLUMNADDR,
+                                    50, 89}));
+    EXPECT_EQ(ssd1306.displayCount, 1u);
+}
@@ -93,6 +93,55 @@ TEST(LCD, FillManyBuffersWithOneMIDIMessage) {
     EXPECT_STREQ(lcds[3].getText(), "mnop");
 }
 
+TEST(LCD, Chunked) {
+    MCU::LCD<8> lcd(2);
+    std::vector<std::vector<uint8_t>> chunks = {
+        {0xF0, 0x00, 0x00, 0x66},
+        {0x10, 0x12, 0x00, 'a', 'b', 'c'},
+        {'d', 'e', 'f', 'g'},
+        {'h', 'i', 'j', 'k', 'l', 0xF7},
+    };
+    // The header is incomplete, so the message could be meant for others
+    EXPECT_FALSE(MIDIInputElementSysEx::updateAllWith(chunks[0]));
+    for (size_t i = 1; i < chunks.size(); ++i)
+        EXPECT_TRUE(MIDIInputElementSysEx::updateAllWith(chunks[i]));
+    EXPECT_STREQ(lcd.getText(), "cdefghij");
+}
+
+TEST(LCD, ChunkedManyBuffers) {
+    MCU::LCD<4> lcds[] = {0x0, 0x4};
+    std::vector<std::vector<uint8_t>> chunks = {
+        {0xF0, 0x00, 0x00, 0x66, 0x10, 0x12, 0x02, 'c', 'd'},
+        {'e', 'f', 'g', 0xF7},
+    };
+    for (auto &chunk : chunks)
+        MIDIInputElementSysEx::updateAllWith(chunk);
+    EXPECT_STREQ(lcds[0].getText(), "  cd");
+    EXPECT_STREQ(lcds[1].getText(), "efg ");
+}
+
+TEST(LCD, ChunkedOtherMessage) {
+    MCU::LCD<4> lcd(0);
+    lcd.clearDirty();
+    std::vector<std::vector<uint8_t>> chunks = {
+        {0xF0, 0x00, 0x00, 0x66, 0x10, 0x13, 0x00, 'a'},
+        {'b', 'c', 'd', 0xF7},
+    };
+    for (auto &chunk : chunks)
+        EXPECT_FALSE(MIDIInputElementSysEx::updateAllWith(chunk));
+    EXPECT_STREQ(lcd.getText(), "    ");
+    EXPECT_FALSE(lcd.getDirty());
+}
+
+TEST(LCD, ChunkedMissedStart) {
+    MCU::LCD<4> lcd(0);
+    lcd.clearDirty();
+    std::vector<uint8_t> chunk = {'a', 'b', 'c', 'd', 0xF7};
+    EXPECT_FALSE(MIDIInputElementSysEx::updateAllWith(chunk));
+    EXPECT_STREQ(lcd.getText(), "    ");
+    EXPECT_FALSE(lcd.getDirty());
+}
+
 TEST(LCDlength, len) {
     auto range = {0, 1, 2, 3, 4, 5, 6, 7};
     for (int a : range) {
@@ -4,6 +4,7 @@
 #include <MIDI_Inputs/MIDIInputElementMatchers.hpp>
 #include <MIDI_Inputs/NoteCCKPRange.hpp>
 #include <MIDI_Inputs/NoteCCKPValue.hpp>
+#include <MIDI_Inputs/ParameterNumberValue.hpp>
 
 using namespace CS;
 
@@ -117,3 +118,172 @@ TEST(TwoByteRangeMIDIMatcher, ControlChange) {
         {MIDIMessageType::CONTROL_CHANGE, CHANNEL_10, 0x18, 0x43});
     testing::Mock::VerifyAndClear(&mn);
 }
+
+// -------------------------------------------------------------------------- //
+
+TEST(MIDIInputElementIndex, SingleAndRange) {
+    using Element = MIDIInputElement<MIDIMessageType::CONTROL_CHANGE>;
+    MIDIInputElementIndex<MIDIMessageType::CONTROL_CHANGE, 16, 2> index;
+    CCValue single{{0x10, CHANNEL_2, CABLE_3}};
+    CCRange<4> range{{0x20, CHANNEL_2, CABLE_3}};
+
+    EXPECT_TRUE(Element::updateAllWith(
+        {MIDIMessageType::CONTROL_CHANGE, CHANNEL_2, 0x10, 0x11, CABLE_3}));
+    EXPECT_TRUE(index.isValid());
+    EXPECT_FALSE(index.hasOverflowed());
+    EXPECT_EQ(index.getNumberOfEntries(), 5);
+    EXPECT_EQ(single.getValue(), 0x11);
+
+    EXPECT_TRUE(Element::updateAllWith(
+        {MIDIMessageType::CONTROL_CHANGE, CHANNEL_2, 0x23, 0x12, CABLE_3}));
+    EXPECT_EQ(range.getValue(3), 0x12);
+
+    // Wrong address, channel and cable
+    EXPECT_FALSE(Element::updateAllWith(
+        {MIDIMessageType::CONTROL_CHANGE, CHANNEL_2, 0x24, 0x13, CABLE_3}));
+    EXPECT_FALSE(Element::updateAllWith(
+        {MIDIMessageType::CONTROL_CHANGE, CHANNEL_3, 0x10, 0x13, CABLE_3}));
+    EXPECT_FALSE(Element::updateAllWith(
+        {MIDIMessageType::CONTROL_CHANGE, CHANNEL_2, 0x10, 0x13, CABLE_4}));
+    EXPECT_EQ(single.getValue(), 0x11);
+
+    // Disabled elements don't receive any messages
+    single.disable();
+    EXPECT_FALSE(index.isValid());
+    EXPECT_FALSE(Element::updateAllWith(
+        {MIDIMessageType::CONTROL_CHANGE, CHANNEL_2, 0x10, 0x14, CABLE_3}));
+    EXPECT_EQ(index.getNumberOfEntries(), 4);
+    single.enable();
+    EXPECT_EQ(single.getValue(), 0x11);
+}
+
+TEST(MIDIInputElementIndex, EnableAfterBuild) {
+    using Element = MIDIInputElement<MIDIMessageType::CONTROL_CHANGE>;
+    MIDIInputElementIndex<MIDIMessageType::CONTROL_CHANGE, 16, 2> index;
+    CCValue a{{0x10, CHANNEL_2}};
+    CCValue b{{0x11, CHANNEL_2}};
+    CCValue c{{0x12, CHANNEL_2}};
+
+    // The index is built while b and c are disabled
+    Element::disable(b);
+    Element::disable(&c);
+    EXPECT_TRUE(Element::updateAllWith(
+        {MIDIMessageType::CONTROL_CHANGE, CHANNEL_2, 0x10, 0x21}));
+    EXPECT_TRUE(index.isValid());
+    EXPECT_EQ(index.getNumberOfEntries(), 1);
+
+    // Enabling them again makes the index rebuild, without having to
+    // invalidate it manually
+    b.enable();
+    EXPECT_FALSE(index.isValid());
+    EXPECT_TRUE(Element::updateAllWith(
+        {MIDIMessageType::CONTROL_CHANGE, CHANNEL_2, 0x11, 0x22}));
+    EXPECT_EQ(b.getValue(), 0x22);
+    Element::enable(&c);
+    EXPECT_TRUE(Element::updateAllWith(
+        {MIDIMessageType::CONTROL_CHANGE, CHANNEL_2, 0x12, 0x23}));
+    EXPECT_EQ(c.getValue(), 0x23);
+    EXPECT_EQ(index.getNumberOfEntries(), 3);
+}
+
+TEST(MIDIInputElementIndex, Bankable) {
+    using Element = MIDIInputElement<MIDIMessageType::NOTE_ON>;
+    MIDIInputElementIndex<MIDIMessageType::NOTE_ON, 32> index;
+    Bank<3> bank(4);
+    Bankable::NoteValue<3> address{bank, {0x10, CHANNEL_5}};
+    Bankable::NoteValue<3> channel{{bank, CHANGE_CHANNEL}, {0x11, CHANNEL_5}};
+    Bankable::NoteRange<3, 2> range{bank, {0x30, CHANNEL_5}};
+
+    EXPECT_TRUE(Element::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_5, 0x18, 0x7F}));
+    EXPECT_EQ(index.getNumberOfEntries(), 3 + 3 + 3 * 2);
+    EXPECT_EQ(address.getValue(2), 0x7F);
+    EXPECT_TRUE(Element::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_9, 0x11, 0x7E}));
+    EXPECT_EQ(channel.getValue(1), 0x7E);
+    EXPECT_TRUE(Element::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_5, 0x35, 0x7D}));
+    EXPECT_EQ(range.getValue(1, 1), 0x7D);
+    EXPECT_FALSE(Element::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_5, 0x36, 0x7C}));
+
+    // Changing the bank setting doesn't change the addresses that are matched
+    bank.select(2);
+    EXPECT_TRUE(index.isValid());
+    EXPECT_EQ(address.getValue(), 0x7F);
+    EXPECT_TRUE(Element::updateAllWith(
+        {MIDIMessageType::NOTE_ON, CHANNEL_5, 0x10, 0x7B}));
+    EXPECT_EQ(address.getValue(0), 0x7B);
+}
+
+TEST(MIDIInputElementIndex, FallbackAndInvalidation) {
+    using Element = MIDIInputElement<MIDIMessageType::CHANNEL_PRESSURE>;
+    struct M : MatchingMIDIInputElement<MIDIMessageType::CHANNEL_PRESSURE,
+                                        OneByteMIDIMatcher> {
+        M(MIDIChannelCable a) : MatchingMIDIInputElement(a) {}
+        MOCK_METHOD(void, handleUpdateHelper, (uint8_t));
+        void handleUpdate(OneByteMIDIMatcher::Result m) override {
+            handleUpdateHelper(m.value);
+        }
+    } mn{{CHANNEL_10, CABLE_7}};
+
+    MIDIInputElementIndex<MIDIMessageType::CHANNEL_PRESSURE, 4> index;
+    EXPECT_CALL(mn, handleUpdateHelper(0x0C));
+    EXPECT_TRUE(Element::updateAllWith(
+        {MIDIMessageType::CHANNEL_PRESSURE, CHANNEL_10, 0x0C, 0x00, CABLE_7}));
+    testing::Mock::VerifyAndClear(&mn);
+    EXPECT_EQ(index.getNumberOfEntries(), 1);
+
+    {
+        M other{{CHANNEL_11, CABLE_7}};
+        EXPECT_FALSE(index.isValid());
+        EXPECT_CALL(other, handleUpdateHelper(0x0D));
+        EXPECT_TRUE(Element::updateAllWith({MIDIMessageType::CHANNEL_PRESSURE,
+                                            CHANNEL_11, 0x0D, 0x00, CABLE_7}));
+        EXPECT_EQ(index.getNumberOfEntries(), 2);
+    }
+    EXPECT_FALSE(index.isValid());
+    EXPECT_FALSE(Element::updateAllWith(
+        {MIDIMessageType::CHANNEL_PRESSURE, CHANNEL_11, 0x0D, 0x00, CABLE_7}));
+    EXPECT_EQ(index.getNumberOfEntries(), 1);
+}
+
+TEST(MIDIInputElementIndex, Overflow) {
+    using Element = MIDIInputElement<MIDIMessageType::CONTROL_CHANGE>;
+    MIDIInputElementIndex<MIDIMessageType::CONTROL_CHANGE, 4> index;
+    CCValue single{{0x10, CHANNEL_2}};
+    CCRange<8> range{{0x20, CHANNEL_2}};
+    EXPECT_TRUE(Element::updateAllWith(
+        {MIDIMessageType::CONTROL_CHANGE, CHANNEL_2, 0x27, 0x11}));
+    EXPECT_TRUE(index.hasOverflowed());
+    EXPECT_EQ(range.getValue(7), 0x11);
+    EXPECT_TRUE(Element::updateAllWith(
+        {MIDIMessageType::CONTROL_CHANGE, CHANNEL_2, 0x10, 0x12}));
+    EXPECT_EQ(single.getValue(), 0x12);
+}
+
+TEST(ParameterNumberValue, Match) {
+    ParameterNumberValue rpn{ParameterNumberMessage::RPN, 0x0002,
+                             {CHANNEL_3, CABLE_2}};
+    ParameterNumberValue nrpn{ParameterNumberMessage::NRPN, 0x0002,
+                              {CHANNEL_3, CABLE_2}};
+    rpn.clearDirty();
+    nrpn.clearDirty();
+    ParameterNumberMessage msg{ParameterNumberMessage::NRPN, 0x0002, 0x1234,
+                               CHANNEL_3, CABLE_2};
+    EXPECT_TRUE(MIDIInputElementParameterNumber::updateAllWith(msg));
+    EXPECT_EQ(nrpn.getValue(), 0x1234);
+    EXPECT_TRUE(nrpn.getDirty());
+    EXPECT_EQ(rpn.getValue(), 0);
+    EXPECT_FALSE(rpn.getDirty());
+    msg.number = 0x0003;
+    EXPECT_FALSE(MIDIInputElementParameterNumber::updateAllWith(msg));
+    msg = {ParameterNumberMessage::RPN, 0x0002, 0x0567, CHANNEL_3, CABLE_1};
+    EXPECT_FALSE(MIDIInputElementParameterNumber::updateAllWith(msg));
+    msg.cable = CABLE_2;
+    EXPECT_TRUE(MIDIInputElementParameterNumber::updateAllWith(msg));
+    EXPECT_EQ(rpn.getValue(), 0x0567);
+    MIDIInputElementParameterNumber::resetAll();
+    EXPECT_EQ(rpn.getValue(), 0);
+    EXPECT_EQ(nrpn.getValue(), 0);
+}
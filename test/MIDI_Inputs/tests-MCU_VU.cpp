@@ -115,7 +115,7 @@ TEST(MCUVU, decay) {
     EXPECT_EQ(vu.getValue(), 0xA);
     EXPECT_CALL(ArduinoMock::getInstance(), millis())
         .WillOnce(Return(decayTime));
-    MIDIInputElementCP::updateAll();
+    MCU::VUDecayScheduler::getInstance().update();
     EXPECT_EQ(vu.getValue(), 0x9);
 
     Mock::VerifyAndClear(&ArduinoMock::getInstance());
@@ -172,8 +172,9 @@ TEST(MCUVUBankable, setValueBankChangeAddress) {
         (track + 4 - 1) << 4 | 0xA,
         0,
     };
-    // Active bank is never updated, so decay timer is never reset, and millis
-    // shouldn't be called.
+    // Only an inactive bank is updated while the decay wheel is idle, so the
+    // time is read once to schedule its decay.
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(0));
     MIDIInputElementCP::updateAllWith(midimsg);
     EXPECT_EQ(vu.getValue(), 0x0);
     bank.select(1);
@@ -199,8 +200,9 @@ TEST(MCUVUBankable, setValueBankChangeChannel) {
         (track - 1) << 4 | 0xB,
         0,
     };
-    // Active bank is never updated, so decay timer is never reset, and millis
-    // shouldn't be called.
+    // Only inactive banks are updated while the decay wheel is idle, so the
+    // time is read once to schedule their decay.
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(0));
     MIDIInputElementCP::updateAllWith(midimsg1);
     MIDIInputElementCP::updateAllWith(midimsg2);
     EXPECT_EQ(vu.getValue(), 0x0);
@@ -231,8 +233,9 @@ TEST(MCUVUBankable, setValueBankChangeCN) {
         0,
         CABLE_9,
     };
-    // Active bank is never updated, so decay timer is never reset, and millis
-    // shouldn't be called.
+    // Only inactive banks are updated while the decay wheel is idle, so the
+    // time is read once to schedule their decay.
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(0));
     MIDIInputElementCP::updateAllWith(midimsg1);
     MIDIInputElementCP::updateAllWith(midimsg2);
     EXPECT_EQ(vu.getValue(), 0x0);
@@ -244,6 +247,58 @@ TEST(MCUVUBankable, setValueBankChangeCN) {
     Mock::VerifyAndClear(&ArduinoMock::getInstance());
 }
 
+TEST(MCUVUBankable, decayInactiveBankWhileIdle) {
+    auto &scheduler = MCU::VUDecayScheduler::getInstance();
+    Bank<2> bank(4);
+    constexpr Channel channel = CHANNEL_3;
+    constexpr uint8_t track = 5;
+    constexpr unsigned int decayTime = 150;
+    MCU::Bankable::VU<2> vu = {bank, track, channel, decayTime};
+    ChannelMessage active = {
+        MIDIMessageType::CHANNEL_PRESSURE,
+        channel,
+        (track - 1) << 4 | 0x1,
+        0,
+    };
+    ChannelMessage inactive = {
+        MIDIMessageType::CHANNEL_PRESSURE,
+        channel,
+        (track + 4 - 1) << 4 | 0x3,
+        0,
+    };
+
+    // Let the active bank decay to zero, so the wheel is advanced to a time
+    // that is long gone when the inactive bank is updated.
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(0));
+    MIDIInputElementCP::updateAllWith(active);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillOnce(Return(decayTime));
+    scheduler.update();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(vu.getValue(), 0x0);
+    EXPECT_EQ(scheduler.getNumberOfPendingTimers(), 0);
+
+    // No timers are pending, so the inactive bank reads the current time
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(10000));
+    MIDIInputElementCP::updateAllWith(inactive);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(scheduler.getNumberOfPendingTimers(), 1);
+
+    // It doesn't decay before its full decay time has passed
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillOnce(Return(10000 + decayTime - 1));
+    scheduler.update();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(vu.getValue(1), 0x3);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillOnce(Return(10000 + decayTime));
+    scheduler.update();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(vu.getValue(1), 0x2);
+}
+
 TEST(MCUVUBankable, overloadBankChangeAddress) {
     Bank<2> bank(4);
     constexpr Channel channel = CHANNEL_3;
@@ -319,19 +374,130 @@ TEST(MCUVULEDsBankable, displayOnBankChange) {
     EXPECT_EQ(vu.getValue(), 0xC);
     Mock::VerifyAndClear(&ArduinoMock::getInstance());
 
-    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(0));
+    // The decay timer is still running, so changing banks doesn't read the
+    // time
     EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(0, HIGH));
     EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(1, LOW));
-    bank.select(1); // marks dirty
-    vu.update();    // notices dirty flag and updates the LEDs
+    bank.select(1); // marks dirty and updates the LEDs
+    vu.update();
     EXPECT_EQ(vu.getValue(), 0x6);
     Mock::VerifyAndClear(&ArduinoMock::getInstance());
 
-    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(0));
     EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(0, HIGH));
     EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(1, HIGH));
     bank.select(0);
     vu.update();
     EXPECT_EQ(vu.getValue(), 0xC);
     Mock::VerifyAndClear(&ArduinoMock::getInstance());
-}
\ No newline at end of file
+
+    // The decay of the active bank updates the LEDs
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillOnce(Return(decayTime));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(0, HIGH));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(1, HIGH));
+    MCU::VUDecayScheduler::getInstance().update();
+    EXPECT_EQ(vu.getValue(), 0xB);
+    EXPECT_EQ(vu.getValue(1), 0x5);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+// -------------------------------------------------------------------------- //
+
+TEST(MCUVUDecayScheduler, idleMetersCostNothing) {
+    auto &scheduler = MCU::VUDecayScheduler::getInstance();
+    MCU::VU vu1 = {1, CHANNEL_1, 300};
+    MCU::VU vu2 = {2, CHANNEL_1, 300};
+    // No meters are active, so the time isn't even read
+    scheduler.update();
+    EXPECT_EQ(scheduler.getNumberOfPendingTimers(), 0);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1000));
+    MIDIInputElementCP::updateAllWith(
+        ChannelMessage{MIDIMessageType::CHANNEL_PRESSURE, CHANNEL_1, 0x02});
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(scheduler.getNumberOfPendingTimers(), 1);
+    vu1.clearDirty();
+    vu2.clearDirty();
+
+    // Nothing happens before the deadline
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1299));
+    scheduler.update();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(vu1.getValue(), 2);
+    EXPECT_FALSE(vu1.getDirty());
+
+    // Only the active meter is decayed and marked dirty
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1310));
+    scheduler.update();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(vu1.getValue(), 1);
+    EXPECT_TRUE(vu1.getDirty());
+    EXPECT_FALSE(vu2.getDirty());
+
+    // The next step is relative to the previous deadline, not the update time
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1600));
+    scheduler.update();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(vu1.getValue(), 0);
+
+    // At zero, the meter is removed from the wheel
+    EXPECT_EQ(scheduler.getNumberOfPendingTimers(), 0);
+    scheduler.update();
+}
+
+TEST(MCUVUDecayScheduler, longerThanWheel) {
+    auto &scheduler = MCU::VUDecayScheduler::getInstance();
+    constexpr unsigned int decayTime = 2000;
+    static_assert(decayTime > MCU::VUDecayScheduler::Slots *
+                                  MCU::VUDecayScheduler::Resolution,
+                  "");
+    MCU::VU vu = {1, CHANNEL_1, decayTime};
+
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(0));
+    MIDIInputElementCP::updateAllWith(
+        ChannelMessage{MIDIMessageType::CHANNEL_PRESSURE, CHANNEL_1, 0x01});
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // The timer stays in the wheel for multiple revolutions
+    for (unsigned long t = 0; t < decayTime; t += 50) {
+        EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(t));
+        scheduler.update();
+        Mock::VerifyAndClear(&ArduinoMock::getInstance());
+        ASSERT_EQ(vu.getValue(), 1) << t;
+    }
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillOnce(Return(decayTime));
+    scheduler.update();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(vu.getValue(), 0);
+}
+
+TEST(MCUVUDecayScheduler, holdAndReset) {
+    auto &scheduler = MCU::VUDecayScheduler::getInstance();
+    MCU::VU hold = {1, CHANNEL_1, MCU::VUDecay::Hold};
+    MCU::VU vu = {2, CHANNEL_1};
+
+    // Meters that hold their value are never scheduled
+    MIDIInputElementCP::updateAllWith(
+        ChannelMessage{MIDIMessageType::CHANNEL_PRESSURE, CHANNEL_1, 0x05});
+    EXPECT_EQ(scheduler.getNumberOfPendingTimers(), 0);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(0));
+    MIDIInputElementCP::updateAllWith(
+        ChannelMessage{MIDIMessageType::CHANNEL_PRESSURE, CHANNEL_1, 0x15});
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(scheduler.getNumberOfPendingTimers(), 1);
+
+    // Resetting or destroying a meter removes it from the wheel
+    vu.reset();
+    EXPECT_EQ(scheduler.getNumberOfPendingTimers(), 0);
+    {
+        MCU::VU tmp = {3, CHANNEL_1};
+        EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(0));
+        MIDIInputElementCP::updateAllWith(ChannelMessage{
+            MIDIMessageType::CHANNEL_PRESSURE, CHANNEL_1, 0x25});
+        Mock::VerifyAndClear(&ArduinoMock::getInstance());
+        EXPECT_EQ(scheduler.getNumberOfPendingTimers(), 1);
+    }
+    EXPECT_EQ(scheduler.getNumberOfPendingTimers(), 0);
+}
@@ -0,0 +1,106 @@
+#include <MIDI_Interfaces/BLEMIDI/BLEMIDIScheduler.hpp>
+#include <gtest/gtest.h>
+
+using namespace CS;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+using time_point = BLEMIDIScheduler::time_point;
+
+TEST(BLEMIDIScheduler, minMTU) {
+    BLEMIDIScheduler sched;
+    EXPECT_EQ(sched.getMinMTU(), 23);
+    sched.connect(1);
+    sched.setMTU(1, 185);
+    EXPECT_EQ(sched.getMinMTU(), 185);
+    sched.setMTU(2, 100); // implicitly connects
+    EXPECT_EQ(sched.getNumberOfConnections(), 2);
+    EXPECT_EQ(sched.getMinMTU(), 100);
+    sched.disconnect(2);
+    EXPECT_EQ(sched.getMinMTU(), 185);
+    // Reconnecting resets the MTU
+    sched.connect(1);
+    EXPECT_EQ(sched.getMinMTU(), 23);
+    sched.disconnect(1);
+    EXPECT_EQ(sched.getNumberOfConnections(), 0);
+    EXPECT_EQ(sched.getMinMTU(), 23);
+}
+
+TEST(BLEMIDIScheduler, tooManyConnections) {
+    BLEMIDIScheduler sched;
+    for (uint16_t i = 0; i < BLEMIDIScheduler::MaxConnections + 1; ++i)
+        sched.setMTU(i, 100 + i);
+    EXPECT_EQ(sched.getNumberOfConnections(), BLEMIDIScheduler::MaxConnections);
+    EXPECT_EQ(sched.getMinMTU(), 100);
+}
+
+TEST(BLEMIDIScheduler, fixedTimeout) {
+    BLEMIDIScheduler sched;
+    time_point start {milliseconds {1000}};
+    EXPECT_EQ(sched.getConnectionInterval(), microseconds::zero());
+    EXPECT_EQ(sched.getFlushDeadline(start, milliseconds {10}),
+              start + milliseconds {10});
+}
+
+TEST(BLEMIDIScheduler, intervalBudget) {
+    BLEMIDIScheduler sched;
+    sched.setIntervalBudget(milliseconds {30});
+    sched.setFlushMargin(milliseconds {2});
+    time_point start {milliseconds {1000}};
+    EXPECT_EQ(sched.getConnectionInterval(), milliseconds {30});
+    EXPECT_EQ(sched.getFlushDeadline(start, milliseconds {10}),
+              start + milliseconds {28});
+}
+
+TEST(BLEMIDIScheduler, connectionEvents) {
+    BLEMIDIScheduler sched;
+    sched.setIntervalBudget(milliseconds {30});
+    sched.setFlushMargin(milliseconds {2});
+    time_point anchor {milliseconds {1000}};
+    sched.setConnectionInterval(0, 12, anchor); // 12 × 1.25 ms = 15 ms
+    EXPECT_EQ(sched.getConnectionInterval(), milliseconds {15});
+
+    auto deadline = [&](microseconds t) {
+        return sched.getFlushDeadline(anchor + t, milliseconds {10}) - anchor;
+    };
+    // Connection events at 0, 15, 30 ms ..., flush 2 ms before them
+    EXPECT_EQ(deadline(milliseconds {1}), milliseconds {13});
+    EXPECT_EQ(deadline(milliseconds {13}), milliseconds {13});
+    EXPECT_EQ(deadline(microseconds {13001}), milliseconds {28});
+    EXPECT_EQ(deadline(milliseconds {20}), milliseconds {28});
+    EXPECT_EQ(deadline(milliseconds {150}), milliseconds {163});
+    // Before the anchor, the anchor itself is the next event
+    EXPECT_EQ(deadline(-milliseconds {5}), -milliseconds {2});
+}
+
+TEST(BLEMIDIScheduler, shortestInterval) {
+    BLEMIDIScheduler sched;
+    sched.setFlushMargin(milliseconds {1});
+    time_point anchor {milliseconds {1000}};
+    sched.setConnectionInterval(0, 24, anchor); // 30 ms
+    sched.setConnectionInterval(1, 8, anchor);  // 10 ms
+    EXPECT_EQ(sched.getConnectionInterval(), milliseconds {10});
+    EXPECT_EQ(sched.getFlushDeadline(anchor + milliseconds {3}, {}),
+              anchor + milliseconds {9});
+    sched.disconnect(1);
+    EXPECT_EQ(sched.getConnectionInterval(), milliseconds {30});
+    EXPECT_EQ(sched.getFlushDeadline(anchor + milliseconds {3}, {}),
+              anchor + milliseconds {29});
+}
+
+TEST(BLEMIDIScheduler, statistics) {
+    BLEMIDIScheduler sched;
+    EXPECT_EQ(sched.getStatistics().getBytesPerNotification(), 0);
+    EXPECT_EQ(sched.getStatistics().getAverageDelay(), microseconds::zero());
+    sched.recordNotification(20, microseconds {1000});
+    sched.recordNotification(10, microseconds {4000});
+    sched.recordNotification(15, microseconds {1000});
+    auto stats = sched.getStatistics();
+    EXPECT_EQ(stats.notifications, 3u);
+    EXPECT_EQ(stats.bytes, 45u);
+    EXPECT_EQ(stats.getBytesPerNotification(), 15);
+    EXPECT_EQ(stats.getAverageDelay(), microseconds {2000});
+    EXPECT_EQ(stats.maxDelay, microseconds {4000});
+    sched.resetStatistics();
+    EXPECT_EQ(sched.getStatistics().notifications, 0u);
+}
@@ -1,6 +1,9 @@
 #include <MIDI_Interfaces/BluetoothMIDI_Interface.hpp>
 #include <MIDI_Interfaces/MIDI_Callbacks.hpp>
 
+#include <future>
+#include <thread>
+
 using namespace CS;
 using testing::Mock;
 
@@ -216,6 +219,56 @@ TEST(BluetoothMIDIInterface, receiveSysExSplitAcrossPackets) {
     EXPECT_EQ(cb.channelMessages, expectedChannelMessages);
 }
 
+TEST(BluetoothMIDIInterface, receiveSysExStatistics) {
+    MockMIDI_Callbacks cb;
+
+    BluetoothMIDI_Interface midi;
+    midi.begin();
+    midi.setCallbacks(&cb);
+    EXPECT_EQ(midi.getSysExReceiveCapacity(), BLE_SYSEX_QUEUE_SIZE);
+    EXPECT_EQ(midi.getSysExReceiveUsage(), 0);
+
+    uint8_t data[] = {0x80, 0x80, 0xF0, 0x01, 0x02, 0x03, 0x04, 0x80, 0xF7};
+    midi.parse(data, sizeof(data));
+    EXPECT_EQ(midi.getSysExReceiveUsage(), 6);
+    EXPECT_EQ(midi.getSysExReceivePeakUsage(), 6);
+    EXPECT_EQ(midi.getSysExOverflowCount(), 0);
+    EXPECT_EQ(midi.getSysExDroppedCount(), 0);
+
+    // A SysEx message that is larger than the SysEx buffer: the parser has to
+    // wait for the main loop to read the first chunks
+    std::vector<uint8_t> large(BLE_SYSEX_QUEUE_SIZE + 4, 0x01);
+    large.insert(large.begin(), {0x80, 0x80, 0xF0});
+    large.insert(large.end(), {0x80, 0xF7});
+    std::promise<void> parsed;
+    auto done = parsed.get_future();
+    std::thread parser([&] {
+        midi.parse(large.data(), large.size());
+        parsed.set_value();
+    });
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (midi.getSysExOverflowCount() == 0 &&
+           std::chrono::steady_clock::now() < timeout)
+        std::this_thread::yield();
+    EXPECT_GT(midi.getSysExOverflowCount(), 0);
+    while (done.wait_for(std::chrono::milliseconds(1)) !=
+               std::future_status::ready &&
+           std::chrono::steady_clock::now() < timeout)
+        midi.update();
+    ASSERT_EQ(done.wait_for(std::chrono::seconds(0)),
+              std::future_status::ready);
+    parser.join();
+    midi.update();
+    // Reading until the queue is empty releases all SysEx data
+    EXPECT_EQ(midi.getSysExReceiveUsage(), 0);
+
+    EXPECT_EQ(cb.sysExMessages.size(), 6 + BLE_SYSEX_QUEUE_SIZE + 6);
+    EXPECT_LE(midi.getSysExReceivePeakUsage(), BLE_SYSEX_QUEUE_SIZE);
+    EXPECT_GT(midi.getSysExReceivePeakUsage(), 6);
+    // The parser splits the message into chunks that fit, nothing is dropped
+    EXPECT_EQ(midi.getSysExDroppedCount(), 0);
+}
+
 TEST(BluetoothMIDIInterface, receiveSysExAndRealTime) {
     MockMIDI_Callbacks cb;
 
@@ -242,6 +295,21 @@ static uint16_t timestamp(uint8_t msb, uint8_t lsb) {
     return (uint16_t(msb) << 7) | lsb;
 }
 
+TEST(BluetoothMIDIInterface, receiveRealTimePriority) {
+    BluetoothMIDI_Interface midi;
+
+    uint8_t data[] = {0x81, 0x82, 0x90, 0x3C, 0x7F, 0x83, 0xF8};
+    midi.parse(data, sizeof(data));
+
+    // The clock overtakes the Note On message that was received before it
+    EXPECT_EQ(midi.read(), MIDIReadEvent::REALTIME_MESSAGE);
+    EXPECT_EQ(midi.getRealTimeMessage(), RealTimeMessage(0xF8));
+    EXPECT_EQ(midi.getTimestamp(), (0x01 << 7) | 0x03);
+    EXPECT_EQ(midi.read(), MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(midi.getChannelMessage(), ChannelMessage(0x90, 0x3C, 0x7F));
+    EXPECT_EQ(midi.read(), MIDIReadEvent::NO_MESSAGE);
+}
+
 TEST(BluetoothMIDIInterface, receiveSysCommonRunningStatusChannelMessage) {
     BluetoothMIDI_Interface midi;
     midi.begin();
@@ -470,6 +538,32 @@ TEST(BluetoothMIDIInterface, sendRealTimeMessageBufferFull) {
     Mock::VerifyAndClear(&ArduinoMock::getInstance());
 }
 
+TEST(BluetoothMIDIInterface, sendRealTimeBeforeSysEx) {
+    BluetoothMIDI_Interface midi;
+    midi.forceMinMTU(5 + 3);
+
+    std::vector<uint8_t> sysex = {0xF0, 0x10, 0x11, 0x12, 0x13, 0xF7};
+    std::vector<uint8_t> expected1 = {0x81, 0x82, 0xF8, 0x82, 0xF0};
+    std::vector<uint8_t> expected2 = {0x81, 0x10, 0x11, 0x12, 0x13};
+    std::vector<uint8_t> expected3 = {0x81, 0x82, 0xF7};
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .Times(2) // For time stamp
+        .WillRepeatedly(Return(timestamp(0x01, 0x02)));
+    testing::Sequence s;
+    EXPECT_CALL(midi, notifyMIDIBLE(expected1)).InSequence(s);
+    EXPECT_CALL(midi, notifyMIDIBLE(expected2)).InSequence(s);
+    EXPECT_CALL(midi, notifyMIDIBLE(expected3)).InSequence(s);
+
+    // Queue both messages before the sender thread starts: the clock
+    // overtakes the SysEx message that was queued first
+    midi.send(SysExMessage(sysex));
+    midi.sendRealTime(0xF8);
+    midi.begin();
+    EXPECT_TRUE(midi.flushAndWait());
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
 TEST(BluetoothMIDIInterface, sendSysCommon) {
     BluetoothMIDI_Interface midi;
     midi.begin();
@@ -511,9 +605,9 @@ TEST(BluetoothMIDIInterface, sendSysCommonMessageBufferFull) {
 TEST(BluetoothMIDIInterface, sendLongSysEx) {
     std::chrono::milliseconds timeout{100};
     BluetoothMIDI_Interface midi;
+    midi.setTimeout(timeout);
     midi.begin();
     midi.forceMinMTU(5 + 3);
-    midi.setTimeout(timeout);
 
     std::vector<uint8_t> sysex = {
         0xF0, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0xF7,
@@ -546,18 +640,23 @@ TEST(BluetoothMIDIInterface, sendLongSysEx) {
         .Times(1) // For time stamp
         .WillRepeatedly(Return(timestamp(0x01, 0x02)));
 
+    std::promise<void> full, last;
     InSequence seq;
     EXPECT_CALL(midi, notifyMIDIBLE(expected[0]));
-    EXPECT_CALL(midi, notifyMIDIBLE(expected[1]));
+    EXPECT_CALL(midi, notifyMIDIBLE(expected[1]))
+        .WillOnce(InvokeWithoutArgs([&full] { full.set_value(); }));
+    EXPECT_CALL(midi, notifyMIDIBLE(expected[2]))
+        .WillOnce(InvokeWithoutArgs([&last] { last.set_value(); }));
 
+    auto start = std::chrono::steady_clock::now();
     midi.send(SysExMessage(sysex));
-    // First two packets should be sent immediately
-    Mock::VerifyAndClear(&midi);
+    // First two packets should be sent as soon as they are full
+    EXPECT_EQ(full.get_future().wait_for(timeout), std::future_status::ready);
 
     // Third packet is sent after the timeout
-    std::this_thread::sleep_for(timeout * 0.9);
-    EXPECT_CALL(midi, notifyMIDIBLE(expected[2]));
-    std::this_thread::sleep_for(timeout * 0.2);
+    EXPECT_EQ(last.get_future().wait_for(timeout * 10),
+              std::future_status::ready);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, timeout);
     Mock::VerifyAndClear(&midi);
 
     Mock::VerifyAndClear(&ArduinoMock::getInstance());
@@ -606,11 +705,12 @@ TEST(BluetoothMIDIInterface, sendSysExBufferFullPacket1) {
 }
 
 TEST(BluetoothMIDIInterface, sendLongSysExFlush) {
-    std::chrono::milliseconds timeout{100};
+    // Long enough that the last packet can only be sent because of the flush
+    std::chrono::milliseconds timeout{10000};
     BluetoothMIDI_Interface midi;
+    midi.setTimeout(timeout);
     midi.begin();
     midi.forceMinMTU(5 + 3);
-    midi.setTimeout(timeout);
 
     std::vector<uint8_t> sysex = {
         0xF0, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0xF7,
@@ -643,17 +743,20 @@ TEST(BluetoothMIDIInterface, sendLongSysExFlush) {
         .Times(1) // For time stamp
         .WillRepeatedly(Return(timestamp(0x01, 0x02)));
 
+    std::promise<void> full;
     InSequence seq;
     EXPECT_CALL(midi, notifyMIDIBLE(expected[0]));
-    EXPECT_CALL(midi, notifyMIDIBLE(expected[1]));
+    EXPECT_CALL(midi, notifyMIDIBLE(expected[1]))
+        .WillOnce(InvokeWithoutArgs([&full] { full.set_value(); }));
+    EXPECT_CALL(midi, notifyMIDIBLE(expected[2]));
 
     midi.send(SysExMessage(sysex));
-    // First two packets should be sent immediately
-    Mock::VerifyAndClear(&midi);
+    // First two packets should be sent as soon as they are full
+    EXPECT_EQ(full.get_future().wait_for(std::chrono::milliseconds{1000}),
+              std::future_status::ready);
 
     // Third packet is sent after flush
-    EXPECT_CALL(midi, notifyMIDIBLE(expected[2]));
-    midi.flush();
+    EXPECT_TRUE(midi.flushAndWait(std::chrono::milliseconds{1000}));
     Mock::VerifyAndClear(&midi);
 
     Mock::VerifyAndClear(&ArduinoMock::getInstance());
@@ -710,3 +813,132 @@ TEST(BluetoothMIDIInterface, sendLongSysExFlushStopSendingThread) {
 
     Mock::VerifyAndClear(&ArduinoMock::getInstance());
 }
+
+TEST(BluetoothMIDIInterface, sendDoesNotBlockWhenCongested) {
+    BluetoothMIDI_Interface midi;
+    midi.begin();
+    midi.forceMinMTU(5 + 3);
+
+    // The BLE stack is stuck until `release` is set
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillRepeatedly(Return(timestamp(0x01, 0x02)));
+    EXPECT_CALL(midi, notifyMIDIBLE(_))
+        .WillRepeatedly(InvokeWithoutArgs([released] { released.wait(); }));
+
+    // Sending never waits for the sender thread, messages that don't fit are
+    // dropped and counted
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i)
+        midi.sendNoteOn({0x12, CHANNEL_3}, 0x34);
+    auto duration = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(duration, std::chrono::milliseconds{100});
+    size_t dropped = midi.getDroppedMessages();
+    EXPECT_GT(dropped, 0u);
+    EXPECT_LT(midi.getSendBufferSpace(), 7u);
+
+    // Once the BLE stack catches up, all buffered messages are sent
+    release.set_value();
+    EXPECT_TRUE(midi.flushAndWait(std::chrono::milliseconds{1000}));
+    EXPECT_EQ(midi.getSendBufferSpace(), 512u);
+    midi.sendNoteOn({0x12, CHANNEL_3}, 0x34);
+    EXPECT_EQ(midi.getDroppedMessages(), dropped);
+    EXPECT_TRUE(midi.flushAndWait());
+    Mock::VerifyAndClear(&midi);
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(BluetoothMIDIInterface, sendSysExLongerThanBuffer) {
+    BluetoothMIDI_Interface midi;
+    EXPECT_EQ(midi.getMaxSysExLength(), 504u);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillRepeatedly(Return(timestamp(0x01, 0x02)));
+    std::vector<uint8_t> sysex(4 * midi.getMaxSysExLength(), 0x10);
+    sysex.front() = 0xF0;
+    sysex.back() = 0xF7;
+
+    // Without sender thread, nobody would make room, so it's dropped
+    midi.send(SysExMessage(sysex));
+    EXPECT_EQ(midi.getDroppedMessages(), 1u);
+    EXPECT_EQ(midi.getSendBufferSpace(), BLE_SEND_BUFFER_SIZE);
+
+    // Messages that can never fit in the send buffer at once are sent in
+    // pieces, waiting for the sender thread to make room
+    std::vector<uint8_t> sent;
+    EXPECT_CALL(midi, notifyMIDIBLE(_))
+        .WillRepeatedly([&](const std::vector<uint8_t> &packet) {
+            for (uint8_t b : packet)
+                if (b < 0x80 || b == 0xF0 || b == 0xF7)
+                    sent.push_back(b);
+        });
+    midi.begin();
+    midi.send(SysExMessage(sysex));
+    EXPECT_EQ(midi.getDroppedMessages(), 1u);
+    EXPECT_TRUE(midi.flushAndWait(std::chrono::milliseconds{1000}));
+    EXPECT_EQ(sent, sysex);
+    Mock::VerifyAndClear(&midi);
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(BluetoothMIDIInterface, flushAndWaitWithoutThread) {
+    BluetoothMIDI_Interface midi;
+    EXPECT_FALSE(midi.flushAndWait());
+}
+
+TEST(BluetoothMIDIInterface, minMTUPerConnection) {
+    BluetoothMIDI_Interface midi;
+    EXPECT_EQ(midi.getMinMTU(), 23);
+    BluetoothMIDI_Interface::midi_connection_callback(1, true);
+    BluetoothMIDI_Interface::midi_mtu_callback(1, 185);
+    EXPECT_EQ(midi.getMinMTU(), 185);
+    BluetoothMIDI_Interface::midi_connection_callback(2, true);
+    EXPECT_EQ(midi.getMinMTU(), 23);
+    BluetoothMIDI_Interface::midi_mtu_callback(2, 100);
+    EXPECT_EQ(midi.getMinMTU(), 100);
+    midi.forceMinMTU(50);
+    EXPECT_EQ(midi.getMinMTU(), 50);
+    midi.forceMinMTU(0);
+    BluetoothMIDI_Interface::midi_connection_callback(2, false);
+    EXPECT_EQ(midi.getMinMTU(), 185);
+}
+
+TEST(BluetoothMIDIInterface, sendBeforeConnectionEvent) {
+    BluetoothMIDI_Interface midi;
+    // Without the connection interval, this packet would only be sent after
+    // two seconds
+    midi.setTimeout(std::chrono::milliseconds{2000});
+    BluetoothMIDI_Interface::midi_connection_callback(0, true);
+    BluetoothMIDI_Interface::midi_mtu_callback(0, 7 + 3);
+    BluetoothMIDI_Interface::midi_conn_interval_callback(0, 8); // 10 ms
+    EXPECT_EQ(midi.getConnectionInterval(), std::chrono::milliseconds{10});
+    midi.begin();
+
+    std::promise<void> sent;
+    std::vector<uint8_t> expected = {0x81, 0x82, 0x92, 0x12, 0x34, 0x56, 0x78};
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillRepeatedly(Return(timestamp(0x01, 0x02)));
+    EXPECT_CALL(midi, notifyMIDIBLE(expected))
+        .WillOnce(InvokeWithoutArgs([&sent] { sent.set_value(); }));
+
+    midi.sendNoteOn({0x12, CHANNEL_3}, 0x34);
+    midi.sendNoteOn({0x56, CHANNEL_3}, 0x78);
+    auto status = sent.get_future().wait_for(std::chrono::milliseconds{500});
+    EXPECT_EQ(status, std::future_status::ready);
+
+    // The statistics are updated after the notification
+    EXPECT_TRUE(midi.flushAndWait());
+    auto stats = midi.getNotificationStatistics();
+    EXPECT_EQ(stats.notifications, 1u);
+    EXPECT_EQ(stats.bytes, 7u);
+    EXPECT_EQ(stats.getBytesPerNotification(), 7);
+    EXPECT_LT(stats.maxDelay, std::chrono::milliseconds{500});
+    midi.resetNotificationStatistics();
+    EXPECT_EQ(midi.getNotificationStatistics().notifications, 0u);
+
+    midi.stopSendingThread();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
@@ -0,0 +1,94 @@
+#include <MIDI_Interfaces/SerialMIDI_Interface.hpp>
+#include <TestStream.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+USING_CS_NAMESPACE;
+using ::testing::Return;
+
+using u8vec = std::vector<uint8_t>;
+
+TEST(ControlChangeCoalescer, holdBackAndPoll) {
+    ControlChangeCoalescer<4> coalescer {10};
+    ChannelMessage msg = {0x00, 0x00, 0x00};
+    ChannelMessage cc1 = {0xB3, 0x10, 0x01, CABLE_2};
+    ChannelMessage cc2 = {0xB3, 0x10, 0x02, CABLE_2};
+    ChannelMessage cc3 = {0xB3, 0x10, 0x03, CABLE_2};
+    EXPECT_TRUE(coalescer.update(cc1, 100));
+    EXPECT_FALSE(coalescer.update(cc2, 101));
+    EXPECT_FALSE(coalescer.update(cc3, 105));
+    EXPECT_EQ(coalescer.getCoalescedCount(), 1u);
+    EXPECT_FALSE(coalescer.poll(109, msg));
+    EXPECT_TRUE(coalescer.poll(110, msg));
+    EXPECT_EQ(msg, cc3);
+    EXPECT_FALSE(coalescer.poll(110, msg));
+    // Next message is held back again, because the last one was sent at 110
+    EXPECT_FALSE(coalescer.update(cc1, 115));
+    EXPECT_TRUE(coalescer.update(cc2, 120));
+    EXPECT_FALSE(coalescer.poll(200, msg));
+}
+
+TEST(ControlChangeCoalescer, addressesAreIndependent) {
+    ControlChangeCoalescer<4> coalescer {10};
+    ChannelMessage msg = {0x00, 0x00, 0x00};
+    EXPECT_TRUE(coalescer.update({0xB0, 0x10, 0x01}, 100));
+    EXPECT_TRUE(coalescer.update({0xB0, 0x11, 0x01}, 101));
+    EXPECT_TRUE(coalescer.update({0xB1, 0x10, 0x01}, 102));
+    EXPECT_TRUE(coalescer.update({0xB0, 0x10, 0x01, CABLE_2}, 103));
+    EXPECT_FALSE(coalescer.update({0xB0, 0x11, 0x02}, 104));
+    // Other message types are not affected
+    EXPECT_TRUE(coalescer.update({0x90, 0x11, 0x02}, 104));
+    EXPECT_TRUE(coalescer.update({0x90, 0x11, 0x03}, 104));
+    EXPECT_TRUE(coalescer.flush(msg));
+    EXPECT_EQ(msg, (ChannelMessage {0xB0, 0x11, 0x02}));
+    EXPECT_FALSE(coalescer.flush(msg));
+}
+
+TEST(ControlChangeCoalescer, full) {
+    ControlChangeCoalescer<2> coalescer {10};
+    ChannelMessage msg = {0x00, 0x00, 0x00};
+    EXPECT_TRUE(coalescer.update({0xB0, 0x10, 0x01}, 100));
+    EXPECT_TRUE(coalescer.update({0xB0, 0x11, 0x01}, 100));
+    EXPECT_FALSE(coalescer.update({0xB0, 0x11, 0x02}, 101));
+    // No room for a third address
+    EXPECT_TRUE(coalescer.update({0xB0, 0x12, 0x01}, 102));
+    EXPECT_TRUE(coalescer.update({0xB0, 0x12, 0x02}, 103));
+    EXPECT_EQ(coalescer.getUntrackedCount(), 2u);
+    // The first address has expired, so it can be reused, the second one
+    // can't, because it has a value pending
+    EXPECT_TRUE(coalescer.update({0xB0, 0x12, 0x03}, 110));
+    EXPECT_FALSE(coalescer.update({0xB0, 0x12, 0x04}, 111));
+    EXPECT_TRUE(coalescer.poll(111, msg));
+    EXPECT_EQ(msg, (ChannelMessage {0xB0, 0x11, 0x02}));
+    EXPECT_FALSE(coalescer.poll(111, msg));
+    EXPECT_TRUE(coalescer.poll(120, msg));
+    EXPECT_EQ(msg, (ChannelMessage {0xB0, 0x12, 0x04}));
+}
+
+TEST(ControlChangeCoalescer, interface) {
+    TestStream stream;
+    StreamMIDI_Interface midi = stream;
+    ControlChangeCoalescer<4> coalescer {10};
+    midi.setControlChangeCoalescer(coalescer);
+    TrueMIDI_Source source;
+    MIDI_Pipe pipe;
+    source >> pipe >> midi;
+
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillRepeatedly(Return(1000));
+    for (uint8_t v = 0; v < 5; ++v)
+        source.sourceMIDItoPipe(ChannelMessage {0xB0, 0x10, v});
+    source.sourceMIDItoPipe(ChannelMessage {0x90, 0x10, 0x7F});
+    MIDI_Interface::flushAllAtLoopEnd();
+    u8vec expected = {0xB0, 0x10, 0x00, 0x90, 0x10, 0x7F};
+    EXPECT_EQ(stream.sent, expected);
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // After the interval, the final value is sent
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillRepeatedly(Return(1010));
+    MIDI_Interface::flushAllAtLoopEnd();
+    expected.insert(expected.end(), {0xB0, 0x10, 0x04});
+    EXPECT_EQ(stream.sent, expected);
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
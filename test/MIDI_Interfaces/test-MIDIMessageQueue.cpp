@@ -0,0 +1,104 @@
+#include <MIDI_Interfaces/BLEMIDI/MIDIMessageQueue.hpp>
+#include <gtest/gtest.h>
+
+using namespace CS;
+
+using Element = MIDIMessageQueue::MIDIMessageQueueElement;
+
+static std::vector<uint8_t> getData(const Element &el) {
+    auto msg = el.message.sysexmessage;
+    return {msg.data, msg.data + msg.length};
+}
+
+TEST(MIDIMessageQueue, pushPopSysEx) {
+    MIDIMessageQueue queue(4, 16);
+    std::vector<uint8_t> sysex1 = {0xF0, 0x01, 0x02, 0xF7};
+    std::vector<uint8_t> sysex2 = {0xF0, 0x03, 0x04, 0x05, 0x06, 0xF7};
+    EXPECT_TRUE(queue.push(SysExMessage(sysex1), 1));
+    EXPECT_TRUE(queue.push(ChannelMessage(0x90, 0x3C, 0x7F), 2));
+    EXPECT_TRUE(queue.push(SysExMessage(sysex2), 3));
+    EXPECT_EQ(queue.getSysExUsage(), 10u);
+
+    Element el;
+    EXPECT_TRUE(queue.pop(el));
+    EXPECT_EQ(el.eventType, MIDIReadEvent::SYSEX_MESSAGE);
+    EXPECT_EQ(getData(el), sysex1);
+    EXPECT_EQ(el.timestamp, 1);
+    EXPECT_TRUE(queue.pop(el));
+    EXPECT_EQ(el.eventType, MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(el.message.channelmessage, ChannelMessage(0x90, 0x3C, 0x7F));
+    // The data of the first message was released
+    EXPECT_EQ(queue.getSysExUsage(), 6u);
+    EXPECT_TRUE(queue.pop(el));
+    EXPECT_EQ(getData(el), sysex2);
+    // The data of the last popped message remains valid until the next pop
+    EXPECT_EQ(queue.getSysExUsage(), 6u);
+    EXPECT_FALSE(queue.pop(el));
+    EXPECT_EQ(queue.getSysExUsage(), 0u);
+    EXPECT_EQ(queue.getSysExPeakUsage(), 10u);
+}
+
+TEST(MIDIMessageQueue, sysExWrapAround) {
+    MIDIMessageQueue queue(4, 16);
+    std::vector<uint8_t> sysex(6);
+    Element el;
+    for (uint8_t i = 0; i < 20; ++i) {
+        for (auto &s : sysex)
+            s = i;
+        EXPECT_TRUE(queue.push(SysExMessage(sysex), i));
+        EXPECT_TRUE(queue.pop(el));
+        EXPECT_EQ(getData(el), sysex);
+    }
+    EXPECT_EQ(queue.getSysExOverflowCount(), 0u);
+    // Skipped bytes at the end of the storage count towards the usage
+    EXPECT_EQ(queue.getSysExPeakUsage(), 6u + 4u + 6u);
+}
+
+TEST(MIDIMessageQueue, sysExOverflow) {
+    MIDIMessageQueue queue(4, 16);
+    std::vector<uint8_t> sysex(10, 0x11);
+    std::vector<uint8_t> large(17, 0x22);
+    EXPECT_TRUE(queue.push(SysExMessage(sysex), 1));
+    // Doesn't fit now, should be retried later
+    EXPECT_FALSE(queue.push(SysExMessage(sysex), 2));
+    EXPECT_EQ(queue.getSysExOverflowCount(), 1u);
+    // Never fits, dropped
+    EXPECT_TRUE(queue.push(SysExMessage(large), 3));
+    EXPECT_EQ(queue.getSysExDroppedCount(), 1u);
+
+    Element el;
+    EXPECT_TRUE(queue.pop(el));
+    // Popped message is still in use
+    EXPECT_FALSE(queue.push(SysExMessage(sysex), 2));
+    // Popping from the empty queue releases it, and the storage is rewound,
+    // so the second message doesn't have to wrap around
+    EXPECT_FALSE(queue.pop(el));
+    EXPECT_EQ(queue.getSysExUsage(), 0u);
+    EXPECT_TRUE(queue.push(SysExMessage(sysex), 2));
+    EXPECT_EQ(queue.getSysExUsage(), 10u);
+    EXPECT_TRUE(queue.pop(el));
+    EXPECT_EQ(getData(el), sysex);
+    EXPECT_EQ(el.sysexReserved, 10u);
+}
+
+TEST(MIDIMessageQueue, sysExWrapAroundWhileInUse) {
+    MIDIMessageQueue queue(4, 16);
+    std::vector<uint8_t> sysex1(6, 0x11);
+    std::vector<uint8_t> sysex2(6, 0x22);
+    std::vector<uint8_t> sysex3(6, 0x33);
+    Element el;
+    EXPECT_TRUE(queue.push(SysExMessage(sysex1), 1));
+    EXPECT_TRUE(queue.push(SysExMessage(sysex2), 2));
+    EXPECT_TRUE(queue.pop(el));
+    // The first message is still in use, the third one would wrap around
+    // and overlap with it
+    EXPECT_FALSE(queue.push(SysExMessage(sysex3), 3));
+    EXPECT_TRUE(queue.pop(el));
+    EXPECT_EQ(getData(el), sysex2);
+    // The first message is released, so the third one fits at the beginning
+    EXPECT_TRUE(queue.push(SysExMessage(sysex3), 3));
+    EXPECT_EQ(queue.getSysExUsage(), 6u + 4u + 6u);
+    EXPECT_TRUE(queue.pop(el));
+    EXPECT_EQ(getData(el), sysex3);
+    EXPECT_EQ(el.sysexReserved, 4u + 6u);
+}
@@ -0,0 +1,146 @@
+#include <MIDI_Interfaces/MIDI_RulePipe.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+USING_CS_NAMESPACE;
+using ::testing::InSequence;
+using ::testing::Mock;
+using ::testing::StrictMock;
+
+struct MockRuleSink : TrueMIDI_Sink {
+    MOCK_METHOD(void, sinkMIDIfromPipe, (ChannelMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (SysExMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (SysCommonMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (RealTimeMessage), (override));
+};
+
+constexpr auto NOTE_ON = MIDIMessageType::NOTE_ON;
+constexpr auto NOTE_OFF = MIDIMessageType::NOTE_OFF;
+constexpr auto CC = MIDIMessageType::CONTROL_CHANGE;
+constexpr auto CP = MIDIMessageType::CHANNEL_PRESSURE;
+
+TEST(MIDI_RulePipe, noRulesForwardsEverything) {
+    StrictMock<MockRuleSink> sink;
+    MIDI_RulePipe<> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    ChannelMessage msg = {NOTE_ON, CHANNEL_5, 0x3C, 0x40};
+    EXPECT_CALL(sink, sinkMIDIfromPipe(msg));
+    source.sourceMIDItoPipe(msg);
+    RealTimeMessage rt = {0xF8, CABLE_1};
+    EXPECT_CALL(sink, sinkMIDIfromPipe(rt));
+    source.sourceMIDItoPipe(rt);
+}
+
+TEST(MIDI_RulePipe, decisionTable) {
+    MIDI_RulePipe<9> pipe;
+    static_assert(std::is_same<decltype(pipe)::Mask, uint16_t>::value, "");
+    pipe.addRule(MIDI_Rule().matchTypes({NOTE_ON, NOTE_OFF}).drop());
+    pipe.addRule(MIDI_Rule().matchTypes({CC}).matchChannels({CHANNEL_2}));
+    pipe.addRule(MIDI_Rule().matchChannels({CHANNEL_2, CHANNEL_16}));
+    EXPECT_EQ(pipe.getCandidates(0x90), 0b001);
+    EXPECT_EQ(pipe.getCandidates(0x81), 0b101);
+    EXPECT_EQ(pipe.getCandidates(0xB1), 0b110);
+    EXPECT_EQ(pipe.getCandidates(0xB0), 0b000);
+    EXPECT_EQ(pipe.getCandidates(0xEF), 0b100);
+    pipe.clearRules();
+    EXPECT_EQ(pipe.getNumberOfRules(), 0);
+    EXPECT_EQ(pipe.getCandidates(0x90), 0);
+}
+
+TEST(MIDI_RulePipe, dropAndRemap) {
+    StrictMock<MockRuleSink> sink;
+    MIDI_RulePipe<2> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    // Keyboard split: notes below middle C on channel 1 go to channel 2
+    pipe.addRule(MIDI_Rule()
+                     .matchTypes({NOTE_ON, NOTE_OFF})
+                     .matchChannels({CHANNEL_1})
+                     .matchData1(0, 59)
+                     .setChannel(CHANNEL_2));
+    // Drop channel pressure on cable 2
+    pipe.addRule(MIDI_Rule().matchTypes({CP}).matchCables({CABLE_2}).drop());
+
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{NOTE_ON, CHANNEL_2, 59,
+                                                      0x7F}));
+    source.sourceMIDItoPipe(ChannelMessage{NOTE_ON, CHANNEL_1, 59, 0x7F});
+    Mock::VerifyAndClear(&sink);
+
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{NOTE_OFF, CHANNEL_1, 60,
+                                                      0x7F}));
+    source.sourceMIDItoPipe(ChannelMessage{NOTE_OFF, CHANNEL_1, 60, 0x7F});
+    Mock::VerifyAndClear(&sink);
+
+    source.sourceMIDItoPipe(ChannelMessage{CP, CHANNEL_1, 0x10, 0, CABLE_2});
+    Mock::VerifyAndClear(&sink);
+
+    ChannelMessage cp = {CP, CHANNEL_1, 0x10, 0, CABLE_1};
+    EXPECT_CALL(sink, sinkMIDIfromPipe(cp));
+    source.sourceMIDItoPipe(cp);
+    Mock::VerifyAndClear(&sink);
+}
+
+TEST(MIDI_RulePipe, copyTransposeRescale) {
+    StrictMock<MockRuleSink> sink;
+    MIDI_RulePipe<3> pipe;
+    TrueMIDI_Source source;
+    source >> pipe >> sink;
+
+    // Layer channel 1 an octave higher on channel 3
+    pipe.addRule(MIDI_Rule()
+                     .matchTypes({NOTE_ON, NOTE_OFF})
+                     .matchChannels({CHANNEL_1})
+                     .setChannel(CHANNEL_3)
+                     .transpose(12)
+                     .copy());
+    // Compress the velocities of channel 1 to [64, 127]
+    pipe.addRule(MIDI_Rule()
+                     .matchTypes({NOTE_ON})
+                     .matchChannels({CHANNEL_1})
+                     .matchData2(1, 127)
+                     .rescale(64, 127));
+    // Invert channel pressure
+    pipe.addRule(MIDI_Rule().matchTypes({CP}).rescale(127, 0));
+
+    {
+        InSequence seq;
+        EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{NOTE_ON, CHANNEL_3,
+                                                          72, 1}));
+        EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{NOTE_ON, CHANNEL_1,
+                                                          60, 64}));
+    }
+    source.sourceMIDItoPipe(ChannelMessage{NOTE_ON, CHANNEL_1, 60, 1});
+    Mock::VerifyAndClear(&sink);
+
+    // Transposed notes that are out of range are dropped, the original is not
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{NOTE_ON, CHANNEL_1, 120,
+                                                      127}));
+    source.sourceMIDItoPipe(ChannelMessage{NOTE_ON, CHANNEL_1, 120, 127});
+    Mock::VerifyAndClear(&sink);
+
+    EXPECT_CALL(sink, sinkMIDIfromPipe(ChannelMessage{CP, CHANNEL_7, 100}));
+    source.sourceMIDItoPipe(ChannelMessage{CP, CHANNEL_7, 27});
+    Mock::VerifyAndClear(&sink);
+}
+
+TEST(MIDI_RulePipe, tooManyRules) {
+    MIDI_RulePipe<1> pipe;
+    EXPECT_TRUE(pipe.addRule(MIDI_Rule().drop()));
+    try {
+        pipe.addRule(MIDI_Rule().drop());
+        FAIL();
+    } catch (AH::ErrorException &e) {
+        EXPECT_EQ(e.getErrorCode(), 0x7211);
+    }
+}
+
+TEST(MIDI_Rule, matches) {
+    MIDI_Rule rule = MIDI_Rule().matchTypes({CC}).matchData1(7, 7);
+    EXPECT_TRUE(rule.matches({CC, CHANNEL_9, 7, 0}));
+    EXPECT_FALSE(rule.matches({CC, CHANNEL_9, 8, 0}));
+    EXPECT_FALSE(rule.matches({NOTE_ON, CHANNEL_9, 7, 0}));
+}
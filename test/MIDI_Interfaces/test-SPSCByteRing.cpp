@@ -0,0 +1,81 @@
+#include <MIDI_Interfaces/Util/SPSCByteRing.hpp>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace CS;
+
+TEST(SPSCByteRing, writeRead) {
+    SPSCByteRing ring(8);
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.writeAvailable(), 8u);
+    const uint8_t head[] = {1, 2, 3};
+    const uint8_t body[] = {4, 5};
+    EXPECT_TRUE(ring.write(head, 3, body, 2));
+    EXPECT_EQ(ring.readAvailable(), 5u);
+    EXPECT_EQ(ring.writeAvailable(), 3u);
+    // All or nothing
+    EXPECT_FALSE(ring.write(head, 3, body, 1));
+    EXPECT_EQ(ring.readAvailable(), 5u);
+
+    uint8_t result[5] = {};
+    EXPECT_TRUE(ring.peek(result, 2));
+    EXPECT_EQ(result[0], 1);
+    EXPECT_EQ(result[1], 2);
+    EXPECT_EQ(ring.readAvailable(), 5u);
+    EXPECT_FALSE(ring.read(result, 6));
+    EXPECT_TRUE(ring.read(result, 5));
+    const uint8_t expected[] = {1, 2, 3, 4, 5};
+    EXPECT_EQ(std::vector<uint8_t>(result, result + 5),
+              std::vector<uint8_t>(expected, expected + 5));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SPSCByteRing, wrapAround) {
+    SPSCByteRing ring(8);
+    uint8_t data[] = {1, 2, 3, 4, 5, 6};
+    uint8_t result[6] = {};
+    for (int i = 0; i < 10; ++i) {
+        for (auto &d : data)
+            d += 6;
+        EXPECT_TRUE(ring.write(data, 6));
+        EXPECT_EQ(ring.readAvailable(), 6u);
+        EXPECT_TRUE(ring.read(result, 6));
+        EXPECT_EQ(std::vector<uint8_t>(result, result + 6),
+                  std::vector<uint8_t>(data, data + 6));
+    }
+}
+
+TEST(SPSCByteRing, producerConsumerThreads) {
+    SPSCByteRing ring(61);
+    constexpr uint32_t count = 100000;
+
+    // Producer writes records of a length byte followed by a counter
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < count; ++i) {
+            uint8_t length = 1 + i % 7;
+            uint8_t body[8];
+            for (uint8_t j = 0; j < length; ++j)
+                body[j] = uint8_t(i + j);
+            while (!ring.write(&length, 1, body, length))
+                std::this_thread::yield();
+        }
+    });
+
+    // Consumer checks that all records arrive in order and intact
+    uint32_t errors = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint8_t length;
+        while (!ring.peek(&length, 1))
+            std::this_thread::yield();
+        ring.skip(1);
+        uint8_t body[8];
+        EXPECT_TRUE(ring.read(body, length));
+        errors += length != 1 + i % 7;
+        for (uint8_t j = 0; j < length; ++j)
+            errors += body[j] != uint8_t(i + j);
+    }
+    producer.join();
+    EXPECT_EQ(errors, 0u);
+    EXPECT_TRUE(ring.empty());
+}
@@ -0,0 +1,119 @@
+#include <MIDI_Interfaces/DebugMIDI_Interface.hpp>
+#include <MIDI_Interfaces/SerialMIDI_Interface.hpp>
+#include <MIDI_Interfaces/StaticMIDI_Router.hpp>
+
+#include <TestStream.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+USING_CS_NAMESPACE;
+using ::testing::Mock;
+using ::testing::StrictMock;
+
+struct MockRouterSink : TrueMIDI_Sink {
+    MOCK_METHOD(void, sinkMIDIfromPipe, (ChannelMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (SysExMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (SysCommonMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (RealTimeMessage), (override));
+};
+
+struct MockRouterSinkSource : TrueMIDI_SinkSource {
+    MOCK_METHOD(void, sinkMIDIfromPipe, (ChannelMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (SysExMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (SysCommonMessage), (override));
+    MOCK_METHOD(void, sinkMIDIfromPipe, (RealTimeMessage), (override));
+};
+
+using TestRouter = StaticMIDI_Router<StrictMock<MockRouterSink>,
+                                     StrictMock<MockRouterSinkSource>>;
+
+TEST(StaticMIDI_Router, routingMatrix) {
+    StrictMock<MockRouterSink> sink0;
+    StrictMock<MockRouterSinkSource> sink1;
+    TestRouter router = {sink0, sink1};
+    static_assert(TestRouter::getNumberOfSinks() == 2, "");
+    TestRouter::Input<0b11> inputA{router};
+    TestRouter::Input<0b01> inputB{router};
+    TestRouter::Input<0b10> inputC{router};
+    TrueMIDI_Source sourceA, sourceB, sourceC;
+    sourceA >> inputA;
+    sourceB >> inputB;
+    sourceC >> inputC;
+
+    ChannelMessage msg{0x93, 0x10, 0x7F, CABLE_6};
+    EXPECT_CALL(sink0, sinkMIDIfromPipe(msg));
+    EXPECT_CALL(sink1, sinkMIDIfromPipe(msg));
+    sourceA.sourceMIDItoPipe(msg);
+    Mock::VerifyAndClear(&sink0);
+    Mock::VerifyAndClear(&sink1);
+
+    RealTimeMessage rt = {0xF8, CABLE_2};
+    EXPECT_CALL(sink0, sinkMIDIfromPipe(rt));
+    sourceB.sourceMIDItoPipe(rt);
+    Mock::VerifyAndClear(&sink0);
+    Mock::VerifyAndClear(&sink1);
+
+    SysExMessage sysex = {nullptr, 0, CABLE_11};
+    EXPECT_CALL(sink1, sinkMIDIfromPipe(sysex));
+    sourceC.sourceMIDItoPipe(sysex);
+    Mock::VerifyAndClear(&sink0);
+    Mock::VerifyAndClear(&sink1);
+
+    SysCommonMessage common = {MIDIMessageType::TUNE_REQUEST, CABLE_3};
+    EXPECT_CALL(sink0, sinkMIDIfromPipe(common));
+    EXPECT_CALL(sink1, sinkMIDIfromPipe(common));
+    router.route<0b11>(common);
+    Mock::VerifyAndClear(&sink0);
+    Mock::VerifyAndClear(&sink1);
+}
+
+TEST(StaticMIDI_Router, coexistsWithDynamicPipes) {
+    StrictMock<MockRouterSink> sink0;
+    StrictMock<MockRouterSinkSource> sink1;
+    StrictMock<MockRouterSink> dynamicSink, inputSink;
+    TestRouter router = {sink0, sink1};
+    TestRouter::Input<0b01> input{router};
+    MIDI_Pipe pipe;
+    TrueMIDI_Source source;
+
+    // The input can have its own sink, and other pipes can be connected to the
+    // same source
+    source >> input >> inputSink;
+    source >> pipe >> dynamicSink;
+
+    ChannelMessage msg{0xB0, 0x07, 0x40, CABLE_1};
+    EXPECT_CALL(sink0, sinkMIDIfromPipe(msg));
+    EXPECT_CALL(inputSink, sinkMIDIfromPipe(msg));
+    EXPECT_CALL(dynamicSink, sinkMIDIfromPipe(msg));
+    source.sourceMIDItoPipe(msg);
+    Mock::VerifyAndClear(&sink0);
+    Mock::VerifyAndClear(&inputSink);
+    Mock::VerifyAndClear(&dynamicSink);
+
+    // Disconnecting the dynamic pipe leaves the static route intact
+    pipe.disconnect();
+    EXPECT_CALL(sink0, sinkMIDIfromPipe(msg));
+    EXPECT_CALL(inputSink, sinkMIDIfromPipe(msg));
+    source.sourceMIDItoPipe(msg);
+    Mock::VerifyAndClear(&sink0);
+    Mock::VerifyAndClear(&inputSink);
+}
+
+TEST(StaticMIDI_Router, interfacesAsSinks) {
+    // The interfaces don't make their sink functions public
+    TestStream stream, debugStream;
+    StreamMIDI_Interface midi = stream;
+    StreamDebugMIDI_Output debug = debugStream;
+    StaticMIDI_Router<StreamMIDI_Interface, StreamDebugMIDI_Output> router = {
+        midi,
+        debug,
+    };
+    decltype(router)::Input<0b11> input{router};
+    TrueMIDI_Source source;
+    source >> input;
+
+    source.sourceMIDItoPipe(ChannelMessage{0x93, 0x55, 0x66});
+    std::vector<uint8_t> expected = {0x93, 0x55, 0x66};
+    EXPECT_EQ(stream.sent, expected);
+    EXPECT_FALSE(debugStream.sent.empty());
+}
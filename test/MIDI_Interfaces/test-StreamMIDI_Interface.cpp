@@ -184,4 +184,49 @@ TEST(StreamMIDI_Interface, readRealTimeUpdate) {
     RealTimeMessage expected = {0xF8};
     EXPECT_CALL(callbacks, onRealTimeMessage(&midi, expected));
     midi.update();
-}
\ No newline at end of file
+}
+
+TEST(StreamMIDI_Interface, cooperativeStall) {
+    TestStream streamA, streamB, streamOut;
+    StreamMIDI_Interface midiA = streamA, midiB = streamB, midiOut = streamOut;
+    MIDI_PipeFactory<2> pipes;
+    midiA >> pipes >> midiOut;
+    midiB >> pipes >> midiOut;
+    midiB.setStallMode(MIDI_Interface::StallMode::Cooperative);
+
+    // The first chunk of a long SysEx message stalls the pipes
+    u8vec sysex(SYSEX_BUFFER_SIZE + 10, 0x11);
+    sysex.front() = 0xF0;
+    sysex.back() = 0xF7;
+    for (size_t i = 0; i < SYSEX_BUFFER_SIZE + 1; ++i)
+        streamA.toRead.push(sysex[i]);
+    midiA.update();
+    EXPECT_TRUE(midiB.isStalled());
+
+    // Interface B doesn't wait for A, but postpones reading
+    for (auto v : {0x94, 0x12, 0x34})
+        streamB.toRead.push(v);
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1000));
+    midiB.update();
+    EXPECT_EQ(streamB.toRead.size(), 3u);
+    EXPECT_EQ(midiB.getDeferredUpdates(), 1u);
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // Finish the SysEx message, which un-stalls the pipes
+    for (size_t i = SYSEX_BUFFER_SIZE + 1; i < sysex.size(); ++i)
+        streamA.toRead.push(sysex[i]);
+    midiA.update();
+    EXPECT_FALSE(midiB.isStalled());
+    EXPECT_EQ(streamOut.sent, sysex);
+
+    // Interface B can now read its message
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1020));
+    midiB.update();
+    EXPECT_TRUE(streamB.toRead.empty());
+    u8vec expected = sysex;
+    expected.insert(expected.end(), {0x94, 0x12, 0x34});
+    EXPECT_EQ(streamOut.sent, expected);
+    EXPECT_EQ(midiB.getLongestStall(), 20u);
+    EXPECT_EQ(midiB.getDroppedStalls(), 0u);
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
@@ -25,9 +25,27 @@ TEST(USBMIDI_Interface, RealTime) {
     StrictMock<USBMIDI_Interface> midi;
     Sequence seq;
     EXPECT_CALL(midi.backend, write(0x8F, 0xF8, 0x00, 0x00)).InSequence(seq);
+    EXPECT_CALL(midi.backend, sendNow()).InSequence(seq);
     midi.sendRealTime(MIDIMessageType::TIMING_CLOCK, CABLE_9);
 }
 
+TEST(USBMIDI_Interface, RealTimeSkipsBatch) {
+    StrictMock<USBMIDI_Interface> midi;
+    midi.setSendPolicy(USBMIDI_Interface::SendPolicy::Batched);
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(Return(0));
+    Sequence seq;
+    EXPECT_CALL(midi.backend, write(0x09, 0x90, 0x10, 0x7F)).InSequence(seq);
+    EXPECT_CALL(midi.backend, write(0x0F, 0xF8, 0x00, 0x00)).InSequence(seq);
+    EXPECT_CALL(midi.backend, sendNow()).InSequence(seq);
+    midi.sendNoteOn({0x10, CHANNEL_1}, 0x7F);
+    midi.sendRealTime(MIDIMessageType::TIMING_CLOCK);
+    ::testing::Mock::VerifyAndClear(&midi.backend);
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(midi.getPacketCount(), 2u);
+    EXPECT_EQ(midi.getTransferCount(), 1u);
+}
+
 TEST(USBMIDI_Interface, SysExSend3B) {
     StrictMock<USBMIDI_Interface> midi;
     Sequence seq;
@@ -149,6 +167,36 @@ TEST(USBMIDI_Interface, readRealTime) {
     EXPECT_EQ(midi.getRealTimeMessage(), expectedMsg);
 }
 
+static std::vector<RealTimeMessage> usbRealTimeLane;
+
+TEST(USBMIDI_Interface, readRealTimeLane) {
+    StrictMock<USBMIDI_Interface> midi;
+    usbRealTimeLane.clear();
+    midi.setRealTimeCallback([](MIDI_Interface &, RealTimeMessage msg) {
+        usbRealTimeLane.push_back(msg);
+    });
+    // Clock in the middle of a SysEx message
+    EXPECT_CALL(midi.backend, read())
+        .WillOnce(Return(USBMIDI_Interface::MIDIUSBPacket_t{0x34, 0xF0, 1, 2}))
+        .WillOnce(Return(USBMIDI_Interface::MIDIUSBPacket_t{0x3F, 0xF8, 0, 0}))
+        .WillOnce(
+            Return(USBMIDI_Interface::MIDIUSBPacket_t{0x36, 0x03, 0xF7, 0}));
+    EXPECT_EQ(midi.read(), MIDIReadEvent::SYSEX_MESSAGE);
+    std::vector<RealTimeMessage> expected = {
+        {MIDIMessageType::TIMING_CLOCK, CABLE_4},
+    };
+    EXPECT_EQ(usbRealTimeLane, expected);
+    EXPECT_EQ(midi.getSysExMessage().length, 5);
+    ::testing::Mock::VerifyAndClear(&midi.backend);
+
+    // Disabling the lane reports Real-Time messages as events again
+    midi.setRealTimeCallback(nullptr);
+    EXPECT_CALL(midi.backend, read())
+        .WillOnce(Return(USBMIDI_Interface::MIDIUSBPacket_t{0x0F, 0xFA, 0, 0}));
+    EXPECT_EQ(midi.read(), MIDIReadEvent::REALTIME_MESSAGE);
+    EXPECT_EQ(usbRealTimeLane.size(), 1u);
+}
+
 TEST(USBMIDI_Interface, readNoteOn) {
     StrictMock<USBMIDI_Interface> midi;
     EXPECT_CALL(midi.backend, read())
@@ -209,4 +257,98 @@ TEST(USBMIDI_Interface, readSysEx) {
     };
     EXPECT_EQ(result, expected);
     EXPECT_EQ(sysex.cable, CABLE_6);
-}
\ No newline at end of file
+}
+// -------------------------------------------------------------------------- //
+
+using SendPolicy = USBMIDI_Interface::SendPolicy;
+
+TEST(USBMIDI_Interface, sendImmediately) {
+    StrictMock<USBMIDI_Interface> midi;
+    midi.setSendPolicy(SendPolicy::Immediate);
+    Sequence seq;
+    EXPECT_CALL(midi.backend, write(0x89, 0x93, 0x55, 0x66)).InSequence(seq);
+    EXPECT_CALL(midi.backend, sendNow()).InSequence(seq);
+    EXPECT_CALL(midi.backend, write(0x8B, 0xB3, 0x55, 0x66)).InSequence(seq);
+    EXPECT_CALL(midi.backend, sendNow()).InSequence(seq);
+    midi.sendNoteOn({0x55, CHANNEL_4, CABLE_9}, 0x66);
+    midi.sendControlChange({0x55, CHANNEL_4, CABLE_9}, 0x66);
+    EXPECT_EQ(midi.getPacketCount(), 2u);
+    EXPECT_EQ(midi.getTransferCount(), 2u);
+}
+
+TEST(USBMIDI_Interface, sendBatchedFull) {
+    StrictMock<USBMIDI_Interface> midi;
+    midi.setSendPolicy(SendPolicy::Batched);
+    midi.setBatchSize(4);
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(Return(0));
+    Sequence seq;
+    for (uint8_t i = 0; i < 4; ++i)
+        EXPECT_CALL(midi.backend, write(0x0B, 0xB0, i, 0x7F)).InSequence(seq);
+    EXPECT_CALL(midi.backend, sendNow()).InSequence(seq);
+    for (uint8_t i = 4; i < 6; ++i)
+        EXPECT_CALL(midi.backend, write(0x0B, 0xB0, i, 0x7F)).InSequence(seq);
+    for (uint8_t i = 0; i < 6; ++i)
+        midi.sendControlChange({i, CHANNEL_1}, 0x7F);
+    ::testing::Mock::VerifyAndClear(&midi.backend);
+
+    // The rest is sent at the end of the loop
+    EXPECT_CALL(midi.backend, sendNow());
+    MIDI_Interface::flushAllAtLoopEnd();
+    ::testing::Mock::VerifyAndClear(&midi.backend);
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    EXPECT_EQ(midi.getPacketCount(), 6u);
+    EXPECT_EQ(midi.getTransferCount(), 2u);
+    EXPECT_EQ(midi.getPacketsPerTransfer(), 3.f);
+}
+
+TEST(USBMIDI_Interface, sendBatchedDeadline) {
+    StrictMock<USBMIDI_Interface> midi;
+    midi.setSendPolicy(SendPolicy::Batched);
+    midi.setBatchDeadline(500);
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(Return(1000));
+    EXPECT_CALL(midi.backend, write(0x09, 0x90, 0x10, 0x7F));
+    EXPECT_CALL(midi.backend, write(0x09, 0x90, 0x11, 0x7F));
+    midi.sendNoteOn({0x10, CHANNEL_1}, 0x7F);
+    midi.sendNoteOn({0x11, CHANNEL_1}, 0x7F);
+    ::testing::Mock::VerifyAndClear(&midi.backend);
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // Deadline not yet reached
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(Return(1499));
+    EXPECT_CALL(midi.backend, read())
+        .WillRepeatedly(Return(USBMIDI_Interface::MIDIUSBPacket_t{}));
+    midi.update();
+    ::testing::Mock::VerifyAndClear(&midi.backend);
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // Deadline reached
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(Return(1500));
+    EXPECT_CALL(midi.backend, read())
+        .WillRepeatedly(Return(USBMIDI_Interface::MIDIUSBPacket_t{}));
+    EXPECT_CALL(midi.backend, sendNow());
+    midi.update();
+    ::testing::Mock::VerifyAndClear(&midi.backend);
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    EXPECT_EQ(midi.getPacketCount(), 2u);
+    EXPECT_EQ(midi.getTransferCount(), 1u);
+}
+
+TEST(USBMIDI_Interface, changeSendPolicyFlushes) {
+    StrictMock<USBMIDI_Interface> midi;
+    midi.setSendPolicy(SendPolicy::Batched);
+    EXPECT_CALL(ArduinoMock::getInstance(), micros())
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(midi.backend, write(0x09, 0x90, 0x10, 0x7F));
+    midi.sendNoteOn({0x10, CHANNEL_1}, 0x7F);
+    ::testing::Mock::VerifyAndClear(&midi.backend);
+    EXPECT_CALL(midi.backend, sendNow());
+    midi.setSendPolicy(SendPolicy::Buffered);
+    ::testing::Mock::VerifyAndClear(&midi.backend);
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
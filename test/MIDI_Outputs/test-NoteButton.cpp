@@ -1,3 +1,4 @@
+#include <Banks/BankAddresses.hpp>
 #include <MIDI_Outputs/Bankable/NoteButton.hpp>
 #include <MIDI_Outputs/Bankable/NoteButtons.hpp>
 #include <MIDI_Outputs/NoteButton.hpp>
@@ -191,4 +192,52 @@ TEST(NoteButtonBankable, pressAndChangeSettingAndRelease) {
     button.update();
 
     Mock::VerifyAndClear(&ArduinoMock::getInstance());
-}
\ No newline at end of file
+}
+
+// -------------------------------------------------------------------------- //
+
+TEST(NoteButtonBankable, precomputedAddress) {
+    MockMIDI_Interface midi;
+    Control_Surface.connectDefaultMIDI_Interface();
+
+    Bank<4> bank(4);
+
+    Bankable::MIDIButton<Bankable::PrecomputedAddress<4>, DigitalNoteSender>
+        button{
+            {{bank, BankType::CHANGE_ADDRESS}, {0x3C, CHANNEL_7, CABLE_13}},
+            2,
+            {0x7F},
+        };
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(2, INPUT_PULLUP));
+    button.begin();
+
+    // Pressing
+    bank.select(2);
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(2))
+        .WillOnce(Return(LOW));
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1000));
+    EXPECT_CALL(midi, sendChannelMessageImpl(
+                          ChannelMessage(0x96, 0x3C + 8, 0x7F, CABLE_13)));
+    button.update();
+
+    // Change bank setting while pressed
+    bank.select(3);
+
+    // Releasing (with the bank setting at the time of pressing)
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(2))
+        .WillOnce(Return(HIGH));
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(2000));
+    EXPECT_CALL(midi, sendChannelMessageImpl(
+                          ChannelMessage(0x86, 0x3C + 8, 0x7F, CABLE_13)));
+    button.update();
+
+    // Pressing again (with new bank setting)
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(2))
+        .WillOnce(Return(LOW));
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(3000));
+    EXPECT_CALL(midi, sendChannelMessageImpl(
+                          ChannelMessage(0x96, 0x3C + 12, 0x7F, CABLE_13)));
+    button.update();
+
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <MIDI_Parsers/BufferPuller.hpp>
+#include <MIDI_Parsers/ParameterNumberAssembler.hpp>
 #include <MIDI_Parsers/SerialMIDI_Parser.hpp>
 #include <MIDI_Parsers/USBMIDI_Parser.hpp>
 
@@ -864,4 +865,193 @@ TEST(SerialMIDIParser, realSysEx) {
     EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::SYSEX_MESSAGE);
     EXPECT_EQ(sparser.getSysExMessage(), SysExMessage(data));
     EXPECT_EQ(sparser.pull(puller), MIDIReadEvent::NO_MESSAGE);
-}
\ No newline at end of file
+}
+
+// ------------------------------ BLOCK FEED -------------------------------- //
+
+TEST(SerialMIDIParser, feedBlock) {
+    SerialMIDI_Parser sparser;
+    uint8_t data[] = {0x93, 0x10, 0x7F, 0xF0, 0x01, 0x02, 0xF8,
+                      0x03, 0xF7, 0x11, 0x12, 0x94};
+    size_t consumed, total = 0;
+    EXPECT_EQ(sparser.feed(data, sizeof(data), consumed),
+              MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(sparser.getChannelMessage(), ChannelMessage(0x93, 0x10, 0x7F));
+    EXPECT_EQ(consumed, 3u);
+    total += consumed;
+    EXPECT_EQ(sparser.feed(data + total, sizeof(data) - total, consumed),
+              MIDIReadEvent::REALTIME_MESSAGE);
+    EXPECT_EQ(consumed, 4u);
+    total += consumed;
+    EXPECT_EQ(sparser.feed(data + total, sizeof(data) - total, consumed),
+              MIDIReadEvent::SYSEX_MESSAGE);
+    EXPECT_EQ(sparser.getSysExMessage(),
+              SysExMessage({0xF0, 0x01, 0x02, 0x03, 0xF7}));
+    EXPECT_EQ(consumed, 2u);
+    total += consumed;
+    // SysEx cancels running status, so the data bytes are ignored
+    EXPECT_EQ(sparser.feed(data + total, sizeof(data) - total, consumed),
+              MIDIReadEvent::NO_MESSAGE);
+    EXPECT_EQ(consumed, 3u);
+    // The next message can be continued in the next block
+    uint8_t data2[] = {0x20, 0x21, 0x22};
+    EXPECT_EQ(sparser.feed(data2, sizeof(data2), consumed),
+              MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(sparser.getChannelMessage(), ChannelMessage(0x94, 0x20, 0x21));
+    EXPECT_EQ(consumed, 2u);
+}
+
+TEST(SerialMIDIParser, feedBlockSysExMultipleChunks) {
+    SerialMIDI_Parser sparser;
+    std::vector<uint8_t> data(2 * SYSEX_BUFFER_SIZE + 1);
+    data.front() = 0xF0;
+    data.back() = 0xF7;
+    std::mt19937 rnd(0);
+    std::uniform_int_distribution<uint8_t> dist(0, 127);
+    std::generate(data.begin() + 1, data.end() - 1, std::bind(dist, rnd));
+
+    size_t consumed, total = 0;
+    EXPECT_EQ(sparser.feed(data.data(), data.size(), consumed),
+              MIDIReadEvent::SYSEX_CHUNK);
+    EXPECT_EQ(sparser.getSysExMessage(),
+              SysExMessage(data.data(), SYSEX_BUFFER_SIZE));
+    total += consumed;
+    EXPECT_EQ(sparser.feed(data.data() + total, data.size() - total, consumed),
+              MIDIReadEvent::SYSEX_CHUNK);
+    EXPECT_EQ(sparser.getSysExMessage(),
+              SysExMessage(data.data() + SYSEX_BUFFER_SIZE, SYSEX_BUFFER_SIZE));
+    total += consumed;
+    EXPECT_EQ(total, data.size());
+    // The SysEx End byte didn't fit in the previous chunk, so it was stored,
+    // no new data is needed to finish the message
+    EXPECT_EQ(sparser.feed(data.data() + total, 0, consumed),
+              MIDIReadEvent::SYSEX_MESSAGE);
+    EXPECT_EQ(consumed, 0u);
+    EXPECT_EQ(sparser.getSysExMessage(),
+              SysExMessage(data.data() + 2 * SYSEX_BUFFER_SIZE, 1));
+}
+
+TEST(SerialMIDIParser, feedBlockSameAsPull) {
+    // Random mix of status and data bytes, with long SysEx messages
+    std::vector<uint8_t> data(8 * SYSEX_BUFFER_SIZE);
+    std::mt19937 rnd(1);
+    std::uniform_int_distribution<uint8_t> dist(0, 255);
+    std::uniform_int_distribution<uint16_t> run(0, 3 * SYSEX_BUFFER_SIZE);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = dist(rnd);
+        if (data[i] == 0xF0)
+            for (size_t n = run(rnd); n-- > 0 && i + 1 < data.size();)
+                data[++i] = dist(rnd) & 0x7F;
+    }
+
+    SerialMIDI_Parser pulled, fed;
+    auto puller = BufferPuller(data);
+    size_t total = 0;
+    std::uniform_int_distribution<size_t> blockSize(0, 40);
+    size_t block = 0;
+    while (true) {
+        MIDIReadEvent expected = pulled.pull(puller);
+        MIDIReadEvent event;
+        do {
+            size_t consumed;
+            block = std::min(blockSize(rnd), data.size() - total);
+            event = fed.feed(data.data() + total, block, consumed);
+            total += consumed;
+        } while (event == MIDIReadEvent::NO_MESSAGE && total < data.size());
+        ASSERT_EQ(event, expected);
+        if (expected == MIDIReadEvent::NO_MESSAGE)
+            break;
+        if (expected == MIDIReadEvent::CHANNEL_MESSAGE)
+            EXPECT_EQ(fed.getChannelMessage(), pulled.getChannelMessage());
+        else if (expected == MIDIReadEvent::SYSCOMMON_MESSAGE)
+            EXPECT_EQ(fed.getSysCommonMessage(), pulled.getSysCommonMessage());
+        else if (expected == MIDIReadEvent::REALTIME_MESSAGE)
+            EXPECT_EQ(fed.getRealTimeMessage(), pulled.getRealTimeMessage());
+        else
+            EXPECT_EQ(fed.getSysExMessage(), pulled.getSysExMessage());
+    }
+    EXPECT_EQ(total, data.size());
+}
+
+// ----------------------- PARAMETER NUMBER ASSEMBLER ----------------------- //
+
+using PNResult = ParameterNumberAssembler::Result;
+using PNMessage = ParameterNumberMessage;
+
+static ChannelMessage cc(uint8_t controller, uint8_t value,
+                         Channel channel = CHANNEL_1, Cable cable = CABLE_1) {
+    return {MIDIMessageType::CONTROL_CHANGE, channel, controller, value,
+            cable};
+}
+
+TEST(ParameterNumberAssembler, NRPN14Bit) {
+    ParameterNumberAssembler pn;
+    EXPECT_EQ(pn.update(cc(99, 0x12, CHANNEL_3, CABLE_2), 0),
+              PNResult::Consumed);
+    EXPECT_EQ(pn.update(cc(98, 0x34, CHANNEL_3, CABLE_2), 0),
+              PNResult::Consumed);
+    EXPECT_EQ(pn.update(cc(6, 0x56, CHANNEL_3, CABLE_2), 0),
+              PNResult::Consumed);
+    EXPECT_EQ(pn.update(cc(38, 0x78, CHANNEL_3, CABLE_2), 0),
+              PNResult::Complete);
+    EXPECT_EQ(pn.getMessage(), PNMessage(PNMessage::NRPN, 0x12 << 7 | 0x34,
+                                         0x56 << 7 | 0x78, CHANNEL_3, CABLE_2));
+    EXPECT_FALSE(pn.poll(1000));
+    // A lone LSB updates the previous MSB
+    EXPECT_EQ(pn.update(cc(38, 0x01, CHANNEL_3, CABLE_2), 0),
+              PNResult::Complete);
+    EXPECT_EQ(pn.getMessage().value, 0x56 << 7 | 0x01);
+}
+
+TEST(ParameterNumberAssembler, RPN7BitTimeout) {
+    ParameterNumberAssembler pn;
+    EXPECT_EQ(pn.update(cc(101, 0x00), 100), PNResult::Consumed);
+    EXPECT_EQ(pn.update(cc(100, 0x02), 100), PNResult::Consumed);
+    EXPECT_EQ(pn.update(cc(6, 0x40), 100), PNResult::Consumed);
+    EXPECT_FALSE(pn.poll(100 + PARAMETER_NUMBER_TIMEOUT - 1));
+    EXPECT_TRUE(pn.poll(100 + PARAMETER_NUMBER_TIMEOUT));
+    EXPECT_EQ(pn.getMessage(),
+              PNMessage(PNMessage::RPN, 0x0002, 0x40 << 7, CHANNEL_1));
+    EXPECT_FALSE(pn.poll(100 + PARAMETER_NUMBER_TIMEOUT));
+    // A second MSB completes the first one
+    EXPECT_EQ(pn.update(cc(6, 0x41), 200), PNResult::Consumed);
+    EXPECT_EQ(pn.update(cc(6, 0x42), 200), PNResult::Complete);
+    EXPECT_EQ(pn.getMessage().value, 0x41 << 7);
+    EXPECT_TRUE(pn.flush());
+    EXPECT_EQ(pn.getMessage().value, 0x42 << 7);
+    EXPECT_FALSE(pn.flush());
+}
+
+TEST(ParameterNumberAssembler, IgnoreUnselected) {
+    ParameterNumberAssembler pn;
+    EXPECT_EQ(pn.update(cc(7, 0x12), 0), PNResult::Ignored);
+    EXPECT_EQ(pn.update(cc(6, 0x12), 0), PNResult::Ignored);
+    EXPECT_EQ(pn.update(cc(38, 0x12), 0), PNResult::Ignored);
+    // Other channels are independent
+    EXPECT_EQ(pn.update(cc(99, 0x01, CHANNEL_2), 0), PNResult::Consumed);
+    EXPECT_EQ(pn.update(cc(98, 0x01, CHANNEL_2), 0), PNResult::Consumed);
+    EXPECT_EQ(pn.update(cc(6, 0x12), 0), PNResult::Ignored);
+    EXPECT_EQ(pn.update(cc(6, 0x12, CHANNEL_2), 0), PNResult::Consumed);
+    // Null RPN
+    EXPECT_EQ(pn.update(cc(101, 0x7F, CHANNEL_2), 0), PNResult::Complete);
+    EXPECT_EQ(pn.update(cc(100, 0x7F, CHANNEL_2), 0), PNResult::Consumed);
+    EXPECT_EQ(pn.update(cc(6, 0x12, CHANNEL_2), 0), PNResult::Ignored);
+    // Reset All Controllers
+    EXPECT_EQ(pn.update(cc(99, 0x01, CHANNEL_2), 0), PNResult::Consumed);
+    pn.reset(CHANNEL_2);
+    EXPECT_EQ(pn.update(cc(6, 0x12, CHANNEL_2), 0), PNResult::Ignored);
+}
+
+TEST(ParameterNumberAssembler, Eviction) {
+    ParameterNumberAssembler pn;
+    for (uint8_t c = 0; c < PARAMETER_NUMBER_CHANNELS; ++c) {
+        EXPECT_EQ(pn.update(cc(99, c, Channel(c)), 0), PNResult::Consumed);
+        EXPECT_EQ(pn.update(cc(6, c, Channel(c)), 0), PNResult::Consumed);
+    }
+    // The first channel is evicted, and its pending value is completed
+    Channel next = Channel(PARAMETER_NUMBER_CHANNELS);
+    EXPECT_EQ(pn.update(cc(99, 0x10, next), 0), PNResult::Complete);
+    EXPECT_EQ(pn.getMessage().channel, CHANNEL_1);
+    EXPECT_EQ(pn.update(cc(6, 0x10, CHANNEL_1), 0), PNResult::Ignored);
+    EXPECT_EQ(pn.update(cc(6, 0x10, next), 0), PNResult::Consumed);
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief   Minimal benchmark runner that measures the throughput of a hot path
+ *          in messages per second and nanoseconds per message.
+ *
+ * Every benchmark is a function that processes a fixed batch of messages.
+ * The runner calls it repeatedly until @ref minTime has elapsed, and repeats
+ * this @ref repetitions times, keeping the fastest repetition to reduce the
+ * influence of other processes on the host.
+ *
+ * Latency benchmarks don't fit this model, they measure their own samples
+ * (e.g. the delay of every MIDI clock tick) and report the distribution using
+ * @ref recordJitter.
+ */
+class BenchmarkRunner {
+  public:
+    struct Result {
+        std::string name;
+        uint64_t iterations;
+        uint64_t messages;
+        double seconds;
+
+        double nsPerMessage() const { return 1e9 * seconds / messages; }
+        double messagesPerSecond() const { return messages / seconds; }
+    };
+
+    /// Distribution of the latency samples of a single benchmark.
+    struct Jitter {
+        std::string name;
+        std::string unit;
+        uint64_t samples;
+        double mean;
+        double stddev;
+        double max;
+    };
+
+    /// Minimum duration of a single repetition, in seconds.
+    double minTime = 0.1;
+    /// Number of repetitions of every benchmark.
+    unsigned repetitions = 3;
+    /// Only benchmarks whose name contains this string are run.
+    std::string filter;
+    /// MIDI capture file to replay (see `test/tools/MIDICapture.hpp`).
+    std::string capture;
+
+    /**
+     * @brief   Measure a single benchmark.
+     *
+     * @param   name
+     *          Unique name of the benchmark, e.g. `"Parser/case"`.
+     * @param   messagesPerIteration
+     *          The number of MIDI messages processed by one call of `f`.
+     * @param   f
+     *          The function to benchmark. It should return a value that
+     *          depends on the work it did, so the compiler can't optimize it
+     *          away.
+     */
+    template <class F>
+    void run(const std::string &name, uint64_t messagesPerIteration, F &&f) {
+        if (!selected(name))
+            return;
+        using clock = std::chrono::steady_clock;
+        Result best {name, 0, 0, 0};
+        for (unsigned rep = 0; rep < repetitions; ++rep) {
+            uint64_t iterations = 0;
+            auto start = clock::now();
+            std::chrono::duration<double> elapsed {};
+            do {
+                doNotOptimize(f());
+                ++iterations;
+                elapsed = clock::now() - start;
+            } while (elapsed.count() < minTime);
+            Result r {name, iterations, iterations * messagesPerIteration,
+                      elapsed.count()};
+            if (rep == 0 || r.nsPerMessage() < best.nsPerMessage())
+                best = r;
+        }
+        results.push_back(best);
+    }
+
+    /// Check whether the benchmark with the given name should be run.
+    bool selected(const std::string &name) const {
+        return name.find(filter) != std::string::npos;
+    }
+
+    /**
+     * @brief   Record the distribution of the given latency samples.
+     *
+     * @param   name
+     *          Unique name of the benchmark.
+     * @param   unit
+     *          The unit of the samples, e.g. `"us"` or `"bytes"`.
+     * @param   samples
+     *          The latency of every event that was measured.
+     */
+    void recordJitter(const std::string &name, const std::string &unit,
+                      const std::vector<double> &samples);
+
+    /// Write all results as a JSON document.
+    void writeJSON(std::ostream &os) const;
+
+    const std::vector<Result> &getResults() const { return results; }
+    const std::vector<Jitter> &getJitter() const { return jitter; }
+
+  private:
+    template <class T>
+    static void doNotOptimize(const T &value) {
+        sink = sink + static_cast<uint64_t>(value);
+    }
+
+  private:
+    std::vector<Result> results;
+    std::vector<Jitter> jitter;
+    static volatile uint64_t sink;
+};
+
+void benchMIDI_Parsers(BenchmarkRunner &runner);
+void benchMIDI_Pipes(BenchmarkRunner &runner);
+void benchMIDIInputElement(BenchmarkRunner &runner);
+void benchRealTimeLane(BenchmarkRunner &runner);
+void benchReplay(BenchmarkRunner &runner);
@@ -0,0 +1,57 @@
+#include "Benchmark.hpp"
+
+#include <MIDI_Inputs/MIDIInputElementIndex.hpp>
+#include <MIDI_Inputs/NoteCCKPValue.hpp>
+
+#include <memory>
+
+using namespace CS;
+
+namespace {
+
+constexpr size_t NumMessages = 256;
+
+using Element = MIDIInputElement<MIDIMessageType::CONTROL_CHANGE>;
+
+/// Address of the i-th registered element: all controllers of channel 1,
+/// then channel 2, etc.
+MIDIAddress address(size_t i) {
+    return {uint8_t(i % 128), Channel(uint8_t(i / 128) % 16)};
+}
+
+/// Control Change messages for addresses spread evenly over all
+/// `numElements` registered elements.
+std::vector<ChannelMessage> messages(size_t numElements) {
+    std::vector<ChannelMessage> msgs;
+    for (size_t i = 0; i < NumMessages; ++i) {
+        MIDIAddress addr = address((i * 7919) % numElements);
+        msgs.push_back({MIDIMessageType::CONTROL_CHANGE, addr.getChannel(),
+                        addr.getAddress(), uint8_t(i & 0x7F)});
+    }
+    return msgs;
+}
+
+uint64_t dispatch(const std::vector<ChannelMessage> &msgs) {
+    uint64_t matched = 0;
+    for (ChannelMessage msg : msgs)
+        matched += Element::updateAllWith(msg);
+    return matched;
+}
+
+} // namespace
+
+void benchMIDIInputElement(BenchmarkRunner &runner) {
+    for (size_t numElements : {10, 100, 1000}) {
+        std::vector<std::unique_ptr<CCValue>> elements;
+        for (size_t i = 0; i < numElements; ++i)
+            elements.emplace_back(new CCValue(address(i)));
+        auto msgs = messages(numElements);
+        std::string n = std::to_string(numElements);
+
+        runner.run("MIDIInputElement/updateAllWith/linear/" + n, NumMessages,
+                   [&] { return dispatch(msgs); });
+        MIDIInputElementIndex<MIDIMessageType::CONTROL_CHANGE, 1024, 8> index;
+        runner.run("MIDIInputElement/updateAllWith/indexed/" + n, NumMessages,
+                   [&] { return dispatch(msgs); });
+    }
+}
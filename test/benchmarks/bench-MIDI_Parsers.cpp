@@ -0,0 +1,190 @@
+#include "Benchmark.hpp"
+
+#include <MIDI_Parsers/BLEMIDIParser.hpp>
+#include <MIDI_Parsers/BufferPuller.hpp>
+#include <MIDI_Parsers/SerialMIDI_Parser.hpp>
+#include <MIDI_Parsers/USBMIDI_Parser.hpp>
+
+using namespace CS;
+
+namespace {
+
+constexpr size_t NumMessages = 256;
+constexpr size_t SysExLength = 64;
+
+/// Note On messages with a status byte for every message.
+std::vector<uint8_t> serialChannelMessages() {
+    std::vector<uint8_t> data;
+    for (size_t i = 0; i < NumMessages; ++i)
+        data.insert(data.end(), {uint8_t(0x90 | (i % 16)), uint8_t(i & 0x7F),
+                                 uint8_t(0x7F - (i & 0x7F))});
+    return data;
+}
+
+/// Note On messages on a single channel, using running status.
+std::vector<uint8_t> serialRunningStatus() {
+    std::vector<uint8_t> data {0x90};
+    for (size_t i = 0; i < NumMessages; ++i)
+        data.insert(data.end(), {uint8_t(i & 0x7F), uint8_t(0x7F - (i & 0x7F))});
+    return data;
+}
+
+/// System Exclusive messages of @ref SysExLength bytes (including the
+/// SysEx Start and End bytes).
+std::vector<uint8_t> serialSysEx(size_t count) {
+    std::vector<uint8_t> data;
+    for (size_t i = 0; i < count; ++i) {
+        data.push_back(0xF0);
+        for (size_t j = 0; j < SysExLength - 2; ++j)
+            data.push_back(uint8_t((i + j) & 0x7F));
+        data.push_back(0xF7);
+    }
+    return data;
+}
+
+/// Parse all messages using the byte-by-byte pull interface.
+uint64_t pullSerial(SerialMIDI_Parser &parser,
+                    const std::vector<uint8_t> &data) {
+    uint64_t count = 0;
+    auto puller = BufferPuller(data);
+    while (parser.pull(puller) != MIDIReadEvent::NO_MESSAGE)
+        ++count;
+    return count;
+}
+
+/// Parse all messages using the block-feed interface.
+uint64_t feedSerial(SerialMIDI_Parser &parser,
+                    const std::vector<uint8_t> &data) {
+    uint64_t count = 0;
+    size_t offset = 0, consumed;
+    while (offset < data.size()) {
+        if (parser.feed(data.data() + offset, data.size() - offset,
+                        consumed) != MIDIReadEvent::NO_MESSAGE)
+            ++count;
+        offset += consumed;
+    }
+    return count;
+}
+
+using USBPacket = USBMIDI_Parser::MIDIUSBPacket_t;
+
+/// Note On messages on cable 1 and 2, one per USB packet.
+std::vector<USBPacket> usbChannelMessages() {
+    std::vector<USBPacket> data;
+    for (size_t i = 0; i < NumMessages; ++i) {
+        uint8_t cable = (i % 2) << 4;
+        data.push_back({uint8_t(cable | 0x9), uint8_t(0x90 | (i % 16)),
+                        uint8_t(i & 0x7F), uint8_t(0x7F - (i & 0x7F))});
+    }
+    return data;
+}
+
+/// System Exclusive messages, split into USB packets of three bytes.
+std::vector<USBPacket> usbSysEx(size_t count) {
+    std::vector<uint8_t> bytes = serialSysEx(count);
+    std::vector<USBPacket> data;
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t *msg = bytes.data() + i * SysExLength;
+        size_t j = 0;
+        for (; SysExLength - j > 3; j += 3)
+            data.push_back({0x4, msg[j], msg[j + 1], msg[j + 2]});
+        size_t rem = SysExLength - j;
+        USBPacket last {uint8_t(0x4 + rem), 0, 0, 0};
+        for (size_t k = 0; k < rem; ++k)
+            last[k + 1] = msg[j + k];
+        data.push_back(last);
+    }
+    return data;
+}
+
+uint64_t pullUSB(USBMIDI_Parser &parser, const std::vector<USBPacket> &data) {
+    uint64_t count = 0;
+    auto puller = BufferPuller(data);
+    while (parser.pull(puller) != MIDIReadEvent::NO_MESSAGE)
+        ++count;
+    return count;
+}
+
+/// BLE packets containing four timestamped Note On messages each, as sent
+/// over a connection with the default MTU of 23 bytes.
+std::vector<std::vector<uint8_t>> bleChannelMessages() {
+    std::vector<std::vector<uint8_t>> packets;
+    for (size_t i = 0; i < NumMessages; i += 4) {
+        std::vector<uint8_t> packet {0x80};
+        for (size_t j = i; j < i + 4; ++j)
+            packet.insert(packet.end(),
+                          {uint8_t(0x80 | (j & 0x7F)), uint8_t(0x90 | (j % 16)),
+                           uint8_t(j & 0x7F), uint8_t(0x7F - (j & 0x7F))});
+        packets.push_back(packet);
+    }
+    return packets;
+}
+
+/// System Exclusive messages split over BLE packets of at most 20 bytes.
+std::vector<std::vector<uint8_t>> bleSysEx(size_t count) {
+    std::vector<uint8_t> bytes = serialSysEx(count);
+    std::vector<std::vector<uint8_t>> packets;
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t *msg = bytes.data() + i * SysExLength;
+        const uint8_t *end = msg + SysExLength - 1; // without SysEx End
+        std::vector<uint8_t> packet {0x80, 0x80};
+        while (msg != end) {
+            packet.push_back(*msg++);
+            if (packet.size() == 20 && msg != end) {
+                packets.push_back(packet);
+                packet = {0x80};
+            }
+        }
+        packet.insert(packet.end(), {0x80, 0xF7});
+        packets.push_back(packet);
+    }
+    return packets;
+}
+
+uint64_t pullBLE(SerialMIDI_Parser &parser,
+                 const std::vector<std::vector<uint8_t>> &packets) {
+    uint64_t count = 0;
+    for (const auto &packet : packets) {
+        BLEMIDIParser ble {packet.data(), packet.size()};
+        while (parser.pull(ble) != MIDIReadEvent::NO_MESSAGE)
+            ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+void benchMIDI_Parsers(BenchmarkRunner &runner) {
+    SerialMIDI_Parser serial;
+    auto channel = serialChannelMessages();
+    auto running = serialRunningStatus();
+    auto sysex = serialSysEx(NumMessages / 8);
+    runner.run("SerialMIDI_Parser/pull/channel", NumMessages,
+               [&] { return pullSerial(serial, channel); });
+    runner.run("SerialMIDI_Parser/pull/running-status", NumMessages,
+               [&] { return pullSerial(serial, running); });
+    runner.run("SerialMIDI_Parser/pull/sysex", NumMessages / 8,
+               [&] { return pullSerial(serial, sysex); });
+    runner.run("SerialMIDI_Parser/feed/channel", NumMessages,
+               [&] { return feedSerial(serial, channel); });
+    runner.run("SerialMIDI_Parser/feed/running-status", NumMessages,
+               [&] { return feedSerial(serial, running); });
+    runner.run("SerialMIDI_Parser/feed/sysex", NumMessages / 8,
+               [&] { return feedSerial(serial, sysex); });
+
+    USBMIDI_Parser usb;
+    auto usbChannel = usbChannelMessages();
+    auto usbSysex = usbSysEx(NumMessages / 8);
+    runner.run("USBMIDI_Parser/pull/channel", NumMessages,
+               [&] { return pullUSB(usb, usbChannel); });
+    runner.run("USBMIDI_Parser/pull/sysex", NumMessages / 8,
+               [&] { return pullUSB(usb, usbSysex); });
+
+    SerialMIDI_Parser bleSerial;
+    auto bleChannel = bleChannelMessages();
+    auto bleSysex = bleSysEx(NumMessages / 8);
+    runner.run("BLEMIDIParser/pull/channel", NumMessages,
+               [&] { return pullBLE(bleSerial, bleChannel); });
+    runner.run("BLEMIDIParser/pull/sysex", NumMessages / 8,
+               [&] { return pullBLE(bleSerial, bleSysex); });
+}
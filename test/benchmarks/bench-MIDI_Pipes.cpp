@@ -0,0 +1,123 @@
+#include "Benchmark.hpp"
+
+#include <MIDI_Interfaces/MIDI_Pipes.hpp>
+#include <MIDI_Interfaces/StaticMIDI_Router.hpp>
+
+using namespace CS;
+
+namespace {
+
+constexpr size_t NumMessages = 256;
+
+/// Sink that counts the messages it receives.
+struct CountingSink : TrueMIDI_Sink {
+    uint64_t count = 0;
+    void sinkMIDIfromPipe(ChannelMessage msg) override {
+        count += msg.getData1() + 1;
+    }
+    void sinkMIDIfromPipe(SysExMessage) override { ++count; }
+    void sinkMIDIfromPipe(SysCommonMessage) override { ++count; }
+    void sinkMIDIfromPipe(RealTimeMessage) override { ++count; }
+};
+
+/// Sink that forwards all messages to the next pipe, like a MIDI interface
+/// that routes its input to another interface.
+struct ForwardingSinkSource : TrueMIDI_SinkSource {
+    void sinkMIDIfromPipe(ChannelMessage msg) override {
+        sourceMIDItoPipe(msg);
+    }
+    void sinkMIDIfromPipe(SysExMessage msg) override { sourceMIDItoPipe(msg); }
+    void sinkMIDIfromPipe(SysCommonMessage msg) override {
+        sourceMIDItoPipe(msg);
+    }
+    void sinkMIDIfromPipe(RealTimeMessage msg) override {
+        sourceMIDItoPipe(msg);
+    }
+};
+
+/// Pipe that only lets through messages on MIDI channel 1.
+struct ChannelFilterPipe : MIDI_Pipe {
+    void mapForwardMIDI(ChannelMessage msg) override {
+        if (msg.getChannel() == CHANNEL_1)
+            sourceMIDItoSink(msg);
+    }
+};
+
+std::vector<ChannelMessage> channelMessages() {
+    std::vector<ChannelMessage> msgs;
+    for (size_t i = 0; i < NumMessages; ++i)
+        msgs.push_back({MIDIMessageType::NOTE_ON, Channel(i % 16),
+                        uint8_t(i & 0x7F), 0x7F});
+    return msgs;
+}
+
+uint64_t send(TrueMIDI_Source &source, const std::vector<ChannelMessage> &msgs,
+              const CountingSink &sink) {
+    for (ChannelMessage msg : msgs)
+        source.sourceMIDItoPipe(msg);
+    return sink.count;
+}
+
+} // namespace
+
+void benchMIDI_Pipes(BenchmarkRunner &runner) {
+    auto msgs = channelMessages();
+
+    {
+        TrueMIDI_Source source;
+        CountingSink sink;
+        MIDI_Pipe pipe;
+        source >> pipe >> sink;
+        runner.run("MIDI_Pipe/direct", NumMessages,
+                   [&] { return send(source, msgs, sink); });
+    }
+    {
+        TrueMIDI_Source source;
+        CountingSink sinks[4];
+        MIDI_PipeFactory<4> pipes;
+        for (CountingSink &sink : sinks)
+            source >> pipes >> sink;
+        runner.run("MIDI_Pipe/fan-out-4", NumMessages,
+                   [&] { return send(source, msgs, sinks[3]); });
+    }
+    {
+        TrueMIDI_Source source;
+        CountingSink sinks[4];
+        using Router = StaticMIDI_Router<CountingSink, CountingSink,
+                                         CountingSink, CountingSink>;
+        Router router = {sinks[0], sinks[1], sinks[2], sinks[3]};
+        Router::Input<0b1111> input{router};
+        source >> input;
+        runner.run("StaticMIDI_Router/fan-out-4", NumMessages,
+                   [&] { return send(source, msgs, sinks[3]); });
+    }
+    {
+        TrueMIDI_Source sources[4];
+        CountingSink sink;
+        MIDI_PipeFactory<4> pipes;
+        for (TrueMIDI_Source &source : sources)
+            source >> pipes >> sink;
+        runner.run("MIDI_Pipe/fan-in-4", NumMessages,
+                   [&] { return send(sources[3], msgs, sink); });
+    }
+    {
+        TrueMIDI_Source source;
+        ForwardingSinkSource hops[3];
+        CountingSink sink;
+        MIDI_PipeFactory<4> pipes;
+        source >> pipes >> hops[0];
+        hops[0] >> pipes >> hops[1];
+        hops[1] >> pipes >> hops[2];
+        hops[2] >> pipes >> sink;
+        runner.run("MIDI_Pipe/chain-4", NumMessages,
+                   [&] { return send(source, msgs, sink); });
+    }
+    {
+        TrueMIDI_Source source;
+        CountingSink sink;
+        ChannelFilterPipe pipe;
+        source >> pipe >> sink;
+        runner.run("MIDI_Pipe/filter", NumMessages,
+                   [&] { return send(source, msgs, sink); });
+    }
+}
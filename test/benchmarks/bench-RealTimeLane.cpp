@@ -0,0 +1,111 @@
+#include "Benchmark.hpp"
+
+#include <MIDI_Interfaces/BluetoothMIDI_Interface.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+using namespace CS;
+using ::testing::_;
+using ::testing::Return;
+
+namespace {
+
+constexpr size_t NumTicks = 64;
+constexpr size_t SysExLength = 2048;
+
+/// A SysEx dump of @ref SysExLength bytes, which is larger than the send
+/// buffer, so it is sent in pieces. The data bytes never look like a
+/// Real-Time message, so the clock ticks can be found on the wire.
+std::vector<uint8_t> sysexDump() {
+    std::vector<uint8_t> data {0xF0};
+    for (size_t i = 0; i < SysExLength - 2; ++i)
+        data.push_back(uint8_t(i & 0x7F));
+    data.push_back(0xF7);
+    return data;
+}
+
+/// Send a clock tick right after every SysEx dump, and measure how many
+/// bytes were sent over BLE between the moment the tick was sent and the
+/// moment it went out in a packet, and how long that took.
+void sendClockDuringSysEx(BenchmarkRunner &runner) {
+    const char *bytesName = "RealTimeLane/BLE/send/clock-after-sysex/bytes";
+    const char *timeName = "RealTimeLane/BLE/send/clock-after-sysex/time";
+    if (!runner.selected(bytesName) && !runner.selected(timeName))
+        return;
+    using clock = std::chrono::steady_clock;
+
+    // Timestamp bytes are 0x80, so the only 0xF8 on the wire is the clock
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillRepeatedly(Return(0));
+    BluetoothMIDI_Interface midi;
+    std::atomic<uint64_t> wireBytes {0};
+    std::atomic<uint64_t> tickPosition {0};
+    std::atomic<clock::rep> tickTime {0};
+    EXPECT_CALL(midi, notifyMIDIBLE(_))
+        .WillRepeatedly([&](const std::vector<uint8_t> &packet) {
+            auto tick = std::find(packet.begin(), packet.end(), 0xF8);
+            if (tick != packet.end()) {
+                tickPosition = wireBytes + (tick - packet.begin());
+                tickTime = clock::now().time_since_epoch().count();
+            }
+            wireBytes += packet.size();
+        });
+    midi.begin();
+
+    auto sysex = sysexDump();
+    std::vector<double> bytes, micros;
+    for (size_t i = 0; i < NumTicks; ++i) {
+        midi.send(SysExMessage(sysex));
+        uint64_t sentPosition = wireBytes;
+        auto sentTime = clock::now();
+        midi.sendRealTime(MIDIMessageType::TIMING_CLOCK);
+        midi.flushAndWait(std::chrono::milliseconds {1000});
+        bytes.push_back(tickPosition - sentPosition);
+        clock::duration delay {tickTime - sentTime.time_since_epoch().count()};
+        micros.push_back(
+            std::chrono::duration<double, std::micro>(delay).count());
+    }
+    midi.stopSendingThread();
+    runner.recordJitter(bytesName, "bytes", bytes);
+    runner.recordJitter(timeName, "us", micros);
+}
+
+/// Receive a clock tick after a varying number of Note On messages that are
+/// still waiting in the queue, and measure how many messages are read before
+/// the tick.
+void receiveClockBehindQueue(BenchmarkRunner &runner) {
+    const char *name = "RealTimeLane/BLE/receive/clock-behind-queue/messages";
+    if (!runner.selected(name))
+        return;
+    BluetoothMIDI_Interface midi;
+    std::vector<double> messages;
+    for (size_t i = 0; i < NumTicks; ++i) {
+        for (size_t j = 0; j < i % 48; ++j) {
+            uint8_t note[] = {0x80, 0x80, 0x90, uint8_t(j), 0x7F};
+            midi.parse(note, sizeof(note));
+        }
+        uint8_t tick[] = {0x80, 0x80, 0xF8};
+        midi.parse(tick, sizeof(tick));
+        double before = 0;
+        MIDIReadEvent event = midi.read();
+        while (event != MIDIReadEvent::REALTIME_MESSAGE &&
+               event != MIDIReadEvent::NO_MESSAGE) {
+            ++before;
+            event = midi.read();
+        }
+        while (midi.read() != MIDIReadEvent::NO_MESSAGE)
+            ; // Empty the queue for the next tick
+        messages.push_back(before);
+    }
+    runner.recordJitter(name, "messages", messages);
+}
+
+} // namespace
+
+void benchRealTimeLane(BenchmarkRunner &runner) {
+    ArduinoMock::begin();
+    sendClockDuringSysEx(runner);
+    receiveClockBehindQueue(runner);
+    ArduinoMock::end();
+}
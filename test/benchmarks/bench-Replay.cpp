@@ -0,0 +1,79 @@
+#include "Benchmark.hpp"
+
+#include <MIDICapture.hpp>
+
+#include <iostream>
+#include <sstream>
+
+using namespace CS;
+
+namespace {
+
+constexpr size_t NumMessages = 256;
+
+/// Sink that counts the messages it receives.
+struct ReplayCountingSink : TrueMIDI_Sink {
+    uint64_t count = 0;
+    void sinkMIDIfromPipe(ChannelMessage msg) override {
+        count += msg.getData1() + 1;
+    }
+    void sinkMIDIfromPipe(SysExMessage msg) override { count += msg.length; }
+    void sinkMIDIfromPipe(SysCommonMessage) override { ++count; }
+    void sinkMIDIfromPipe(RealTimeMessage) override { ++count; }
+};
+
+/// A capture of Note On messages on all channels, with a clock tick and a
+/// short SysEx message every 16 notes, one message per millisecond.
+std::vector<uint8_t> generatedCapture() {
+    std::stringstream ss;
+    MIDICaptureWriter writer(ss);
+    const uint8_t sysex[] = {0xF0, 0x7E, 0x7F, 0x06, 0x01, 0xF7};
+    for (size_t i = 0; i < NumMessages; ++i) {
+        uint64_t time = i * 1000;
+        writer.write(time, ChannelMessage(MIDIMessageType::NOTE_ON,
+                                          Channel(i % 16), uint8_t(i & 0x7F),
+                                          0x7F));
+        if (i % 16 == 15) {
+            writer.write(time, RealTimeMessage(MIDIMessageType::TIMING_CLOCK));
+            writer.write(time, SysExMessage(sysex));
+        }
+    }
+    std::string s = ss.str();
+    return {s.begin(), s.end()};
+}
+
+/// Replay the entire capture as fast as possible.
+void benchReplay(BenchmarkRunner &runner, const std::string &name,
+                 MIDICaptureReader reader) {
+    ReplayCountingSink sink;
+    MIDIReplaySource replay(reader, MIDIReplaySource::AsFastAsPossible);
+    MIDI_PipeFactory<1> pipes;
+    replay >> pipes >> sink;
+    size_t messages = replay.replayAll();
+    if (messages == 0)
+        return;
+    runner.run(name, messages, [&] {
+        replay.begin();
+        replay.replayAll();
+        return sink.count;
+    });
+}
+
+} // namespace
+
+void benchReplay(BenchmarkRunner &runner) {
+    auto generated = generatedCapture();
+    benchReplay(runner, "Replay/generated",
+                {generated.data(), generated.size()});
+
+    // Replay a real capture, e.g. recorded in the field or converted from a
+    // .syx file using `midicap syx2cap`
+    if (runner.capture.empty())
+        return;
+    MIDICaptureFile file(runner.capture);
+    if (!file.isOpen() || !file.getReader().hasValidHeader()) {
+        std::cerr << "Failed to open capture " << runner.capture << std::endl;
+        return;
+    }
+    benchReplay(runner, "Replay/file", file.getReader());
+}
@@ -0,0 +1,171 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+volatile uint64_t BenchmarkRunner::sink = 0;
+
+void BenchmarkRunner::recordJitter(const std::string &name,
+                                   const std::string &unit,
+                                   const std::vector<double> &samples) {
+    if (!selected(name) || samples.empty())
+        return;
+    double sum = 0, max = samples.front();
+    for (double s : samples) {
+        sum += s;
+        max = std::max(max, s);
+    }
+    double mean = sum / samples.size();
+    double var = 0;
+    for (double s : samples)
+        var += (s - mean) * (s - mean);
+    double stddev = std::sqrt(var / samples.size());
+    jitter.push_back({name, unit, samples.size(), mean, stddev, max});
+}
+
+void BenchmarkRunner::writeJSON(std::ostream &os) const {
+    os << "{\n"
+          "  \"context\": {\n"
+          "    \"compiler\": \""
+#if defined(__clang__)
+       << "clang " << __clang_major__ << '.' << __clang_minor__
+#elif defined(__GNUC__)
+       << "gcc " << __GNUC__ << '.' << __GNUC_MINOR__
+#else
+       << "unknown"
+#endif
+       << "\",\n"
+          "    \"build_type\": \""
+#ifdef NDEBUG
+       << "release"
+#else
+       << "debug"
+#endif
+       << "\",\n"
+          "    \"min_time\": "
+       << minTime
+       << ",\n"
+          "    \"repetitions\": "
+       << repetitions
+       << "\n"
+          "  },\n"
+          "  \"benchmarks\": [";
+    const char *sep = "\n";
+    for (const Result &r : results) {
+        os << sep << std::setprecision(6)
+           << "    {\n"
+              "      \"name\": \""
+           << r.name
+           << "\",\n"
+              "      \"iterations\": "
+           << r.iterations
+           << ",\n"
+              "      \"messages\": "
+           << r.messages
+           << ",\n"
+              "      \"seconds\": "
+           << r.seconds
+           << ",\n"
+              "      \"ns_per_message\": "
+           << r.nsPerMessage()
+           << ",\n"
+              "      \"messages_per_second\": "
+           << r.messagesPerSecond() << "\n    }";
+        sep = ",\n";
+    }
+    os << "\n  ],\n"
+          "  \"jitter\": [";
+    sep = "\n";
+    for (const Jitter &j : jitter) {
+        os << sep << std::setprecision(6)
+           << "    {\n"
+              "      \"name\": \""
+           << j.name
+           << "\",\n"
+              "      \"unit\": \""
+           << j.unit
+           << "\",\n"
+              "      \"samples\": "
+           << j.samples
+           << ",\n"
+              "      \"mean\": "
+           << j.mean
+           << ",\n"
+              "      \"stddev\": "
+           << j.stddev
+           << ",\n"
+              "      \"max\": "
+           << j.max << "\n    }";
+        sep = ",\n";
+    }
+    os << "\n  ]\n}\n";
+}
+
+static void usage(const char *argv0) {
+    std::cerr << "Usage:\t" << argv0
+              << " [--out=file.json] [--filter=name] [--min-time=seconds]"
+                 " [--repetitions=n] [--capture=file.cap]"
+              << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    BenchmarkRunner runner;
+    const char *output = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        auto option = [&](const char *name) -> const char * {
+            size_t len = std::strlen(name);
+            return std::strncmp(argv[i], name, len) == 0 ? argv[i] + len
+                                                         : nullptr;
+        };
+        const char *value;
+        if ((value = option("--out=")))
+            output = value;
+        else if ((value = option("--filter=")))
+            runner.filter = value;
+        else if ((value = option("--min-time=")))
+            runner.minTime = std::atof(value);
+        else if ((value = option("--repetitions=")))
+            runner.repetitions = std::max(1, std::atoi(value));
+        else if ((value = option("--capture=")))
+            runner.capture = value;
+        else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    benchMIDI_Parsers(runner);
+    benchMIDI_Pipes(runner);
+    benchMIDIInputElement(runner);
+    benchRealTimeLane(runner);
+    benchReplay(runner);
+
+    for (const auto &r : runner.getResults())
+        std::cerr << std::left << std::setw(48) << r.name << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(10)
+                  << r.nsPerMessage() << " ns/msg" << std::setw(14)
+                  << std::setprecision(0) << r.messagesPerSecond()
+                  << " msg/s" << std::endl;
+    for (const auto &j : runner.getJitter())
+        std::cerr << std::left << std::setw(48) << j.name << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(10)
+                  << j.mean << " ± " << j.stddev << " " << j.unit
+                  << " (max " << j.max << ")" << std::endl;
+
+    if (output) {
+        std::ofstream file(output);
+        runner.writeJSON(file);
+        if (!file) {
+            std::cerr << "Failed to write " << output << std::endl;
+            return EXIT_FAILURE;
+        }
+    } else {
+        runner.writeJSON(std::cout);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,265 @@
+#include "MIDICapture.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MIDI_CAPTURE_MMAP 1
+#endif
+
+using namespace CS;
+
+static constexpr uint8_t magic[] = {'C', 'S', 'M', 'C'};
+static constexpr size_t headerSize = 8;
+
+uint64_t steadyClockMicros() {
+    using namespace std::chrono;
+    auto now = steady_clock::now().time_since_epoch();
+    return duration_cast<microseconds>(now).count();
+}
+
+// -------------------------------------------------------------------------- //
+
+MIDICaptureWriter::MIDICaptureWriter(std::ostream &os) : os(os) {
+    const uint8_t header[headerSize] = {
+        magic[0], magic[1], magic[2], magic[3], MIDICaptureVersion, 0, 0, 0,
+    };
+    os.write(reinterpret_cast<const char *>(header), sizeof(header));
+}
+
+void MIDICaptureWriter::writeVarint(uint64_t value) {
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        os.put(char(byte | (value ? 0x80 : 0x00)));
+    } while (value);
+}
+
+void MIDICaptureWriter::writeHeader(uint64_t time, MIDICaptureType type,
+                                    Cable cable) {
+    writeVarint(time > previousTime ? time - previousTime : 0);
+    previousTime = std::max(time, previousTime);
+    os.put(char((uint8_t(type) << 4) | cable.getRaw()));
+    ++records;
+}
+
+void MIDICaptureWriter::write(uint64_t time, ChannelMessage msg) {
+    writeHeader(time, MIDICaptureType::Channel, msg.cable);
+    const char data[] = {char(msg.header), char(msg.data1), char(msg.data2)};
+    os.write(data, sizeof(data));
+}
+
+void MIDICaptureWriter::write(uint64_t time, SysCommonMessage msg) {
+    writeHeader(time, MIDICaptureType::SysCommon, msg.cable);
+    const char data[] = {char(msg.header), char(msg.data1), char(msg.data2)};
+    os.write(data, sizeof(data));
+}
+
+void MIDICaptureWriter::write(uint64_t time, RealTimeMessage msg) {
+    writeHeader(time, MIDICaptureType::RealTime, msg.cable);
+    os.put(char(msg.message));
+}
+
+void MIDICaptureWriter::write(uint64_t time, SysExMessage msg) {
+    writeHeader(time, MIDICaptureType::SysEx, msg.cable);
+    writeVarint(msg.length);
+    os.write(reinterpret_cast<const char *>(msg.data), msg.length);
+}
+
+// -------------------------------------------------------------------------- //
+
+MIDICaptureReader::MIDICaptureReader(const uint8_t *data, size_t size)
+    : begin(data), cursor(data), end(data + size) {
+    validHeader = data != nullptr && size >= headerSize &&
+                  std::memcmp(data, magic, sizeof(magic)) == 0 &&
+                  data[4] == MIDICaptureVersion;
+    rewind();
+}
+
+void MIDICaptureReader::rewind() {
+    cursor = validHeader ? begin + headerSize : end;
+    time = 0;
+    error = !validHeader;
+}
+
+bool MIDICaptureReader::readVarint(uint64_t &value) {
+    value = 0;
+    for (uint8_t shift = 0; cursor != end && shift < 64; shift += 7) {
+        uint8_t byte = *cursor++;
+        value |= uint64_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+bool MIDICaptureReader::next(MIDICaptureRecord &record) {
+    record.type = MIDIReadEvent::NO_MESSAGE;
+    if (cursor == end)
+        return false;
+    uint64_t delta;
+    if (!readVarint(delta) || cursor == end) {
+        error = true;
+        return false;
+    }
+    uint8_t tag = *cursor++;
+    Cable cable {uint8_t(tag & 0x0F)};
+    auto remaining = [this] { return size_t(end - cursor); };
+    switch (static_cast<MIDICaptureType>(tag >> 4)) {
+        case MIDICaptureType::Channel:
+            if (remaining() < 3 || cursor[0] < 0x80 || cursor[0] > 0xEF)
+                break;
+            record.type = MIDIReadEvent::CHANNEL_MESSAGE;
+            record.message = {cursor[0], cursor[1], cursor[2], cable};
+            cursor += 3;
+            break;
+        case MIDICaptureType::SysCommon:
+            if (remaining() < 3 || cursor[0] < 0xF1 || cursor[0] > 0xF7)
+                break;
+            record.type = MIDIReadEvent::SYSCOMMON_MESSAGE;
+            record.message = {cursor[0], cursor[1], cursor[2], cable};
+            cursor += 3;
+            break;
+        case MIDICaptureType::RealTime:
+            if (remaining() < 1 || cursor[0] < 0xF8)
+                break;
+            record.type = MIDIReadEvent::REALTIME_MESSAGE;
+            record.message = {cursor[0], 0x00, 0x00, cable};
+            cursor += 1;
+            break;
+        case MIDICaptureType::SysEx: {
+            uint64_t length;
+            if (!readVarint(length) || length > 0xFFFF ||
+                remaining() < length)
+                break;
+            record.type = MIDIReadEvent::SYSEX_MESSAGE;
+            record.sysex = {cursor, uint16_t(length), cable};
+            record.message.cable = cable;
+            cursor += length;
+        } break;
+        default: break;
+    }
+    if (record.type == MIDIReadEvent::NO_MESSAGE) {
+        error = true;
+        cursor = end;
+        return false;
+    }
+    time += delta;
+    record.time = time;
+    return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+MIDICaptureFile::MIDICaptureFile(const std::string &path) {
+#ifdef MIDI_CAPTURE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        void *map = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            data = static_cast<const uint8_t *>(map);
+            size = st.st_size;
+            mapped = true;
+        }
+    }
+    ::close(fd);
+    if (mapped)
+        return;
+#endif
+    // Fall back to reading the entire file (e.g. empty files can't be mapped)
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return;
+    buffer.assign(std::istreambuf_iterator<char>(file),
+                  std::istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+    if (data == nullptr) // empty file, but it did open
+        data = reinterpret_cast<const uint8_t *>("");
+}
+
+MIDICaptureFile::~MIDICaptureFile() {
+#ifdef MIDI_CAPTURE_MMAP
+    if (mapped)
+        ::munmap(const_cast<uint8_t *>(data), size);
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+MIDICaptureSink::MIDICaptureSink(std::ostream &os, Clock clock)
+    : writer(os), clock(clock), start(clock()) {}
+
+void MIDICaptureSink::sinkMIDIfromPipe(ChannelMessage msg) {
+    writer.write(now(), msg);
+}
+void MIDICaptureSink::sinkMIDIfromPipe(SysExMessage msg) {
+    writer.write(now(), msg);
+}
+void MIDICaptureSink::sinkMIDIfromPipe(SysCommonMessage msg) {
+    writer.write(now(), msg);
+}
+void MIDICaptureSink::sinkMIDIfromPipe(RealTimeMessage msg) {
+    writer.write(now(), msg);
+}
+
+// -------------------------------------------------------------------------- //
+
+MIDIReplaySource::MIDIReplaySource(MIDICaptureReader reader, Timing timing,
+                                   Clock clock)
+    : reader(reader), timing(timing), clock(clock) {
+    begin();
+}
+
+void MIDIReplaySource::begin() {
+    reader.rewind();
+    reader.next(pending);
+    started = false;
+    sent = 0;
+}
+
+void MIDIReplaySource::sendPending() {
+    switch (pending.type) {
+        case MIDIReadEvent::CHANNEL_MESSAGE:
+            sourceMIDItoPipe(pending.getChannelMessage());
+            break;
+        case MIDIReadEvent::SYSCOMMON_MESSAGE:
+            sourceMIDItoPipe(pending.getSysCommonMessage());
+            break;
+        case MIDIReadEvent::REALTIME_MESSAGE:
+            sourceMIDItoPipe(pending.getRealTimeMessage());
+            break;
+        case MIDIReadEvent::SYSEX_MESSAGE:
+            sourceMIDItoPipe(pending.sysex);
+            break;
+        default: return;
+    }
+    ++sent;
+    reader.next(pending);
+}
+
+void MIDIReplaySource::update(uint64_t now) {
+    if (!started) {
+        start = now;
+        started = true;
+    }
+    while (!isDone() && !isStalled() &&
+           (timing == AsFastAsPossible || pending.time <= now - start))
+        sendPending();
+}
+
+size_t MIDIReplaySource::replayAll() {
+    size_t before = sent;
+    while (!isDone() && !isStalled())
+        sendPending();
+    return sent - before;
+}
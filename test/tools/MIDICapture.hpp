@@ -0,0 +1,264 @@
+#pragma once
+
+#include <MIDI_Interfaces/MIDI_Pipes.hpp>
+#include <MIDI_Parsers/MIDIReadEvent.hpp>
+#include <MIDI_Parsers/MIDI_MessageTypes.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Host-side capture and replay of MIDI input, to reproduce the exact timing
+ * of a MIDI stream in benchmarks and regression tests.
+ *
+ * ## Capture format
+ *
+ * All integers are little-endian. A capture starts with an 8-byte header:
+ *
+ * | Offset | Size | Contents                                |
+ * |--------|------|-----------------------------------------|
+ * | 0      | 4    | Magic: `"CSMC"`                          |
+ * | 4      | 1    | Format version (@ref MIDICaptureVersion) |
+ * | 5      | 3    | Reserved, zero                          |
+ *
+ * It is followed by a sequence of records:
+ *
+ * | Size     | Contents                                                   |
+ * |----------|------------------------------------------------------------|
+ * | 1–10     | Time since the previous record in µs (unsigned LEB128)     |
+ * | 1        | Record type (high nibble) and zero-based cable (low nibble) |
+ * | variable | Payload                                                    |
+ *
+ * The payload depends on the record type:
+ *
+ *   - @ref MIDICaptureType::Channel, @ref MIDICaptureType::SysCommon: three
+ *     bytes, the status byte and the two data bytes.
+ *   - @ref MIDICaptureType::RealTime: the Real-Time byte.
+ *   - @ref MIDICaptureType::SysEx: the length (unsigned LEB128), followed by
+ *     the data of the SysEx message or chunk, including the SysEx start and
+ *     end bytes if present.
+ *
+ * Most Channel messages take six bytes, and the SysEx data is stored as-is, so
+ * a reader can hand out @ref CS::SysExMessage%s that point directly into the
+ * (memory-mapped) capture, without copying.
+ */
+
+/// The version of the capture format written by @ref MIDICaptureWriter.
+constexpr uint8_t MIDICaptureVersion = 1;
+
+/// The types of records in a capture.
+enum class MIDICaptureType : uint8_t {
+    Channel = 1,
+    SysCommon = 2,
+    RealTime = 3,
+    SysEx = 4,
+};
+
+/// Get the current time of the steady clock in microseconds.
+uint64_t steadyClockMicros();
+
+/// Writes MIDI messages to a capture (streamed).
+class MIDICaptureWriter {
+  public:
+    /// Write the capture header to the given stream.
+    MIDICaptureWriter(std::ostream &os);
+
+    /// @name   Writing records
+    /// Write a message that arrived at the given time (in µs since the start
+    /// of the capture). The time should not decrease, earlier times are
+    /// recorded as zero time since the previous record.
+    /// @{
+    void write(uint64_t time, CS::ChannelMessage msg);
+    void write(uint64_t time, CS::SysCommonMessage msg);
+    void write(uint64_t time, CS::RealTimeMessage msg);
+    void write(uint64_t time, CS::SysExMessage msg);
+    /// @}
+
+    /// Get the number of records written.
+    size_t getNumberOfRecords() const { return records; }
+
+  private:
+    void writeHeader(uint64_t time, MIDICaptureType type, CS::Cable cable);
+    void writeVarint(uint64_t value);
+
+    std::ostream &os;
+    uint64_t previousTime = 0;
+    size_t records = 0;
+};
+
+/// A single record of a capture.
+struct MIDICaptureRecord {
+    /// The type of message, or NO_MESSAGE if the record is not valid.
+    CS::MIDIReadEvent type = CS::MIDIReadEvent::NO_MESSAGE;
+    /// The time of the message, in µs since the start of the capture.
+    uint64_t time = 0;
+    /// The status byte and data bytes (Channel, System Common and Real-Time
+    /// messages) and the cable (all messages).
+    CS::MIDIMessage message {0x00, 0x00, 0x00};
+    /// The SysEx data, pointing into the buffer of the reader.
+    CS::SysExMessage sysex;
+
+    CS::ChannelMessage getChannelMessage() const {
+        return CS::ChannelMessage(message);
+    }
+    CS::SysCommonMessage getSysCommonMessage() const {
+        return CS::SysCommonMessage(message);
+    }
+    CS::RealTimeMessage getRealTimeMessage() const {
+        return {message.header, message.cable};
+    }
+};
+
+/// Reads the records of a capture from a buffer in memory, without copying.
+class MIDICaptureReader {
+  public:
+    /// Read the capture in the given buffer, which must outlive the reader and
+    /// the records it returns.
+    MIDICaptureReader(const uint8_t *data, size_t size);
+
+    /// Check whether the buffer starts with a valid capture header.
+    bool hasValidHeader() const { return validHeader; }
+    /// Check whether the reader stopped because of a truncated or invalid
+    /// record (rather than at the end of the capture).
+    bool hasError() const { return error; }
+
+    /// Read the next record. Returns false at the end of the capture or if
+    /// the record is not valid (e.g. if its status byte does not match its
+    /// record type).
+    bool next(MIDICaptureRecord &record);
+    /// Go back to the first record.
+    void rewind();
+
+  private:
+    bool readVarint(uint64_t &value);
+
+    const uint8_t *begin;
+    const uint8_t *cursor;
+    const uint8_t *end;
+    uint64_t time = 0;
+    bool validHeader;
+    bool error = false;
+};
+
+/**
+ * @brief   A read-only capture file. On POSIX hosts, the file is memory-mapped,
+ *          elsewhere, it is read into memory.
+ */
+class MIDICaptureFile {
+  public:
+    /// Open the given file. Use @ref isOpen to check for errors.
+    MIDICaptureFile(const std::string &path);
+    ~MIDICaptureFile();
+
+    MIDICaptureFile(const MIDICaptureFile &) = delete;
+    MIDICaptureFile &operator=(const MIDICaptureFile &) = delete;
+
+    bool isOpen() const { return data != nullptr; }
+    const uint8_t *getData() const { return data; }
+    size_t getSize() const { return size; }
+    /// Get a reader for the records in the file.
+    MIDICaptureReader getReader() const { return {data, size}; }
+
+  private:
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    std::vector<uint8_t> buffer;
+};
+
+/// A MIDI sink that records all messages it receives to a capture.
+class MIDICaptureSink : public CS::TrueMIDI_Sink {
+  public:
+    using Clock = uint64_t (*)();
+
+    /// Record to the given stream, using the given clock (in µs) for the
+    /// timestamps. Time zero is the moment the sink was created.
+    MIDICaptureSink(std::ostream &os, Clock clock = steadyClockMicros);
+
+    void sinkMIDIfromPipe(CS::ChannelMessage msg) override;
+    void sinkMIDIfromPipe(CS::SysExMessage msg) override;
+    void sinkMIDIfromPipe(CS::SysCommonMessage msg) override;
+    void sinkMIDIfromPipe(CS::RealTimeMessage msg) override;
+
+    /// Get the number of recorded messages.
+    size_t getNumberOfRecords() const { return writer.getNumberOfRecords(); }
+
+  private:
+    uint64_t now() const { return clock() - start; }
+
+    MIDICaptureWriter writer;
+    Clock clock;
+    uint64_t start;
+};
+
+/**
+ * @brief   A MIDI source that replays a capture, e.g. into `Control_Surface`.
+ *
+ * ~~~cpp
+ * MIDICaptureFile file("session.cap");
+ * MIDIReplaySource replay(file.getReader());
+ * replay >> pipes >> Control_Surface;
+ * replay.begin();
+ * while (!replay.isDone()) {
+ *     replay.update();
+ *     Control_Surface.loop();
+ * }
+ * ~~~
+ *
+ * While the source is stalled by another source (e.g. during a SysEx message
+ * that is split into multiple chunks), replay is paused.
+ */
+class MIDIReplaySource : public CS::TrueMIDI_Source {
+  public:
+    using Clock = uint64_t (*)();
+
+    enum Timing {
+        /// Send every message at the time it was captured (relative to the
+        /// call to @ref begin).
+        Original,
+        /// Send all messages during the next update.
+        AsFastAsPossible,
+    };
+
+    MIDIReplaySource(MIDICaptureReader reader, Timing timing = Original,
+                     Clock clock = steadyClockMicros);
+
+    /// Start (or restart) the replay from the first record.
+    void begin();
+    /// Send all messages that are due.
+    void update() { update(clock()); }
+    /// Send all messages that are due at the given time (in µs, on the same
+    /// clock as the one given to the constructor). The replay starts at the
+    /// time of the first update after @ref begin.
+    void update(uint64_t now);
+    /// Send all remaining messages, as fast as possible, regardless of the
+    /// timing. Returns the number of messages sent.
+    size_t replayAll();
+
+    /// Check whether all messages were sent.
+    bool isDone() const {
+        return pending.type == CS::MIDIReadEvent::NO_MESSAGE;
+    }
+    /// Get the number of messages that were sent since @ref begin.
+    size_t getNumberOfMessagesSent() const { return sent; }
+    /// Get the reader, e.g. to check for errors.
+    const MIDICaptureReader &getReader() const { return reader; }
+
+    void setTiming(Timing timing) { this->timing = timing; }
+
+  private:
+    void sendPending();
+
+    MIDICaptureReader reader;
+    MIDICaptureRecord pending;
+    Timing timing;
+    Clock clock;
+    uint64_t start = 0;
+    bool started = false;
+    size_t sent = 0;
+};
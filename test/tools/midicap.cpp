@@ -0,0 +1,121 @@
+#include "MIDICapture.hpp"
+
+#include <MIDI_Parsers/LambdaPuller.hpp>
+#include <MIDI_Parsers/SerialMIDI_Parser.hpp>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+std::ostream &operator<<(std::ostream &os, FlashString_t s) {
+    return os << reinterpret_cast<const char *>(s);
+}
+
+/// Convert a raw MIDI byte stream (e.g. a .syx file or a dump of a serial
+/// port) to a capture. Every message is timestamped as if it arrived over a
+/// serial MIDI link at the given baud rate (10 bits per byte).
+static int syx2cap(const char *in, const char *out, unsigned long baud) {
+    std::ifstream input(in, std::ios::binary);
+    if (!input) {
+        std::cerr << "Failed to open " << in << std::endl;
+        return EXIT_FAILURE;
+    }
+    uint64_t bytes = 0;
+    auto puller = CS::LambdaPuller([&](uint8_t &b) {
+        b = input.get();
+        if (input.eof())
+            return false;
+        ++bytes;
+        return true;
+    });
+    CS::SerialMIDI_Parser parser;
+
+    std::ofstream output(out, std::ios::binary);
+    MIDICaptureWriter writer(output);
+    while (true) {
+        auto msg = parser.pull(puller);
+        if (msg == CS::MIDIReadEvent::NO_MESSAGE)
+            break;
+        uint64_t time = bytes * 10 * 1000000 / baud;
+        switch (msg) {
+            case CS::MIDIReadEvent::CHANNEL_MESSAGE:
+                writer.write(time, parser.getChannelMessage());
+                break;
+            case CS::MIDIReadEvent::REALTIME_MESSAGE:
+                writer.write(time, parser.getRealTimeMessage());
+                break;
+            case CS::MIDIReadEvent::SYSCOMMON_MESSAGE:
+                writer.write(time, parser.getSysCommonMessage());
+                break;
+            case CS::MIDIReadEvent::SYSEX_MESSAGE:
+            case CS::MIDIReadEvent::SYSEX_CHUNK:
+                writer.write(time, parser.getSysExMessage());
+                break;
+            default:;
+        }
+    }
+    if (!output) {
+        std::cerr << "Failed to write " << out << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cerr << writer.getNumberOfRecords() << " messages" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+/// Print all records of a capture, one per line: the time in microseconds,
+/// the one-based cable, the message type and the bytes of the message.
+static int dump(const char *in) {
+    MIDICaptureFile file(in);
+    if (!file.isOpen()) {
+        std::cerr << "Failed to open " << in << std::endl;
+        return EXIT_FAILURE;
+    }
+    MIDICaptureReader reader = file.getReader();
+    if (!reader.hasValidHeader()) {
+        std::cerr << in << " is not a MIDI capture" << std::endl;
+        return EXIT_FAILURE;
+    }
+    MIDICaptureRecord record;
+    std::cout << std::hex << std::uppercase << std::setfill('0');
+    while (reader.next(record)) {
+        std::cout << std::dec << std::setfill(' ') << std::setw(12)
+                  << record.time << ' ' << std::setw(2)
+                  << +record.message.cable.getOneBased() << ' '
+                  << enum_to_string(record.type) << std::hex
+                  << std::setfill('0');
+        if (record.type == CS::MIDIReadEvent::SYSEX_MESSAGE) {
+            for (uint16_t i = 0; i < record.sysex.length; ++i)
+                std::cout << ' ' << std::setw(2) << +record.sysex.data[i];
+        } else if (record.type == CS::MIDIReadEvent::REALTIME_MESSAGE) {
+            std::cout << ' ' << std::setw(2) << +record.message.header;
+        } else {
+            std::cout << ' ' << std::setw(2) << +record.message.header << ' '
+                      << std::setw(2) << +record.message.data1 << ' '
+                      << std::setw(2) << +record.message.data2;
+        }
+        std::cout << '\n';
+    }
+    if (reader.hasError()) {
+        std::cerr << "Invalid or truncated record" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+    assert(argc >= 1);
+    if (argc >= 4 && std::strcmp(argv[1], "syx2cap") == 0) {
+        unsigned long baud = argc >= 5 ? std::strtoul(argv[4], nullptr, 10)
+                                       : 31250;
+        return syx2cap(argv[2], argv[3], baud ? baud : 31250);
+    } else if (argc >= 3 && std::strcmp(argv[1], "dump") == 0) {
+        return dump(argv[2]);
+    }
+    std::cout << "Usage:\t" << argv[0]
+              << " syx2cap input.syx output.cap [baud]\n"
+                 "\t"
+              << argv[0] << " dump input.cap" << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,249 @@
+#include <MIDICapture.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace CS;
+
+namespace {
+
+struct CaptureTestSink : TrueMIDI_Sink {
+    void sinkMIDIfromPipe(ChannelMessage msg) override {
+        channel.push_back(msg);
+        order.push_back(MIDIReadEvent::CHANNEL_MESSAGE);
+    }
+    void sinkMIDIfromPipe(SysExMessage msg) override {
+        sysex.emplace_back(msg.data, msg.data + msg.length);
+        order.push_back(MIDIReadEvent::SYSEX_MESSAGE);
+    }
+    void sinkMIDIfromPipe(SysCommonMessage msg) override {
+        syscommon.push_back(msg);
+        order.push_back(MIDIReadEvent::SYSCOMMON_MESSAGE);
+    }
+    void sinkMIDIfromPipe(RealTimeMessage msg) override {
+        realtime.push_back(msg);
+        order.push_back(MIDIReadEvent::REALTIME_MESSAGE);
+    }
+
+    std::vector<ChannelMessage> channel;
+    std::vector<std::vector<uint8_t>> sysex;
+    std::vector<SysCommonMessage> syscommon;
+    std::vector<RealTimeMessage> realtime;
+    std::vector<MIDIReadEvent> order;
+};
+
+uint64_t fakeTime = 0;
+uint64_t fakeClock() { return fakeTime; }
+
+std::vector<uint8_t> toBytes(const std::stringstream &ss) {
+    std::string s = ss.str();
+    return {s.begin(), s.end()};
+}
+
+const std::vector<uint8_t> sysexData = {0xF0, 0x01, 0x02, 0x03, 0xF7};
+
+std::vector<uint8_t> exampleCapture() {
+    std::stringstream ss;
+    MIDICaptureWriter writer(ss);
+    writer.write(100, ChannelMessage(0x93, 0x3C, 0x7F, CABLE_2));
+    writer.write(100, RealTimeMessage(0xF8, CABLE_3));
+    writer.write(20000, SysExMessage(sysexData, CABLE_16));
+    writer.write(1000000, SysCommonMessage(0xF2, 0x12, 0x34));
+    EXPECT_EQ(writer.getNumberOfRecords(), 4u);
+    return toBytes(ss);
+}
+
+} // namespace
+
+TEST(MIDICapture, roundTrip) {
+    auto capture = exampleCapture();
+    // Header, then 1–3 bytes of time, a tag, and the payload for every record
+    EXPECT_EQ(capture.size(), 8u + (1 + 1 + 3) + (1 + 1 + 1) +
+                                  (3 + 1 + 1 + 5) + (3 + 1 + 3));
+
+    MIDICaptureReader reader(capture.data(), capture.size());
+    ASSERT_TRUE(reader.hasValidHeader());
+    MIDICaptureRecord record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.type, MIDIReadEvent::CHANNEL_MESSAGE);
+    EXPECT_EQ(record.time, 100u);
+    EXPECT_EQ(record.getChannelMessage(),
+              ChannelMessage(0x93, 0x3C, 0x7F, CABLE_2));
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.type, MIDIReadEvent::REALTIME_MESSAGE);
+    EXPECT_EQ(record.time, 100u);
+    EXPECT_EQ(record.getRealTimeMessage(), RealTimeMessage(0xF8, CABLE_3));
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.type, MIDIReadEvent::SYSEX_MESSAGE);
+    EXPECT_EQ(record.time, 20000u);
+    EXPECT_EQ(record.sysex, SysExMessage(sysexData, CABLE_16));
+    // The SysEx data is not copied
+    EXPECT_GE(record.sysex.data, capture.data());
+    EXPECT_LT(record.sysex.data, capture.data() + capture.size());
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.type, MIDIReadEvent::SYSCOMMON_MESSAGE);
+    EXPECT_EQ(record.time, 1000000u);
+    EXPECT_EQ(record.getSysCommonMessage(), SysCommonMessage(0xF2, 0x12, 0x34));
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_FALSE(reader.hasError());
+
+    reader.rewind();
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.time, 100u);
+}
+
+TEST(MIDICapture, invalidHeader) {
+    auto capture = exampleCapture();
+    capture[4] = MIDICaptureVersion + 1;
+    MIDICaptureReader reader(capture.data(), capture.size());
+    EXPECT_FALSE(reader.hasValidHeader());
+    MIDICaptureRecord record;
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_TRUE(reader.hasError());
+}
+
+TEST(MIDICapture, truncated) {
+    auto capture = exampleCapture();
+    // Cut off the last byte of the SysEx message
+    MIDICaptureReader reader(capture.data(), capture.size() - 8);
+    MIDICaptureRecord record;
+    EXPECT_TRUE(reader.next(record));
+    EXPECT_TRUE(reader.next(record));
+    EXPECT_FALSE(reader.next(record));
+    EXPECT_EQ(record.type, MIDIReadEvent::NO_MESSAGE);
+    EXPECT_TRUE(reader.hasError());
+}
+
+TEST(MIDICapture, invalidStatus) {
+    // Offsets of the status bytes of the Channel, Real-Time and System Common
+    // records in the example capture, and the number of valid records before
+    // them.
+    const size_t offsets[] = {10, 15, 30};
+    const size_t before[] = {0, 1, 3};
+    const uint8_t original[] = {0x93, 0xF8, 0xF2};
+    // Status bytes that do not belong to the type of the record
+    const uint8_t invalid[][3] = {
+        {0x7F, 0xF0, 0xF8},
+        {0x90, 0xF0, 0xF7},
+        {0xE0, 0xF0, 0xF8},
+    };
+    for (size_t i = 0; i < 3; ++i) {
+        for (uint8_t status : invalid[i]) {
+            auto capture = exampleCapture();
+            ASSERT_EQ(capture[offsets[i]], original[i]);
+            capture[offsets[i]] = status;
+            MIDICaptureReader reader(capture.data(), capture.size());
+            MIDICaptureRecord record;
+            for (size_t j = 0; j < before[i]; ++j)
+                EXPECT_TRUE(reader.next(record));
+            EXPECT_FALSE(reader.next(record)) << i << ", " << +status;
+            EXPECT_EQ(record.type, MIDIReadEvent::NO_MESSAGE);
+            EXPECT_TRUE(reader.hasError());
+        }
+    }
+}
+
+TEST(MIDICapture, recordAndReplayOriginalTiming) {
+    std::stringstream ss;
+    fakeTime = 5000;
+    MIDICaptureSink sink(ss, fakeClock);
+    MIDI_PipeFactory<2> pipes;
+    TrueMIDI_Source recorder;
+    recorder >> pipes >> sink;
+
+    fakeTime += 1000;
+    recorder.sourceMIDItoPipe(ChannelMessage(0x90, 0x3C, 0x7F));
+    fakeTime += 1000;
+    recorder.sourceMIDItoPipe(SysExMessage(sysexData));
+    recorder.sourceMIDItoPipe(RealTimeMessage(0xFA));
+    fakeTime += 3000;
+    recorder.sourceMIDItoPipe(ChannelMessage(0x80, 0x3C, 0x40));
+    EXPECT_EQ(sink.getNumberOfRecords(), 4u);
+
+    auto capture = toBytes(ss);
+    CaptureTestSink out;
+    MIDIReplaySource replay({capture.data(), capture.size()},
+                            MIDIReplaySource::Original, fakeClock);
+    replay >> pipes >> out;
+    replay.begin();
+
+    fakeTime = 100000;
+    replay.update();
+    EXPECT_EQ(replay.getNumberOfMessagesSent(), 0u);
+    fakeTime += 999;
+    replay.update();
+    EXPECT_EQ(replay.getNumberOfMessagesSent(), 0u);
+    fakeTime += 1;
+    replay.update();
+    EXPECT_EQ(replay.getNumberOfMessagesSent(), 1u);
+    fakeTime += 1000;
+    replay.update();
+    EXPECT_EQ(replay.getNumberOfMessagesSent(), 3u);
+    fakeTime += 2999;
+    replay.update();
+    EXPECT_EQ(replay.getNumberOfMessagesSent(), 3u);
+    EXPECT_FALSE(replay.isDone());
+    fakeTime += 1;
+    replay.update();
+    EXPECT_TRUE(replay.isDone());
+
+    std::vector<MIDIReadEvent> expectedOrder = {
+        MIDIReadEvent::CHANNEL_MESSAGE,
+        MIDIReadEvent::SYSEX_MESSAGE,
+        MIDIReadEvent::REALTIME_MESSAGE,
+        MIDIReadEvent::CHANNEL_MESSAGE,
+    };
+    EXPECT_EQ(out.order, expectedOrder);
+    std::vector<ChannelMessage> expectedChannel = {
+        {0x90, 0x3C, 0x7F},
+        {0x80, 0x3C, 0x40},
+    };
+    EXPECT_EQ(out.channel, expectedChannel);
+    EXPECT_EQ(out.sysex, std::vector<std::vector<uint8_t>> {sysexData});
+    EXPECT_EQ(out.realtime, std::vector<RealTimeMessage> {0xFA});
+}
+
+TEST(MIDICapture, replayAsFastAsPossible) {
+    auto capture = exampleCapture();
+    CaptureTestSink out;
+    MIDIReplaySource replay({capture.data(), capture.size()},
+                            MIDIReplaySource::AsFastAsPossible, fakeClock);
+    MIDI_PipeFactory<1> pipes;
+    replay >> pipes >> out;
+    replay.update();
+    EXPECT_TRUE(replay.isDone());
+    EXPECT_EQ(out.order.size(), 4u);
+
+    // Restart and replay everything at once, regardless of the timing
+    replay.setTiming(MIDIReplaySource::Original);
+    replay.begin();
+    EXPECT_EQ(replay.replayAll(), 4u);
+    EXPECT_EQ(out.order.size(), 8u);
+    EXPECT_EQ(out.syscommon.back(), SysCommonMessage(0xF2, 0x12, 0x34));
+}
+
+TEST(MIDICapture, file) {
+    auto capture = exampleCapture();
+    std::string path = ::testing::TempDir() + "test-MIDICapture.cap";
+    {
+        std::ofstream os(path, std::ios::binary);
+        os.write(reinterpret_cast<const char *>(capture.data()),
+                 capture.size());
+    }
+    {
+        MIDICaptureFile file(path);
+        ASSERT_TRUE(file.isOpen());
+        ASSERT_EQ(file.getSize(), capture.size());
+        MIDICaptureReader reader = file.getReader();
+        MIDICaptureRecord record;
+        size_t count = 0;
+        while (reader.next(record))
+            ++count;
+        EXPECT_EQ(count, 4u);
+        EXPECT_FALSE(reader.hasError());
+    }
+    std::remove(path.c_str());
+    EXPECT_FALSE(MIDICaptureFile(path).isOpen());
+}